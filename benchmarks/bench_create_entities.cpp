@@ -0,0 +1,91 @@
+// Micro-benchmark: World::createEntity loop vs. World::createEntities bulk path, and
+// World::destroyEntity loop vs. World::destroyEntities (what Scene::destroyAll uses).
+// The World is backed by a real RenderContext, created headless on the Noop backend.
+// Usage: bench_create_entities [entityCount]
+#include <filament_engine/ecs/world.h>
+#include <filament_engine/core/input.h>
+#include <filament_engine/core/input_map.h>
+#include <filament_engine/rendering/render_context.h>
+
+#include "bench_utils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+template <typename Func>
+double timedRun(fe::RenderContext& renderContext, fe::Input& input, fe::InputMap& inputMap, Func&& func) {
+    // Fresh world per run so every iteration measures creation into empty storages
+    return bench::bestOfMs(5, [&] {
+        fe::World world(renderContext, input, inputMap);
+        func(world);
+    });
+}
+
+// Destruction only: the entities are created outside the timed region
+template <typename Func>
+double timedDestroy(fe::RenderContext& renderContext, fe::Input& input, fe::InputMap& inputMap,
+                    size_t count, Func&& func) {
+    double best = 1e30;
+    for (int i = 0; i < 5; ++i) {
+        fe::World world(renderContext, input, inputMap);
+        auto created = world.createEntities(count, "Bench");
+        std::vector<entt::entity> entities(created.begin(), created.end());
+
+        auto start = std::chrono::high_resolution_clock::now();
+        func(world, entities);
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = 100'000;
+    if (argc > 1) {
+        count = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    fe::RenderContext renderContext(320, 240, fe::GraphicsBackend::Noop);
+    fe::Input input;
+    fe::InputMap inputMap;
+
+    // Note: each timing includes the World teardown, which is identical for both paths
+    double loopMs = timedRun(renderContext, input, inputMap, [count](fe::World& world) {
+        for (size_t i = 0; i < count; ++i) {
+            world.createEntity("Bench");
+        }
+    });
+
+    double bulkMs = timedRun(renderContext, input, inputMap, [count](fe::World& world) {
+        auto entities = world.createEntities(count, "Bench");
+        bench::doNotOptimize(static_cast<float>(entities.size()));
+    });
+
+    double destroyLoopMs = timedDestroy(renderContext, input, inputMap, count,
+        [](fe::World& world, const std::vector<entt::entity>& entities) {
+            for (auto entity : entities) {
+                world.destroyEntity(entity);
+            }
+        });
+
+    double destroyBulkMs = timedDestroy(renderContext, input, inputMap, count,
+        [](fe::World& world, const std::vector<entt::entity>& entities) {
+            world.destroyEntities(entities);
+        });
+
+    auto perSecond = [count](double ms) { return static_cast<double>(count) / (ms / 1000.0); };
+
+    std::printf("Entity creation, %zu entities\n", count);
+    std::printf("%-16s %10s %14s\n", "path", "ms", "entities/s");
+    std::printf("%-16s %10.3f %14.0f\n", "createEntity", loopMs, perSecond(loopMs));
+    std::printf("%-16s %10.3f %14.0f\n", "createEntities", bulkMs, perSecond(bulkMs));
+    std::printf("%-16s %10.3f %14.0f\n", "destroyEntity", destroyLoopMs, perSecond(destroyLoopMs));
+    std::printf("%-16s %10.3f %14.0f\n", "destroyEntities", destroyBulkMs, perSecond(destroyBulkMs));
+    std::printf("speedup: create %.2fx, destroy %.2fx\n", loopMs / bulkMs, destroyLoopMs / destroyBulkMs);
+    return 0;
+}
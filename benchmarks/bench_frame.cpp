@@ -0,0 +1,129 @@
+// Frame benchmark: full CPU cost of a frame (simulation, sync systems, culling and Filament's
+// own culling and command generation), run headless on the Noop backend. A grid of spinning
+// cubes is simulated at 60 Hz; the same scene runs sequentially and then pipelined.
+// Without the compiled material the cubes have no renderers and only transforms are measured.
+// Usage: bench_frame [entityCount] [frameCount]
+#include <filament_engine/filament_engine.h>
+
+#include "bench_utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#ifndef FE_BENCH_MATERIAL
+#define FE_BENCH_MATERIAL "materials/standard_lit.filamat"
+#endif
+
+namespace {
+
+class FrameBench : public fe::Application {
+public:
+    FrameBench(const fe::ApplicationConfig& config, size_t count)
+        : fe::Application(config), m_count(count) {}
+
+    void onInit() override {
+        auto& world = getWorld();
+        auto* resources = fe::ResourceManager::getInstance();
+        auto mesh = resources->addMesh(fe::Mesh::createCube(*getRenderContext().getEngine(), 0.4f));
+
+        std::ifstream file(FE_BENCH_MATERIAL, std::ios::binary);
+        std::vector<char> materialData{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        fe::ResourceHandle<fe::MaterialWrapper> material;
+        if (!materialData.empty()) {
+            material = resources->createMaterial(materialData.data(), materialData.size());
+        }
+        m_rendered = material.isValid();
+
+        // Creation already logged the transforms as changed, so plain assignment is enough
+        auto created = world.createEntities(m_count, "Cube");
+        m_entities.assign(created.begin(), created.end());
+        const auto side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(m_count))));
+        for (size_t i = 0; i < m_entities.size(); ++i) {
+            const float x = static_cast<float>(i % side) - 0.5f * static_cast<float>(side);
+            const float z = static_cast<float>(i / side);
+            world.getComponent<fe::TransformComponent>(m_entities[i]).position = {x, 0.0f, -z};
+            if (m_rendered) {
+                world.addComponent<fe::MeshRendererComponent>(m_entities[i], fe::MeshRendererComponent{mesh, material});
+            }
+        }
+    }
+
+    void onFixedUpdate(float step) override {
+        m_angle += step;
+        const auto spin = fe::Quat::fromAxisAngle(fe::Vec3{0, 1, 0}, m_angle);
+        auto& world = getWorld();
+        for (auto entity : m_entities) {
+            world.patchComponent<fe::TransformComponent>(entity, [&spin](auto& transform) {
+                transform.rotation = spin;
+            });
+        }
+    }
+
+    void onUpdate(float) override {
+        // The first frame builds every renderable; time the steady state after it
+        if (getFrameCount() == 1) m_start = std::chrono::high_resolution_clock::now();
+    }
+
+    void onShutdown() override {
+        auto end = std::chrono::high_resolution_clock::now();
+        m_frameMs = std::chrono::duration<double, std::milli>(end - m_start).count() /
+                    static_cast<double>(getFrameCount() - 1);
+        bench::doNotOptimize(m_angle);
+    }
+
+    double getFrameMs() const { return m_frameMs; }
+    bool isRendered() const { return m_rendered; }
+
+private:
+    size_t m_count;
+    std::vector<entt::entity> m_entities;
+    float m_angle = 0.0f;
+    bool m_rendered = false;
+    std::chrono::high_resolution_clock::time_point m_start;
+    double m_frameMs = 0.0;
+};
+
+double runFrames(size_t count, uint64_t frames, bool pipelined, bool& rendered) {
+    fe::ApplicationConfig config;
+    config.window.width = 1280;
+    config.window.height = 720;
+    config.headless = true;
+    config.maxFrames = frames + 1;
+    config.fixedUpdateRate = 60.0f;
+    config.pipelined = pipelined;
+
+    FrameBench app(config, count);
+    app.run();
+    rendered = app.isRendered();
+    return app.getFrameMs();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = 20'000;
+    uint64_t frames = 300;
+    if (argc > 1) {
+        count = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+    if (argc > 2) {
+        frames = std::max<uint64_t>(std::strtoull(argv[2], nullptr, 10), 1);
+    }
+
+    bool rendered = false;
+    double sequentialMs = runFrames(count, frames, false, rendered);
+    double pipelinedMs = runFrames(count, frames, true, rendered);
+
+    std::printf("Headless frames (Noop backend), %zu spinning cubes%s, %llu frames\n", count,
+                rendered ? "" : " (no material: transforms only)", static_cast<unsigned long long>(frames));
+    std::printf("%-12s %10s %10s\n", "loop", "ms/frame", "frames/s");
+    std::printf("%-12s %10.3f %10.0f\n", "sequential", sequentialMs, 1000.0 / sequentialMs);
+    std::printf("%-12s %10.3f %10.0f\n", "pipelined", pipelinedMs, 1000.0 / pipelinedMs);
+    std::printf("speedup: %.2fx\n", sequentialMs / pipelinedMs);
+    return 0;
+}
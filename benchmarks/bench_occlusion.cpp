@@ -0,0 +1,80 @@
+// Micro-benchmark: software occlusion culling of a street-level city view.
+// Buildings on a grid are the occluders, props scattered between them are the tested boxes.
+// Usage: bench_occlusion [propCount]
+#include <filament_engine/math/occlusion_buffer.h>
+
+#include "bench_utils.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+int main(int argc, char** argv) {
+    size_t count = 100'000;
+    if (argc > 1) {
+        count = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    // Unit cube shared by every building
+    const std::vector<fe::Vec3> cube = {{-1, -1, -1}, {1, -1, -1}, {1, 1, -1}, {-1, 1, -1},
+                                        {-1, -1, 1},  {1, -1, 1},  {1, 1, 1},  {-1, 1, 1}};
+    const std::vector<uint32_t> cubeIndices = {0, 1, 2, 0, 2, 3, 4, 6, 5, 4, 7, 6, 0, 4, 5, 0, 5, 1,
+                                               3, 2, 6, 3, 6, 7, 0, 3, 7, 0, 7, 4, 1, 5, 6, 1, 6, 2};
+
+    // 40 x 40 blocks of 20 m buildings with 10 m streets; the camera stands in a street
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> height(10.0f, 60.0f);
+    std::vector<fe::Mat4> buildings;
+    for (int bx = -20; bx < 20; ++bx) {
+        for (int bz = -20; bz < 20; ++bz) {
+            const float h = height(rng);
+            buildings.push_back(fe::Mat4::translation({bx * 30.0f + 15.0f, h * 0.5f, bz * 30.0f + 15.0f}) *
+                                fe::Mat4::scaling({10.0f, h * 0.5f, 10.0f}));
+        }
+    }
+
+    std::uniform_real_distribution<float> position(-600.0f, 600.0f);
+    std::vector<fe::Aabb> props(count);
+    for (auto& prop : props) prop = {{position(rng), 1.0f, position(rng)}, {1.0f, 1.0f, 1.0f}};
+
+    const fe::Mat4 view = fe::Mat4::translation({0.0f, -1.7f, 0.0f});
+    const fe::Mat4 viewProjection = fe::Mat4::perspective(60.0f, 16.0f / 9.0f, 0.1f, 1000.0f) * view;
+    const fe::Frustum frustum = fe::Frustum::fromMatrix(viewProjection);
+
+    fe::OcclusionBuffer buffer;
+    buffer.resize(320, 192);
+
+    std::printf("OcclusionBuffer %ux%u, %zu buildings, %zu props\n",
+                buffer.getWidth(), buffer.getHeight(), buildings.size(), count);
+    std::printf("%-28s %10s\n", "operation", "ms");
+
+    double rasterMs = bench::bestOfMs(10, [&] {
+        buffer.begin(viewProjection);
+        for (const auto& model : buildings) {
+            const fe::Aabb bounds = fe::transformAabb(model, {{0, 0, 0}, {1, 1, 1}});
+            if (!frustum.intersects(bounds)) continue;
+            buffer.addOccluder(model, &cube[0].x, sizeof(fe::Vec3), cube.size(), cubeIndices.data(), cubeIndices.size());
+        }
+        buffer.rasterize();
+    });
+    std::printf("%-28s %10.3f   (%zu triangles)\n", "setup + rasterize", rasterMs, buffer.getTriangleCount());
+
+    size_t inFrustum = 0;
+    size_t occluded = 0;
+    double testMs = bench::bestOfMs(5, [&] {
+        inFrustum = 0;
+        occluded = 0;
+        for (const auto& prop : props) {
+            if (!frustum.intersects(prop)) continue;
+            ++inFrustum;
+            occluded += buffer.isOccluded(prop);
+        }
+    });
+    std::printf("%-28s %10.3f\n", "frustum + occlusion tests", testMs);
+
+    const size_t drawn = inFrustum - occluded;
+    std::printf("in frustum %zu, occluded %zu, drawn %zu (%.1f%% of the frustum survivors culled)\n",
+                inFrustum, occluded, drawn, inFrustum ? 100.0 * occluded / inFrustum : 0.0);
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Micro-benchmark: serial EnTT view iteration vs fe::parallelForEach on a JobSystem.
+// Usage: bench_parallel_for_each [chunkSize]
+#include <filament_engine/ecs/parallel_for_each.h>
+#include <filament_engine/ecs/components.h>
+
+#include "bench_utils.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+struct VelocityComponent {
+    fe::Vec3 linear{0, 0, 0};
+    fe::Vec3 angular{0, 0, 0};
+};
+
+// A small but non-trivial per-entity workload: integrate motion and renormalize rotation
+void integrate(fe::TransformComponent& transform, const VelocityComponent& velocity, float dt) {
+    transform.position += velocity.linear * dt;
+    fe::Quat spin{0, velocity.angular.x, velocity.angular.y, velocity.angular.z};
+    transform.rotation = normalize(transform.rotation + spin * transform.rotation * (0.5f * dt));
+}
+
+void populate(entt::registry& registry, size_t count) {
+    registry.clear();
+    for (size_t i = 0; i < count; ++i) {
+        auto entity = registry.create();
+        float f = static_cast<float>(i);
+        registry.emplace<fe::TransformComponent>(entity);
+        registry.emplace<VelocityComponent>(entity,
+            fe::Vec3{std::sin(f), std::cos(f), 0.5f}, fe::Vec3{0, 1, 0});
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t chunkSize = fe::DEFAULT_PARALLEL_CHUNK_SIZE;
+    if (argc > 1) {
+        chunkSize = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    utils::JobSystem jobSystem;
+    jobSystem.adopt();
+
+    constexpr float dt = 1.0f / 60.0f;
+    constexpr int iterations = 10;
+    const size_t counts[] = {10'000, 100'000, 1'000'000};
+
+    std::printf("forEach vs forEachParallel (chunk=%u, threads=%zu)\n",
+        chunkSize, static_cast<size_t>(jobSystem.getThreadCount()));
+    std::printf("%12s %12s %12s %10s\n", "entities", "serial ms", "parallel ms", "speedup");
+
+    entt::registry registry;
+    for (size_t count : counts) {
+        populate(registry, count);
+
+        double serialMs = bench::bestOfMs(iterations, [&] {
+            auto view = registry.view<fe::TransformComponent, VelocityComponent>();
+            for (auto entity : view) {
+                integrate(view.get<fe::TransformComponent>(entity),
+                          view.get<VelocityComponent>(entity), dt);
+            }
+        });
+
+        double parallelMs = bench::bestOfMs(iterations, [&] {
+            fe::parallelForEach<fe::TransformComponent, VelocityComponent>(jobSystem, registry,
+                [](entt::entity, fe::TransformComponent& transform, VelocityComponent& velocity) {
+                    integrate(transform, velocity, dt);
+                },
+                chunkSize);
+        });
+
+        auto& first = registry.get<fe::TransformComponent>(*registry.view<fe::TransformComponent>().begin());
+        bench::doNotOptimize(first.position.x);
+
+        std::printf("%12zu %12.3f %12.3f %9.2fx\n", count, serialMs, parallelMs, serialMs / parallelMs);
+    }
+
+    jobSystem.emancipate();
+    return 0;
+}
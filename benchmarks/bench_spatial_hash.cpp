@@ -0,0 +1,64 @@
+// Micro-benchmark: SpatialHash rebuild and batched neighbor queries (crowd-avoidance shape).
+// Usage: bench_spatial_hash [agentCount]
+#include <filament_engine/ecs/spatial_hash.h>
+
+#include "bench_utils.h"
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+int main(int argc, char** argv) {
+    size_t count = 100'000;
+    if (argc > 1) {
+        count = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    utils::JobSystem jobSystem;
+    jobSystem.adopt();
+
+    // Agents on a ground plane, ~4 per square unit of a 160x160 area
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coordinate(-80.0f, 80.0f);
+    std::vector<entt::entity> entities(count);
+    std::vector<fe::Vec3> positions(count);
+    for (size_t i = 0; i < count; ++i) {
+        entities[i] = static_cast<entt::entity>(i);
+        positions[i] = {coordinate(rng), 0.0f, coordinate(rng)};
+    }
+
+    constexpr float radius = 1.0f;
+    constexpr int iterations = 10;
+    fe::SpatialHash hash;
+    hash.setCellSize(radius);
+
+    std::printf("SpatialHash, %zu agents, radius %.1f (threads=%zu)\n",
+        count, radius, static_cast<size_t>(jobSystem.getThreadCount()));
+    std::printf("%-28s %10s\n", "operation", "ms");
+
+    double serialBuildMs = bench::bestOfMs(iterations, [&] { hash.build(entities, positions); });
+    std::printf("%-28s %10.3f\n", "build (serial)", serialBuildMs);
+    double parallelBuildMs = bench::bestOfMs(iterations, [&] { hash.build(entities, positions, &jobSystem); });
+    std::printf("%-28s %10.3f\n", "build (parallel)", parallelBuildMs);
+
+    // Separation steering: sum of offsets to every neighbor, one output slot per agent
+    std::vector<fe::Vec3> steering(count);
+    auto accumulate = [&](uint32_t i, uint32_t j, float) {
+        steering[i] = steering[i] + (hash.getPosition(i) - hash.getPosition(j));
+    };
+
+    double serialQueryMs = bench::bestOfMs(iterations, [&] {
+        std::fill(steering.begin(), steering.end(), fe::Vec3{0, 0, 0});
+        hash.forEachNeighbor(radius, accumulate);
+    });
+    bench::doNotOptimize(steering[count / 2].x);
+    std::printf("%-28s %10.3f\n", "forEachNeighbor (serial)", serialQueryMs);
+
+    double parallelQueryMs = bench::bestOfMs(iterations, [&] {
+        std::fill(steering.begin(), steering.end(), fe::Vec3{0, 0, 0});
+        hash.forEachNeighborParallel(&jobSystem, radius, accumulate);
+    });
+    bench::doNotOptimize(steering[count / 2].x);
+    std::printf("%-28s %10.3f\n", "forEachNeighbor (parallel)", parallelQueryMs);
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Micro-benchmark: DynamicBvh build, refit under motion and queries vs. a linear scan.
+// Usage: bench_spatial_query [boxCount]
+#include <filament_engine/math/dynamic_bvh.h>
+
+#include "bench_utils.h"
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+int main(int argc, char** argv) {
+    size_t count = 200'000;
+    if (argc > 1) {
+        count = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> size(0.25f, 2.0f);
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+
+    std::vector<fe::Aabb> boxes(count);
+    for (auto& box : boxes) {
+        float half = size(rng);
+        box = {{position(rng), position(rng) * 0.1f, position(rng)}, {half, half, half}};
+    }
+
+    constexpr int rayCount = 1000;
+    std::vector<fe::Vec3> origins(rayCount), directions(rayCount);
+    for (int i = 0; i < rayCount; ++i) {
+        origins[i] = {position(rng), 0.0f, position(rng)};
+        directions[i] = normalize(fe::Vec3{position(rng), position(rng) * 0.05f, position(rng)});
+    }
+
+    fe::DynamicBvh tree;
+    std::vector<uint32_t> proxies(count);
+
+    std::printf("DynamicBvh, %zu boxes\n", count);
+    std::printf("%-28s %10s\n", "operation", "ms");
+
+    double buildMs = bench::bestOfMs(3, [&] {
+        tree.clear();
+        for (size_t i = 0; i < count; ++i) {
+            proxies[i] = tree.insert(boxes[i], static_cast<uint32_t>(i));
+        }
+    });
+    std::printf("%-28s %10.3f   (height %d)\n", "insert all", buildMs, tree.getHeight());
+
+    // 10% of the boxes move a little each frame; most stay inside their fat box
+    double moveMs = bench::bestOfMs(10, [&] {
+        for (size_t i = 0; i < count; i += 10) {
+            boxes[i].center = boxes[i].center + fe::Vec3{jitter(rng), jitter(rng), jitter(rng)};
+            tree.move(proxies[i], boxes[i]);
+        }
+    });
+    std::printf("%-28s %10.3f\n", "move 10%", moveMs);
+
+    auto closestHit = [&](const fe::Vec3& origin, const fe::Vec3& direction) {
+        float best = 5000.0f;
+        tree.raycast(origin, direction, best, [&](uint32_t proxy, float maxT) {
+            float t = fe::intersectRayAabb(origin, direction, boxes[tree.getUserData(proxy)], maxT);
+            if (t < 0.0f) return maxT;
+            best = t;
+            return t;
+        });
+        return best;
+    };
+
+    double rayMs = bench::bestOfMs(5, [&] {
+        float sum = 0.0f;
+        for (int i = 0; i < rayCount; ++i) sum += closestHit(origins[i], directions[i]);
+        bench::doNotOptimize(sum);
+    });
+    std::printf("%-28s %10.4f\n", "raycast (per ray)", rayMs / rayCount);
+
+    double sphereMs = bench::bestOfMs(5, [&] {
+        size_t hits = 0;
+        for (int i = 0; i < rayCount; ++i) {
+            tree.querySphere(origins[i], 25.0f, [&](uint32_t proxy) {
+                hits += fe::intersectSphereAabb(origins[i], 25.0f, boxes[tree.getUserData(proxy)]);
+                return true;
+            });
+        }
+        bench::doNotOptimize(static_cast<float>(hits));
+    });
+    std::printf("%-28s %10.4f\n", "overlapSphere r=25 (each)", sphereMs / rayCount);
+
+    double linearMs = bench::bestOfMs(3, [&] {
+        float best = 5000.0f;
+        for (const auto& box : boxes) {
+            float t = fe::intersectRayAabb(origins[0], directions[0], box, best);
+            if (t >= 0.0f) best = t;
+        }
+        bench::doNotOptimize(best);
+    });
+    std::printf("%-28s %10.4f\n", "raycast, linear scan", linearMs);
+    return 0;
+}
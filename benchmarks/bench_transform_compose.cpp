@@ -0,0 +1,55 @@
+// Micro-benchmark: per-entity TRS composition vs. the batched SIMD kernels.
+// Usage: bench_transform_compose [entityCount]
+#include <filament_engine/ecs/transform_hierarchy.h>
+#include <filament_engine/math/simd_transform.h>
+
+#include "bench_utils.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+int main(int argc, char** argv) {
+    size_t count = 30'000;
+    if (argc > 1) {
+        count = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    std::vector<fe::TransformComponent> transforms(count);
+    fe::TransformSoA soa;
+    soa.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        float f = static_cast<float>(i);
+        auto& t = transforms[i];
+        t.position = {std::sin(f), std::cos(f), f * 0.01f};
+        t.rotation = normalize(fe::Quat{std::cos(f), 0, std::sin(f), 0});
+        t.scale = {1.0f, 1.0f + 0.001f * f, 1.0f};
+        soa.set(i, t.position, t.rotation, t.scale);
+    }
+
+    std::vector<fe::Mat4> out(count);
+    constexpr int iterations = 20;
+
+    std::printf("TRS composition, %zu transforms (detected: %s)\n",
+        count, fe::getSimdLevelName(fe::getSimdLevel()));
+    std::printf("%-14s %10s %10s\n", "path", "ms", "speedup");
+
+    double baselineMs = bench::bestOfMs(iterations, [&] {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = fe::TransformHierarchy::composeLocal(transforms[i]);
+        }
+    });
+    bench::doNotOptimize(out[count / 2][3][0]);
+    std::printf("%-14s %10.3f %9.2fx\n", "composeLocal", baselineMs, 1.0);
+
+    for (auto level : {fe::SimdLevel::Scalar, fe::SimdLevel::SSE2, fe::SimdLevel::AVX2, fe::SimdLevel::NEON}) {
+        if (!fe::isSimdLevelSupported(level)) continue;
+
+        double ms = bench::bestOfMs(iterations, [&] {
+            fe::composeTransforms(soa, out.data(), level);
+        });
+        bench::doNotOptimize(out[count / 2][3][0]);
+        std::printf("%-14s %10.3f %9.2fx\n", fe::getSimdLevelName(level), ms, baselineMs / ms);
+    }
+    return 0;
+}
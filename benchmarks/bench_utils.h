@@ -0,0 +1,31 @@
+#pragma once
+
+// Minimal timing helpers shared by the micro-benchmarks.
+// Each benchmark is a standalone executable that prints a table to stdout.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace bench {
+
+// Runs func `iterations` times and returns the best wall time in milliseconds
+template <typename Func>
+double bestOfMs(int iterations, Func&& func) {
+    double best = 1e30;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+// Prevents the optimizer from discarding a computed value (portable, MSVC included)
+inline void doNotOptimize(float value) {
+    static volatile float sink;
+    sink = value;
+}
+
+} // namespace bench
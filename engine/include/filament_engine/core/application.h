@@ -10,6 +10,8 @@
 #include <filament_engine/ui/overlay.h>
 #include <filament_engine/ui/imgui_layer.h>
 
+#include <utils/JobSystem.h>
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -22,9 +24,33 @@ class World; // forward declaration
 struct ApplicationConfig {
     WindowConfig window;
     GraphicsBackend backend = GraphicsBackend::Vulkan;
+
+    // Simulation rate in Hz for onFixedUpdate and fixed-rate systems. 0 runs one step per
+    // frame with the frame time; otherwise rendered transforms are interpolated between steps.
+    float fixedUpdateRate = 0.0f;
+    uint32_t maxFixedSteps = 5; // per frame; longer stalls drop time instead of catching up
+
+    // Runs the simulation (onFixedUpdate and fixed-rate systems) for the next frame on a
+    // worker while Filament renders the current one, at the cost of one frame of latency.
+    // During the overlap the worker owns the World (registry, command buffers, trackers)
+    // and Input. The main thread touches only Filament and the DebugRenderer. Simulation code
+    // must therefore stay off Filament, ImGui and the DebugRenderer, and must record
+    // structural changes with world.commands(). The commands are played back on the main
+    // thread after the join, together with fixed-rate systems pinned to it (see World::setPipelined).
+    bool pipelined = false;
+
+    // No SDL window: Filament's Noop backend renders into an offscreen swap chain of
+    // window.width x window.height, for CPU profiling on machines without a display or GPU.
+    // There is no ImGui layer, so onImGui and overlays are skipped.
+    bool headless = false;
+
+    // The main loop ends after this many frames or seconds, whichever comes first (0 = no limit)
+    uint64_t maxFrames = 0;
+    double maxDuration = 0.0;
 };
 
 // Subclass this and override onInit/onUpdate/onShutdown/onImGui.
+// onFixedUpdate runs once per simulation step before onUpdate (see ApplicationConfig::fixedUpdateRate).
 class Application {
 public:
     Application(const ApplicationConfig& config = {});
@@ -34,21 +60,26 @@ public:
     Application& operator=(const Application&) = delete;
 
     void run();
+    void quit() { m_quitRequested = true; } // ends the main loop after the current frame
     virtual void onInit() {}
+    virtual void onFixedUpdate(float step) {}
     virtual void onUpdate(float dt) {}
     virtual void onShutdown() {}
     virtual void onImGui() {} // override to draw ImGui widgets
 
     // Accessors
-    Window& getWindow() { return *m_window; }
+    Window& getWindow() { return *m_window; } // not available headless
+    bool isHeadless() const { return m_config.headless; }
+    uint64_t getFrameCount() const { return m_frameCount; }
     RenderContext& getRenderContext() { return *m_renderContext; }
     Input& getInput() { return m_input; }
     InputMap& getInputMap() { return m_inputMap; }
     Clock& getClock() { return m_clock; }
+    FixedTimestep& getFixedTimestep() { return m_fixedTimestep; }
     EventBus& getEventBus() { return m_eventBus; }
     World& getWorld() { return *m_world; }
     DebugRenderer& getDebugRenderer() { return *m_debugRenderer; }
-    ImGuiLayer& getImGuiLayer() { return *m_imguiLayer; }
+    ImGuiLayer& getImGuiLayer() { return *m_imguiLayer; } // not available headless
 
     // Overlay management
     template <typename T, typename... Args>
@@ -65,6 +96,13 @@ protected:
     ApplicationConfig m_config;
 
 private:
+    // Fixed steps (or one step of dt) for the next frame
+    void simulate(float dt);
+    void beginSimulation(float dt);
+    void waitForSimulation();
+    void finishSimulation(); // main thread, once the steps are done
+    bool shouldStop() const;
+
     std::unique_ptr<Window> m_window;
     std::unique_ptr<RenderContext> m_renderContext;
     std::unique_ptr<World> m_world;
@@ -73,8 +111,14 @@ private:
     Input m_input;
     InputMap m_inputMap{"Default"};
     Clock m_clock;
+    FixedTimestep m_fixedTimestep;
     EventBus m_eventBus;
     std::vector<std::unique_ptr<Overlay>> m_overlays;
+    utils::JobSystem::Job* m_simulationJob = nullptr; // pipelined simulation in flight
+    float m_simulatedAlpha = 1.0f; // written by the simulation, published by finishSimulation()
+    uint64_t m_frameCount = 0;
+    double m_loopStartTime = 0.0;
+    bool m_quitRequested = false;
 };
 
 } // namespace fe
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 
 namespace fe {
 
@@ -30,4 +31,35 @@ private:
     double m_elapsedTime = 0.0;
 };
 
+// Fixed-step accumulator: turns variable frame times into a whole number of simulation steps
+// of 1 / rateHz seconds. Time that does not make a full step carries over to the next frame;
+// getAlpha() is how far the frame has advanced into that next step, for interpolation.
+class FixedTimestep {
+public:
+    explicit FixedTimestep(float rateHz = 60.0f, uint32_t maxSteps = 5);
+
+    // Changing the rate keeps the accumulated time
+    void setRate(float rateHz);
+    float getRate() const { return 1.0f / m_step; }
+    float getStep() const { return m_step; }
+
+    // Caps the steps per frame; time past the cap is dropped so a long stall (debugger,
+    // loading) does not make the simulation spiral trying to catch up
+    void setMaxSteps(uint32_t maxSteps) { m_maxSteps = maxSteps > 0 ? maxSteps : 1; }
+    uint32_t getMaxSteps() const { return m_maxSteps; }
+
+    // Adds a frame's worth of time and returns the number of steps to run now
+    uint32_t advance(float dt);
+
+    // Leftover time as a fraction of a step, in [0, 1)
+    float getAlpha() const { return m_accumulator / m_step; }
+
+    void reset() { m_accumulator = 0.0f; }
+
+private:
+    float m_step;
+    float m_accumulator = 0.0f;
+    uint32_t m_maxSteps;
+};
+
 } // namespace fe
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Shipping builds can define FE_STRIP_NAMES=1 (CMake option FE_STRIP_NAMES) to drop the
+// string table: names become 32-bit hashes that still compare and index, but str() is empty.
+#ifndef FE_STRIP_NAMES
+#define FE_STRIP_NAMES 0
+#endif
+
+namespace fe {
+
+// FNV-1a, used as the name id when strings are stripped
+constexpr uint32_t hashName(std::string_view str) {
+    uint32_t hash = 2166136261u;
+    for (char c : str) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+#if !FE_STRIP_NAMES
+
+// Global, thread-safe string table. Id 0 is the empty string; strings are never freed.
+class NameTable {
+public:
+    static NameTable& get() {
+        static NameTable table;
+        return table;
+    }
+
+    // Returns the id of str, adding it to the table if needed
+    uint32_t intern(std::string_view str) {
+        if (str.empty()) return 0;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_ids.find(str);
+        if (it != m_ids.end()) return it->second;
+
+        const auto id = static_cast<uint32_t>(m_strings.size());
+        const auto& stored = m_strings.emplace_back(str); // deque: stored strings never move
+        m_ids.emplace(std::string_view(stored), id);
+        return id;
+    }
+
+    // Returns the id of str, or 0 if it was never interned (does not grow the table)
+    uint32_t find(std::string_view str) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_ids.find(str);
+        return it != m_ids.end() ? it->second : 0;
+    }
+
+    const std::string& str(uint32_t id) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return id < m_strings.size() ? m_strings[id] : m_strings[0];
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_strings.size();
+    }
+
+private:
+    NameTable() { m_strings.emplace_back(); }
+
+    mutable std::mutex m_mutex;
+    std::deque<std::string> m_strings;
+    std::unordered_map<std::string_view, uint32_t> m_ids;
+};
+
+#endif // !FE_STRIP_NAMES
+
+// Interned name: a 32-bit id into the NameTable (or a hash with FE_STRIP_NAMES).
+// Copying and comparing are integer operations; constructing from a string interns it.
+class Name {
+public:
+    Name() = default;
+    Name(std::string_view str) : m_id(toId(str)) {}
+    Name(const char* str) : Name(std::string_view(str)) {}
+    Name(const std::string& str) : Name(std::string_view(str)) {}
+
+    // Looks up an existing name without interning; empty if the string was never used
+    static Name find(std::string_view str) {
+        Name name;
+#if FE_STRIP_NAMES
+        name.m_id = toId(str);
+#else
+        name.m_id = NameTable::get().find(str);
+#endif
+        return name;
+    }
+
+    uint32_t id() const { return m_id; }
+    bool empty() const { return m_id == 0; }
+
+    // The original string (empty with FE_STRIP_NAMES)
+    const std::string& str() const {
+#if FE_STRIP_NAMES
+        static const std::string stripped;
+        return stripped;
+#else
+        return NameTable::get().str(m_id);
+#endif
+    }
+    const char* c_str() const { return str().c_str(); }
+
+    friend bool operator==(const Name& lhs, const Name& rhs) { return lhs.m_id == rhs.m_id; }
+
+    friend std::ostream& operator<<(std::ostream& os, const Name& name) {
+#if FE_STRIP_NAMES
+        return os << "#" << name.m_id;
+#else
+        return os << name.str();
+#endif
+    }
+
+private:
+    static uint32_t toId(std::string_view str) {
+        if (str.empty()) return 0;
+#if FE_STRIP_NAMES
+        const uint32_t hash = hashName(str);
+        return hash != 0 ? hash : 1; // 0 is reserved for the empty name
+#else
+        return NameTable::get().intern(str);
+#endif
+    }
+
+    uint32_t m_id = 0;
+};
+
+} // namespace fe
+
+namespace std {
+template <>
+struct hash<fe::Name> {
+    size_t operator()(const fe::Name& name) const noexcept { return name.id(); }
+};
+} // namespace std
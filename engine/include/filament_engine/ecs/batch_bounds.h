@@ -0,0 +1,27 @@
+#pragma once
+
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/math/frustum.h>
+
+#include <entt/entt.hpp>
+#include <utils/Entity.h>
+
+namespace fe {
+
+// Cull records of batch renderables: an entity with BatchBoundsComponent, BoundsComponent
+// and FilamentEntityComponent, so CullingSystem tests the whole batch like one renderable
+// (frustum, cells, occlusion) and adds or removes it from the scene as a unit.
+
+// Creates the record on first use (record == entt::null), otherwise replaces its box and
+// cell. Returns the record entity.
+entt::entity updateBatchBounds(entt::registry& registry, entt::entity record, utils::Entity renderable,
+                               const Aabb& worldBounds, entt::entity cell = entt::null);
+
+// Destroys the record, if any, and resets it to entt::null
+void destroyBatchBounds(entt::registry& registry, entt::entity& record);
+
+// VisibilityCellComponent entity whose box contains the point, or entt::null. Overlapping
+// cells resolve to the first one, as in CullingSystem.
+entt::entity findVisibilityCell(const entt::registry& registry, const Vec3& point);
+
+} // namespace fe
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace fe {
+
+// Append-only log of (entity, version) pairs for one component type.
+// Entries are sorted by version, so "changed since V" is a binary search plus a
+// walk over the tail. Superseded entries are compacted away as the log grows.
+class ChangeLog {
+public:
+    explicit ChangeLog(const std::atomic<uint64_t>* version) : m_version(version) {}
+
+    void record(entt::entity entity, uint64_t version);
+    void forget(entt::entity entity);
+
+    // Signal handlers (connected to on_construct/on_update and on_destroy)
+    void onChanged(entt::registry&, entt::entity entity) {
+        record(entity, m_version->load(std::memory_order_relaxed));
+    }
+    void onRemoved(entt::registry&, entt::entity entity) { forget(entity); }
+
+    // Visits every live entity whose latest change has version >= since, once
+    template <typename Func>
+    void forEachSince(uint64_t since, Func&& func) const {
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), since,
+            [](const Entry& entry, uint64_t version) { return entry.version < version; });
+        for (; it != m_entries.end(); ++it) {
+            if (isLatest(*it)) {
+                func(it->entity);
+            }
+        }
+    }
+
+    size_t getEntryCount() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        entt::entity entity;
+        uint64_t version;
+    };
+
+    bool isLatest(const Entry& entry) const {
+        const auto index = static_cast<size_t>(entt::to_entity(entry.entity));
+        return index < m_latest.size() &&
+               m_latest[index].entity == entry.entity &&
+               m_latest[index].version == entry.version;
+    }
+
+    void compact();
+
+    const std::atomic<uint64_t>* m_version;
+    std::vector<Entry> m_entries;
+    std::vector<Entry> m_latest; // indexed by entity index; version 0 = not logged
+    size_t m_liveCount = 0;
+};
+
+// Engine-wide change tracking hooked into EnTT's signals.
+// Component edits are reported through registry.patch<T>() / World::markChanged<T>();
+// emplacing a component also counts as a change, removing it forgets the entity.
+//
+// Consumers keep a cursor and advance it once per run:
+//   uint64_t since = m_cursor;
+//   m_cursor = tracker.advance();
+//   tracker.forEachChanged<LightComponent>(since, [&](entt::entity e) { ... });
+class ChangeTracker {
+public:
+    ChangeTracker() = default;
+    ChangeTracker(const ChangeTracker&) = delete;
+    ChangeTracker& operator=(const ChangeTracker&) = delete;
+
+    // Starts recording changes of T (idempotent)
+    template <typename T>
+    void track(entt::registry& registry) {
+        const auto id = entt::type_hash<T>::value();
+        if (m_logs.count(id)) return;
+
+        auto log = std::make_unique<ChangeLog>(&m_version);
+        registry.on_construct<T>().template connect<&ChangeLog::onChanged>(*log);
+        registry.on_update<T>().template connect<&ChangeLog::onChanged>(*log);
+        registry.on_destroy<T>().template connect<&ChangeLog::onRemoved>(*log);
+        m_logs.emplace(id, std::move(log));
+    }
+
+    template <typename T>
+    bool isTracked() const {
+        return m_logs.count(entt::type_hash<T>::value()) != 0;
+    }
+
+    // Records a change without going through the registry's signals
+    template <typename T>
+    void markChanged(entt::entity entity) {
+        if (auto* log = getLog<T>()) {
+            log->record(entity, getVersion());
+        }
+    }
+
+    // Visits entities whose T changed at or after `since` (each entity once)
+    template <typename T, typename Func>
+    void forEachChanged(uint64_t since, Func&& func) const {
+        if (const auto* log = getLog<T>()) {
+            log->forEachSince(since, std::forward<Func>(func));
+        }
+    }
+
+    // Number of log entries kept for T (diagnostics)
+    template <typename T>
+    size_t getEntryCount() const {
+        const auto* log = getLog<T>();
+        return log ? log->getEntryCount() : 0;
+    }
+
+    // Starts a new version; changes recorded from now on are >= the returned value.
+    // Safe to call from concurrently running systems.
+    uint64_t advance() { return m_version.fetch_add(1, std::memory_order_relaxed) + 1; }
+    uint64_t getVersion() const { return m_version.load(std::memory_order_relaxed); }
+
+private:
+    template <typename T>
+    ChangeLog* getLog() const {
+        auto it = m_logs.find(entt::type_hash<T>::value());
+        return it != m_logs.end() ? it->second.get() : nullptr;
+    }
+
+    std::atomic<uint64_t> m_version{1}; // 0 is reserved for "never changed"
+    std::unordered_map<entt::id_type, std::unique_ptr<ChangeLog>> m_logs;
+};
+
+} // namespace fe
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <filament_engine/core/name.h>
+
+#include <entt/entt.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fe {
+
+class World;
+
+// Entity argument of a recorded command: either an existing entity or one created
+// earlier by the same CommandBuffer (resolved when the buffer is played back).
+struct CommandEntity {
+    static constexpr uint32_t NOT_PENDING = ~0u;
+
+    CommandEntity() = default;
+    CommandEntity(entt::entity e) : entity(e) {}
+
+    bool isPending() const { return pending != NOT_PENDING; }
+
+    entt::entity entity = entt::null;
+    uint32_t pending = NOT_PENDING; // index into the buffer's create list
+};
+
+// Records structural ECS changes (create/destroy/add/set/remove) for deferred playback.
+// A buffer belongs to one thread and needs no locking while recording; get one with
+// World::commands(). Payloads live in a block arena, so recording does not allocate
+// per command once the blocks have grown to the frame's working size.
+class CommandBuffer {
+public:
+    CommandBuffer() = default;
+    ~CommandBuffer();
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    // Creates an entity with the default components (see World::createEntity)
+    CommandEntity create(std::string_view name = "Entity");
+
+    // Destroys an entity. All destroys of a flush run last, as one batch.
+    void destroy(CommandEntity entity);
+
+    // Adds (or replaces) component T, constructed from args at record time
+    template <typename T, typename... Args>
+    void add(CommandEntity entity, Args&&... args) {
+        record<AddPayload<T>>(entity, T{std::forward<Args>(args)...});
+    }
+
+    // Assigns component T (added if missing); counts as a change for the ChangeTracker
+    template <typename T>
+    void set(CommandEntity entity, T value) {
+        record<AddPayload<T>>(entity, std::move(value));
+    }
+
+    template <typename T>
+    void remove(CommandEntity entity) {
+        record<RemovePayload<T>>(entity);
+    }
+
+    bool empty() const { return m_commands.empty() && m_creates.empty() && m_destroys.empty(); }
+    size_t getCommandCount() const { return m_commands.size() + m_creates.size() + m_destroys.size(); }
+
+    // Playback (driven by CommandQueue::flush on the main thread).
+    // `created` holds the entities made for this buffer's create() calls, in order.
+    const std::vector<Name>& getCreates() const { return m_creates; }
+    void play(entt::registry& registry, std::span<const entt::entity> created);
+    void collectDestroys(std::span<const entt::entity> created, std::vector<entt::entity>& out) const;
+    void clear();
+
+private:
+    struct Command {
+        void (*play)(void* payload, entt::registry& registry, std::span<const entt::entity> created);
+        void (*destroy)(void* payload);
+        void* payload;
+    };
+
+    static entt::entity resolve(const CommandEntity& target, std::span<const entt::entity> created) {
+        return target.isPending() ? created[target.pending] : target.entity;
+    }
+
+    template <typename T>
+    struct AddPayload {
+        CommandEntity target;
+        T value;
+
+        static void play(void* payload, entt::registry& registry, std::span<const entt::entity> created) {
+            auto& self = *static_cast<AddPayload*>(payload);
+            auto entity = resolve(self.target, created);
+            if (registry.valid(entity)) {
+                registry.emplace_or_replace<T>(entity, std::move(self.value));
+            }
+        }
+    };
+
+    template <typename T>
+    struct RemovePayload {
+        CommandEntity target;
+
+        static void play(void* payload, entt::registry& registry, std::span<const entt::entity> created) {
+            auto& self = *static_cast<RemovePayload*>(payload);
+            auto entity = resolve(self.target, created);
+            if (registry.valid(entity)) {
+                registry.remove<T>(entity);
+            }
+        }
+    };
+
+    template <typename Payload, typename... Args>
+    void record(Args&&... args) {
+        static_assert(alignof(Payload) <= alignof(std::max_align_t), "over-aligned components are not supported");
+        void* memory = allocate(sizeof(Payload), alignof(Payload));
+        auto* payload = new (memory) Payload{std::forward<Args>(args)...};
+
+        void (*destroy)(void*) = nullptr;
+        if constexpr (!std::is_trivially_destructible_v<Payload>) {
+            destroy = [](void* p) { static_cast<Payload*>(p)->~Payload(); };
+        }
+        m_commands.push_back({&Payload::play, destroy, payload});
+    }
+
+    void* allocate(size_t size, size_t alignment);
+
+    static constexpr size_t BLOCK_SIZE = 16 * 1024;
+
+    std::vector<Command> m_commands;
+    std::vector<Name> m_creates;
+    std::vector<CommandEntity> m_destroys;
+
+    std::vector<std::unique_ptr<std::byte[]>> m_blocks;    // reused across flushes
+    std::vector<std::unique_ptr<std::byte[]>> m_oversized; // payloads > BLOCK_SIZE, freed on clear
+    size_t m_block = 0;
+    size_t m_offset = 0;
+};
+
+// One CommandBuffer per recording thread, flushed together at a single point.
+// Recording is lock-free after a thread's first call; flush() must not overlap recording.
+class CommandQueue {
+public:
+    CommandQueue();
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    // The calling thread's buffer
+    CommandBuffer& local();
+
+    // Plays every buffer back on the main thread: all creates as one bulk World::createEntities,
+    // then each buffer's commands in record order (buffers in first-use order), then all
+    // destroys as one World::destroyEntities.
+    void flush(World& world);
+
+    bool empty() const;
+
+private:
+    struct ThreadBuffer {
+        std::thread::id thread;
+        std::unique_ptr<CommandBuffer> buffer;
+    };
+
+    mutable std::mutex m_mutex;
+    std::vector<ThreadBuffer> m_buffers;
+    uint64_t m_id; // distinguishes queues in the per-thread lookup cache
+
+    // Flush scratch
+    std::vector<entt::entity> m_created;
+    std::vector<entt::entity> m_destroyed;
+};
+
+} // namespace fe
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <filament_engine/core/name.h>
 #include <filament_engine/math/types.h>
+#include <filament_engine/math/frustum.h>
 #include <filament_engine/resources/resource_handle.h>
+#include <filament_engine/resources/material_parameters.h>
 
 #include <entt/entt.hpp>
 
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace fe {
 
@@ -13,30 +19,143 @@ namespace fe {
 struct Mesh;
 class MaterialWrapper;
 
-// Synced to Filament's TransformManager when dirty.
+// Local transform (relative to the parent in HierarchyComponent).
+// Synced to Filament's TransformManager when changed — report edits with
+// World::markChanged<TransformComponent>() or World::patchComponent().
 struct TransformComponent {
     Vec3 position{0, 0, 0};
     Quat rotation = Quat{1, 0, 0, 0}; // identity quaternion (w, x, y, z)
     Vec3 scale{1, 1, 1};
+};
+// Parent/child links, maintained by World::setParent (don't edit directly).
+// Children form an intrusive doubly-linked sibling list; depth is 0 for roots.
+struct HierarchyComponent {
     entt::entity parent{entt::null};
-    bool dirty = true; // set to true when the transform needs syncing to Filament
+    entt::entity firstChild{entt::null};
+    entt::entity nextSibling{entt::null};
+    entt::entity prevSibling{entt::null};
+    uint32_t depth = 0;
+};
+// Cached world matrix, recomputed by TransformSyncSystem for dirty subtrees.
+struct WorldTransformComponent {
+    Mat4 matrix;
+    uint32_t updatedPass = 0; // internal: hierarchy pass that last recomputed this matrix
+    uint32_t dirtyPass = 0;   // internal: hierarchy pass that flagged this entity as dirty
 };
+// Interned entity name (32-bit id, no per-entity heap allocation).
+// Looked up by World::findByName / findAllByName.
 struct TagComponent {
-    std::string name;
+    Name name;
 };
 struct MeshRendererComponent {
     ResourceHandle<Mesh> mesh;
     ResourceHandle<MaterialWrapper> material;
     bool castShadows = true;
     bool receiveShadows = true;
-    bool initialized = false; // internal: whether Filament renderable has been created
+    bool allowInstancing = true; // may share one instanced renderable with identical renderers
+    bool initialized = false;    // internal: whether Filament renderable has been created
+
+    static constexpr uint32_t NO_BATCH = ~0u;
+    uint32_t batch = NO_BATCH;    // internal: InstanceBatcher batch, NO_BATCH for an own renderable
+    uint32_t batchKey = NO_BATCH; // internal: InstanceBatcher key of an own renderable
+    uint32_t batchSlot = 0;       // internal: position in the batch (or in the key's individual list)
+    uint32_t builtMesh = 0;       // internal: mesh id the renderable was built with
+};
+// Level-of-detail meshes for the entity's MeshRendererComponent, most detailed first.
+// Level i is used while the object's projected height is at least levels[i].screenSize
+// (fraction of the viewport height, e.g. 0.25); below the last threshold the last level stays.
+// LODSystem writes the selected mesh into MeshRendererComponent::mesh.
+struct LODLevel {
+    ResourceHandle<Mesh> mesh;
+    float screenSize = 0.0f;
+};
+struct LODGroupComponent {
+    std::vector<LODLevel> levels;
+    float hysteresis = 0.1f; // relative band around each threshold, avoids popping at the boundary
+
+    uint32_t current = 0;             // internal: selected level
+    uint32_t target = 0;              // internal: level picked this frame
+    Vec3 localCenter{0, 0, 0};        // internal: bounding sphere of the first level
+    float localRadius = -1.0f;        // internal: < 0 until the first level's mesh is loaded
+};
+// Per-entity material parameters on top of MeshRendererComponent::material.
+// Entities with equal parameters share one pooled MaterialInstance (and can still be
+// instanced together). Edit through World::patchComponent() so renderers pick it up.
+struct MaterialOverrideComponent {
+    MaterialParameters parameters;
+    uint32_t instance = 0; // internal: MaterialInstancePool reference held by this component
+
+    MaterialOverrideComponent() = default;
+    MaterialOverrideComponent(MaterialParameters params) : parameters(std::move(params)) {}
+
+    // Copies carry the parameters only; the pool reference belongs to the original
+    MaterialOverrideComponent(const MaterialOverrideComponent& other) : parameters(other.parameters) {}
+    MaterialOverrideComponent& operator=(const MaterialOverrideComponent& other) {
+        parameters = other.parameters;
+        return *this;
+    }
+    MaterialOverrideComponent(MaterialOverrideComponent&& other) noexcept
+        : parameters(std::move(other.parameters)), instance(std::exchange(other.instance, 0)) {}
+    MaterialOverrideComponent& operator=(MaterialOverrideComponent&& other) noexcept {
+        parameters = std::move(other.parameters);
+        instance = std::exchange(other.instance, 0);
+        return *this;
+    }
+};
+// Mobility marker for entities that are not expected to move (walls, props, terrain).
+// StaticBatchSystem merges static renderers into combined world-space meshes and their
+// transforms are no longer pushed to Filament. Moving one still works but rebuilds its batch.
+struct StaticComponent {
+    static constexpr uint32_t NO_BATCH = ~0u;
+    uint32_t batch = NO_BATCH; // internal: StaticBatchSystem batch
+    uint32_t batchSlot = 0;    // internal: position in the batch
+};
+// Marks small moving objects (particles, crowd agents) for SpatialHashSystem's
+// per-frame point grid, keyed on the world position.
+struct SpatialHashComponent {};
+// Renderable bounds, added by RenderSyncSystem from Mesh::boundingBox.
+// The world box is kept current by CullingSystem from the cached world matrix.
+struct BoundsComponent {
+    Aabb local;
+    Aabb world;
+    entt::entity root{entt::null}; // internal: hierarchy root this renderable is culled with
+    uint32_t cell = ~0u;           // internal: visibility cell containing the world box center
+    bool culled = false;           // internal: removed from the filament::Scene by CullingSystem
+};
+// Marks the engine-owned entity that stands in for an instanced or static batch renderable
+// during culling (see batch_bounds.h). Its BoundsComponent holds the union of the members'
+// world boxes and has no transform. `cell` is the VisibilityCellComponent entity every
+// member lies in; entt::null leaves the batch out of the cell stage.
+struct BatchBoundsComponent {
+    entt::entity cell{entt::null};
+};
+// Room of an indoor level: the box of `halfExtent` around the entity, transformed by its
+// world matrix. Renderables whose bounds center lies in a cell belong to it. While the
+// camera is inside a cell, CullingSystem keeps only the cells seen through open portals;
+// renderables outside every cell are left to the other culling stages.
+struct VisibilityCellComponent {
+    Vec3 halfExtent{1, 1, 1};
+    uint32_t index = ~0u; // internal: PortalGraph cell
+};
+// Opening between two cells: a 2 * halfSize rectangle in the entity's local XY plane.
+// Closed portals (doors) block the view; toggle `open` through World::patchComponent().
+struct PortalComponent {
+    entt::entity cellA{entt::null};
+    entt::entity cellB{entt::null};
+    Vec2 halfSize{1, 1};
+    bool open = true;
+};
+// Marks big, solid geometry (walls, buildings, terrain) that CullingSystem rasterizes into
+// its CPU depth buffer to hide renderables behind it. Keep occluder meshes simple: the mesh
+// must be fully opaque, no larger than what it stands for, and created with keepCpuData.
+struct OccluderComponent {
+    ResourceHandle<Mesh> mesh; // invalid: the MeshRendererComponent's mesh
 };
 struct CameraComponent {
     float fov = 60.0f;
     float nearPlane = 0.1f;
     float farPlane = 1000.0f;
     bool isActive = false;
-    bool dirty = true;
 };
 struct LightComponent {
     enum class Type { Directional, Point, Spot };
@@ -47,8 +166,10 @@ struct LightComponent {
     float radius = 10.0f;        // for point/spot lights
     float innerConeAngle = 0.0f; // for spot lights (radians)
     float outerConeAngle = 0.5f; // for spot lights (radians)
-    bool castShadows = false;
+    bool castShadows = false;    // eligible for a shadow map (LightSystem assigns the slots)
     bool initialized = false;    // internal: whether Filament light has been created
+    bool active = false;         // internal: in the scene this frame (chosen by the light budget)
+    bool shadowActive = false;   // internal: holds a shadow slot this frame
 };
 
 } // namespace fe
@@ -18,8 +18,9 @@ struct TagComponent;
 // Usage:
 //   auto entity = world.createEntity("Player");
 //   entity.addComponent<MeshRendererComponent>();
-//   entity.transform().position = {0, 1, 0};
+//   entity.patchComponent<TransformComponent>([](auto& t) { t.position = {0, 1, 0}; });
 //   entity.getComponent<CameraComponent>().fov = 90.0f;
+//   entity.markChanged<CameraComponent>(); // edits through a reference must be reported
 class Entity {
 public:
     Entity() = default;
@@ -47,6 +48,13 @@ public:
     template <typename T>
     void removeComponent();
 
+    // Change tracking (see World::markChanged / World::patchComponent)
+    template <typename T>
+    void markChanged();
+
+    template <typename T, typename... Func>
+    T& patchComponent(Func&&... func);
+
     // Convenience shortcuts
     TransformComponent& transform();
     const TransformComponent& transform() const;
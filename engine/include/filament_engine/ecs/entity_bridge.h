@@ -5,7 +5,11 @@
 
 #include <entt/entt.hpp>
 
-#include <unordered_map>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
 
 namespace fe {
 
@@ -16,14 +20,29 @@ struct FilamentEntityComponent {
 
 // Bidirectional mapping between EnTT entities and Filament entities.
 // Each game entity that needs rendering gets both an EnTT entity and a Filament entity.
+// EnTT → Filament is a component; Filament → EnTT is a paged sparse array indexed by
+// the Filament entity index (Filament indices are small and dense). Each slot keeps the
+// full Filament id, so a stale handle whose index was recycled fails the lookup.
 class EntityBridge {
 public:
     // Creates a new Filament entity and links it to the given EnTT entity
     utils::Entity link(entt::registry& registry, entt::entity entity);
 
+    // Bulk link: creates entities.size() Filament entities in one EntityManager call and
+    // inserts their FilamentEntityComponents as a range. Filament entities are written to `out`
+    // (same size as `entities`).
+    void linkRange(entt::registry& registry, std::span<const entt::entity> entities,
+                   std::span<utils::Entity> out);
+
     // Destroys the Filament entity and removes the mapping
     void unlink(entt::registry& registry, entt::entity entity);
 
+    // Bulk unlink: removes the mappings, destroys the Filament entities in one
+    // EntityManager call and removes the FilamentEntityComponents as a range.
+    // Every entity in `entities` must be valid and linked.
+    void unlinkRange(entt::registry& registry, std::span<const entt::entity> entities,
+                     std::span<utils::Entity> filamentEntities);
+
     // Lookup: Filament → EnTT
     entt::entity getEnttEntity(utils::Entity filamentEntity) const;
 
@@ -33,8 +52,25 @@ public:
     // Check if an EnTT entity has a Filament counterpart
     bool hasFilamentEntity(const entt::registry& registry, entt::entity entity) const;
 
+    // Number of live Filament → EnTT mappings
+    size_t getLinkCount() const { return m_linkCount; }
+
 private:
-    std::unordered_map<uint32_t, entt::entity> m_filamentToEntt;
+    static constexpr size_t PAGE_SIZE = 4096; // slots per page (32 KB)
+
+    struct Slot {
+        uint32_t filamentId = 0; // 0 = empty (never a valid Filament entity id)
+        entt::entity entity = entt::null;
+    };
+    using Page = std::array<Slot, PAGE_SIZE>;
+
+    Slot& assureSlot(utils::Entity filamentEntity);
+    const Slot* findSlot(utils::Entity filamentEntity) const;
+    void setReverse(utils::Entity filamentEntity, entt::entity entity);
+    void clearReverse(utils::Entity filamentEntity);
+
+    std::vector<std::unique_ptr<Page>> m_pages;
+    size_t m_linkCount = 0;
 };
 
 } // namespace fe
@@ -38,4 +38,14 @@ void Entity::removeComponent() {
     m_world->removeComponent<T>(m_handle);
 }
 
+template <typename T>
+void Entity::markChanged() {
+    m_world->markChanged<T>(m_handle);
+}
+
+template <typename T, typename... Func>
+T& Entity::patchComponent(Func&&... func) {
+    return m_world->patchComponent<T>(m_handle, std::forward<Func>(func)...);
+}
+
 } // namespace fe
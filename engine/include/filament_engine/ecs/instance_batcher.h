@@ -0,0 +1,89 @@
+#pragma once
+
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/ecs/instance_grouping.h>
+#include <filament_engine/math/frustum.h>
+
+#include <entt/entt.hpp>
+#include <utils/Entity.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace filament {
+class InstanceBuffer;
+} // namespace filament
+
+namespace fe {
+
+class World;
+struct Mesh;
+
+// Groups MeshRendererComponents that share (mesh, material, material override, shadow flags) into instanced
+// Filament renderables backed by an InstanceBuffer. A key starts out with one renderable
+// per entity; once `threshold` renderers share it, they are all moved into batches of up
+// to MAX_INSTANCES_PER_BATCH instances. Per-instance transforms are the cached world
+// matrices, re-uploaded for batches whose members moved. The grouping itself lives in
+// InstanceGrouping; this class owns the Filament side of each batch. Each batch is culled
+// as a unit through a cull record (batch_bounds.h) with the union of its instances' boxes;
+// members may be spread over several rooms, so batches skip the visibility cell stage.
+class InstanceBatcher {
+public:
+    // Filament's CONFIG_MAX_INSTANCES: InstanceBuffer::Builder rejects larger counts when
+    // transforms are supplied. Batches are further clamped to Engine::getMaxAutomaticInstances().
+    static constexpr uint32_t MAX_INSTANCES_PER_BATCH = 64;
+
+    InstanceBatcher() { m_grouping.setBatchCapacity(MAX_INSTANCES_PER_BATCH); }
+    InstanceBatcher(const InstanceBatcher&) = delete;
+    InstanceBatcher& operator=(const InstanceBatcher&) = delete;
+
+    void connect(entt::registry& registry);
+    void disconnect(entt::registry& registry);
+
+    // Number of renderers sharing a key before it switches to instancing (0 disables)
+    void setThreshold(uint32_t threshold) { m_grouping.setThreshold(threshold); }
+    uint32_t getThreshold() const { return m_grouping.getThreshold(); }
+
+    // Takes a renderer whose mesh and material are loaded; `overrideInstance` is its pooled
+    // MaterialInstancePool id (0 for none). Returns true if it joined an instanced batch;
+    // false means the caller builds an individual renderable for it.
+    bool add(World& world, entt::entity entity, MeshRendererComponent& renderer, const Mesh& mesh,
+             uint32_t overrideInstance = 0);
+
+    // Forgets a renderer (batch member or own renderable). The caller tears down an own renderable.
+    void remove(entt::registry& registry, entt::entity entity);
+
+    // Uploads moved transforms and rebuilds batches whose membership changed
+    void update(World& world);
+
+    // Destroys every batch renderable and instance buffer
+    void destroyAll(World& world);
+
+    size_t getBatchCount() const { return m_grouping.getBatchCount(); }
+    size_t getInstanceCount() const { return m_grouping.getInstanceCount(); }
+
+    // Signal handler (on_destroy<MeshRendererComponent>)
+    void onRendererDestroyed(entt::registry& registry, entt::entity entity) { remove(registry, entity); }
+
+private:
+    // Filament side of an InstanceGrouping batch, same index. The entity is kept when the
+    // batch is released and reused by whichever key takes the batch next.
+    struct BatchRenderable {
+        Aabb localBounds;
+        utils::Entity renderable;
+        filament::InstanceBuffer* buffer = nullptr;
+        entt::entity cullRecord{entt::null}; // BatchBoundsComponent entity while the batch has members
+        bool inScene = false;
+    };
+
+    void promote(World& world, uint32_t key);
+    void insert(entt::registry& registry, uint32_t key, entt::entity entity, MeshRendererComponent& renderer);
+    void rebuild(World& world, uint32_t index);
+    Aabb computeBounds(const InstanceGrouping::Batch& batch, const Aabb& localBounds) const;
+
+    InstanceGrouping m_grouping;
+    std::vector<BatchRenderable> m_renderables;
+    uint64_t m_changeCursor = 0;
+};
+
+} // namespace fe
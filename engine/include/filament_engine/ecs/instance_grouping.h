@@ -0,0 +1,113 @@
+#pragma once
+
+#include <filament_engine/math/types.h>
+
+#include <entt/entt.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace fe {
+
+// What renderers must share to be drawn as instances of one renderable
+struct InstanceKey {
+    uint32_t mesh = 0;
+    uint32_t material = 0;
+    uint32_t overrideInstance = 0; // MaterialInstancePool id, 0 for none
+    uint32_t shadowFlags = 0;      // 1 = casts, 2 = receives
+
+    bool operator==(const InstanceKey& other) const {
+        return mesh == other.mesh && material == other.material &&
+               overrideInstance == other.overrideInstance && shadowFlags == other.shadowFlags;
+    }
+};
+
+struct InstanceKeyHash {
+    size_t operator()(const InstanceKey& key) const {
+        return (size_t(key.mesh) * 0x9E3779B1u) ^ (size_t(key.material) << 2) ^
+               (size_t(key.overrideInstance) * 0x85EBCA6Bu) ^ key.shadowFlags;
+    }
+};
+
+// The bookkeeping half of the InstanceBatcher, with no Filament calls: which renderers share
+// a key, when a key switches to instancing, and how its instances are split into batches.
+// A key keeps a list of "individual" renderers (own renderables) until `threshold` of them
+// share it; promote() then hands them back to be inserted as instances. Batches hold up to
+// `batchCapacity` instances; a batch emptied by remove() is released and reused by the next
+// batch any key opens. Removal is swap-and-pop: the renderer moved into the freed slot is
+// returned so the caller can update its stored slot.
+class InstanceGrouping {
+public:
+    static constexpr uint32_t NONE = ~0u;
+
+    struct Batch {
+        uint32_t key = NONE;
+        std::vector<entt::entity> members;
+        std::vector<Mat4> transforms; // parallel to members
+        bool membershipDirty = false;
+        bool transformsDirty = false;
+    };
+
+    // Where insert() put a renderer
+    struct Placement {
+        uint32_t batch = NONE;
+        uint32_t slot = 0;
+    };
+
+    // Number of renderers sharing a key before it switches to instancing (0 disables)
+    void setThreshold(uint32_t threshold) { m_threshold = threshold; }
+    uint32_t getThreshold() const { return m_threshold; }
+
+    // Largest instance count of a batch; applies to batches opened or filled from now on
+    void setBatchCapacity(uint32_t capacity) { m_batchCapacity = capacity > 0 ? capacity : 1; }
+    uint32_t getBatchCapacity() const { return m_batchCapacity; }
+
+    // Index of the key's state, created on first use
+    uint32_t findOrAddKey(const InstanceKey& key);
+    const InstanceKey& getKey(uint32_t key) const { return m_keyStates[key].key; }
+
+    // True if the next renderer under `key` becomes an instance: the key is already
+    // instanced, or this renderer brings it to the threshold (the caller then promotes it)
+    bool wantsInstancing(uint32_t key) const;
+    bool isInstanced(uint32_t key) const { return m_keyStates[key].instanced; }
+
+    // Individual renderers: returns the slot of the added one
+    uint32_t addIndividual(uint32_t key, entt::entity entity);
+    entt::entity removeIndividual(uint32_t key, uint32_t slot);
+    const std::vector<entt::entity>& getIndividual(uint32_t key) const { return m_keyStates[key].individual; }
+
+    // Marks the key instanced and returns its individual renderers, to be inserted as instances
+    std::vector<entt::entity> promote(uint32_t key);
+
+    // Adds an instance to the key's last batch, opening one when it is full
+    Placement insert(uint32_t key, entt::entity entity, const Mat4& transform);
+    entt::entity removeInstance(uint32_t batch, uint32_t slot);
+
+    // Batch indices are stable; released batches have no members and no key
+    std::vector<Batch>& getBatches() { return m_batches; }
+    const std::vector<Batch>& getBatches() const { return m_batches; }
+    const std::vector<uint32_t>& getKeyBatches(uint32_t key) const { return m_keyStates[key].batches; }
+
+    size_t getBatchCount() const { return m_batches.size() - m_freeBatches.size(); }
+    size_t getInstanceCount() const;
+
+    void clear();
+
+private:
+    struct KeyState {
+        InstanceKey key{};
+        std::vector<entt::entity> individual;
+        std::vector<uint32_t> batches;
+        bool instanced = false;
+    };
+
+    std::unordered_map<InstanceKey, uint32_t, InstanceKeyHash> m_keys; // key -> m_keyStates index
+    std::vector<KeyState> m_keyStates;
+    std::vector<Batch> m_batches;
+    std::vector<uint32_t> m_freeBatches; // emptied batches, reused before new ones are opened
+    uint32_t m_threshold = 8;
+    uint32_t m_batchCapacity = 64;
+};
+
+} // namespace fe
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/math/frustum.h>
+
+#include <entt/entt.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace fe {
+
+// One light as seen by the budget: inputs filled by the caller, outputs by LightBudget::select
+struct LightCandidate {
+    entt::entity entity{entt::null};
+    LightComponent::Type type = LightComponent::Type::Point;
+    Vec3 position{0, 0, 0};
+    Vec3 color{1, 1, 1};
+    float intensity = 0.0f;
+    float radius = 0.0f;
+    bool castShadows = false;
+    bool wasActive = false;       // selected last frame (gets the hysteresis bonus)
+    bool wasShadowCaster = false;
+
+    float score = 0.0f;
+    bool active = false;
+    bool shadowCaster = false;
+};
+
+struct LightBudgetStats {
+    uint32_t lights = 0;        // candidates considered
+    uint32_t active = 0;        // kept in the scene
+    uint32_t outOfView = 0;     // dropped because their range misses the frustum
+    uint32_t overBudget = 0;    // visible but ranked below the budget
+    uint32_t shadowCasters = 0; // point/spot lights holding a shadow slot
+};
+
+// Ranks lights by their projected influence on the view and keeps the top ones.
+// Punctual lights score brightness (intensity * luminance) times the fraction of the view
+// their range covers; lights whose range sphere misses the frustum score 0 and are dropped.
+// Directional lights are always kept and never use a shadow slot. Lights that were active
+// last frame get a small bonus so that near-equal lights don't flicker in and out.
+class LightBudget {
+public:
+    void setMaxLights(uint32_t count) { m_maxLights = count; }
+    uint32_t getMaxLights() const { return m_maxLights; }
+
+    void setMaxShadowCasters(uint32_t count) { m_maxShadowCasters = count; }
+    uint32_t getMaxShadowCasters() const { return m_maxShadowCasters; }
+
+    // Relative score bonus for lights that are already active (0.1 = 10%)
+    void setHysteresis(float hysteresis) { m_hysteresis = hysteresis; }
+    float getHysteresis() const { return m_hysteresis; }
+
+    // Scores the candidates and sets their active/shadowCaster flags.
+    // `frustum` may be null (no camera): lights are then ranked by brightness alone.
+    void select(std::vector<LightCandidate>& candidates, const Vec3& viewPosition, const Frustum* frustum);
+
+    static float score(const LightCandidate& light, const Vec3& viewPosition, const Frustum* frustum);
+
+    // The chosen set from the last select(), for debugging
+    const std::vector<entt::entity>& getActiveLights() const { return m_active; }
+    const std::vector<entt::entity>& getShadowCasters() const { return m_shadowCasters; }
+    const LightBudgetStats& getStats() const { return m_stats; }
+
+private:
+    std::vector<uint32_t> m_order; // scratch: candidate indices by rank
+    std::vector<entt::entity> m_active;
+    std::vector<entt::entity> m_shadowCasters;
+    LightBudgetStats m_stats;
+    uint32_t m_maxLights = 128;
+    uint32_t m_maxShadowCasters = 4;
+    float m_hysteresis = 0.1f;
+};
+
+} // namespace fe
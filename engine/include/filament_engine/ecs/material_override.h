@@ -0,0 +1,25 @@
+#pragma once
+
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/resources/resource_handle.h>
+
+#include <entt/entt.hpp>
+
+namespace filament {
+class MaterialInstance;
+} // namespace filament
+
+namespace fe {
+
+class MaterialWrapper;
+
+// Points override.instance at the pooled instance for (material, override.parameters),
+// trading the previous reference if the parameters or the material changed.
+// Returns the instance, or nullptr without a ResourceManager.
+filament::MaterialInstance* resolveMaterialOverride(MaterialOverrideComponent& override,
+                                                    ResourceHandle<MaterialWrapper> material);
+
+// on_destroy<MaterialOverrideComponent> handler: drops the component's pool reference
+void releaseMaterialOverride(entt::registry& registry, entt::entity entity);
+
+} // namespace fe
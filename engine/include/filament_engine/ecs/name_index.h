@@ -0,0 +1,51 @@
+#pragma once
+
+#include <filament_engine/ecs/components.h>
+
+#include <entt/entt.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace fe {
+
+// Name → entities index over TagComponent, kept current through EnTT signals
+// (construct/update/destroy). Each entity remembers its slot in its bucket, so
+// renames and destruction are O(1) even when thousands of entities share a name.
+class NameIndex {
+public:
+    NameIndex() = default;
+    NameIndex(const NameIndex&) = delete;
+    NameIndex& operator=(const NameIndex&) = delete;
+
+    // Hooks the index into the registry's TagComponent signals
+    void connect(entt::registry& registry);
+
+    // Any entity with this name, or entt::null
+    entt::entity find(Name name) const;
+
+    // Appends every entity with this name to `out`
+    void findAll(Name name, std::vector<entt::entity>& out) const;
+
+    size_t count(Name name) const;
+
+    // Signal handlers
+    void onTagChanged(entt::registry& registry, entt::entity entity);
+    void onTagDestroyed(entt::registry& registry, entt::entity entity);
+
+private:
+    struct Record {
+        entt::entity entity = entt::null;
+        uint32_t nameId = 0;
+        uint32_t slot = 0; // position in m_buckets[nameId]
+    };
+
+    void insert(entt::entity entity, uint32_t nameId);
+    void erase(entt::entity entity);
+
+    std::unordered_map<uint32_t, std::vector<entt::entity>> m_buckets;
+    std::vector<Record> m_records; // indexed by entity index
+};
+
+} // namespace fe
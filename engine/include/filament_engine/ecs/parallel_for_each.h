@@ -0,0 +1,88 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include <utils/JobSystem.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace fe {
+
+// Default number of entities handed to a single job
+constexpr uint32_t DEFAULT_PARALLEL_CHUNK_SIZE = 1024;
+
+// Upper bound on jobs per dispatch; larger views get proportionally larger chunks
+// so we never exhaust the JobSystem's job pool.
+constexpr uint32_t MAX_PARALLEL_JOBS = 1024;
+
+// Splits the view's leading storage into chunks and runs them as jobs on the given
+// JobSystem (normally Filament's, so we share its worker threads instead of adding a pool).
+// Blocks until every chunk has finished — the call itself is the join point.
+// The callback receives (entt::entity, Components&...) and runs concurrently: it must
+// not create/destroy entities or add/remove components.
+template <typename... Components, typename Func>
+void parallelForEach(utils::JobSystem& jobSystem, entt::registry& registry, Func&& func,
+                     uint32_t chunkSize = DEFAULT_PARALLEL_CHUNK_SIZE) {
+    auto view = registry.view<Components...>();
+    const auto* leading = view.handle();
+    if (!leading || leading->empty()) return;
+
+    const auto count = static_cast<uint32_t>(leading->size());
+    const entt::entity* entities = leading->data();
+
+    chunkSize = std::max(chunkSize, 1u);
+    chunkSize = std::max(chunkSize, (count + MAX_PARALLEL_JOBS - 1) / MAX_PARALLEL_JOBS);
+
+    // Small views aren't worth the job overhead
+    if (count <= chunkSize) {
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto entity = entities[i];
+            if (view.contains(entity)) {
+                func(entity, view.template get<Components>(entity)...);
+            }
+        }
+        return;
+    }
+
+    auto* parent = jobSystem.createJob();
+    for (uint32_t start = 0; start < count; start += chunkSize) {
+        const uint32_t end = std::min(count, start + chunkSize);
+        auto* job = jobSystem.createJob(parent,
+            [&view, &func, entities, start, end](utils::JobSystem&, utils::JobSystem::Job*) {
+                for (uint32_t i = start; i < end; ++i) {
+                    const auto entity = entities[i];
+                    // The leading pool may hold entities that miss other components
+                    if (view.contains(entity)) {
+                        func(entity, view.template get<Components>(entity)...);
+                    }
+                }
+            });
+        jobSystem.run(job);
+    }
+    jobSystem.runAndWait(parent);
+}
+
+// Runs body(begin, end) over [0, count) in chunks on the JobSystem and waits for all of
+// them; runs inline without a JobSystem or when the range fits in one chunk. The body runs
+// concurrently for disjoint ranges.
+template <typename Body>
+void parallelFor(utils::JobSystem* jobSystem, uint32_t count, uint32_t chunkSize, Body&& body) {
+    chunkSize = std::max(chunkSize, 1u);
+    chunkSize = std::max(chunkSize, (count + MAX_PARALLEL_JOBS - 1) / MAX_PARALLEL_JOBS);
+    if (!jobSystem || count <= chunkSize) {
+        if (count > 0) body(0u, count);
+        return;
+    }
+
+    auto* parent = jobSystem->createJob();
+    for (uint32_t start = 0; start < count; start += chunkSize) {
+        const uint32_t end = std::min(count, start + chunkSize);
+        auto* job = jobSystem->createJob(parent,
+            [&body, start, end](utils::JobSystem&, utils::JobSystem::Job*) { body(start, end); });
+        jobSystem->run(job);
+    }
+    jobSystem->runAndWait(parent);
+}
+
+} // namespace fe
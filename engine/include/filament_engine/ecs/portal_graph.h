@@ -0,0 +1,96 @@
+#pragma once
+
+#include <filament_engine/math/dynamic_bvh.h>
+#include <filament_engine/math/frustum.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fe {
+
+// Cells (convex rooms, as world boxes) joined by portals (world-space quads) for indoor
+// visibility. computeVisibility() flood-fills from the camera's cell through open portals,
+// narrowing the view to each portal's screen rectangle, so only cells seen through a chain
+// of openings are reported visible, each with the sub-frustum it is seen through.
+// An optional baked PVS (potentially visible set) prunes the flood fill: portals into cells
+// outside the camera cell's row are not walked.
+class PortalGraph {
+public:
+    static constexpr uint32_t NO_CELL = UINT32_MAX;
+
+    // Drops cells and portals. A baked PVS is kept and applies again once the same layout
+    // is rebuilt (see hasPvs).
+    void clear();
+
+    uint32_t addCell(const Aabb& bounds);
+
+    // Corners go around the opening. Closed portals block the flood fill but still count
+    // as open for the PVS bake, so doors can be toggled without re-baking.
+    void addPortal(uint32_t cellA, uint32_t cellB, const Vec3 (&corners)[4], bool open = true);
+
+    size_t getCellCount() const { return m_cells.size(); }
+    size_t getPortalCount() const { return m_portals.size(); }
+    const Aabb& getCellBounds(uint32_t cell) const { return m_cells[cell].bounds; }
+
+    // First cell containing the point, or NO_CELL
+    uint32_t findCell(const Vec3& point) const;
+
+    // Marks the cells visible from `cameraCell` by walking the open portals, skipping cells
+    // the baked PVS (if any) rules out.
+    void computeVisibility(const Mat4& viewProjection, uint32_t cameraCell);
+
+    bool isCellVisible(uint32_t cell) const { return m_cells[cell].visiblePass == m_pass; }
+    const Frustum& getCellFrustum(uint32_t cell) const { return m_cells[cell].frustum; }
+    size_t getVisibleCellCount() const { return m_visibleCount; }
+
+    // Bakes, for every cell, the cells reached from a grid of samplesPerAxis^3 points inside
+    // it looking along all six axes. Sampled, so thin slivers of view can be missed.
+    void bakePvs(uint32_t samplesPerAxis = 3);
+    bool hasPvs() const { return !m_pvs.empty() && m_pvsLayout == m_layout; }
+    void clearPvs() { m_pvs.clear(); }
+    bool isPotentiallyVisible(uint32_t from, uint32_t to) const {
+        return (m_pvs[from * m_pvsWords + to / 64] >> (to % 64)) & 1;
+    }
+
+private:
+    // Screen rectangle in NDC
+    struct Rect {
+        float x0, y0, x1, y1;
+    };
+
+    struct Cell {
+        Aabb bounds;
+        Rect rect;
+        Frustum frustum;
+        std::vector<uint32_t> portals; // indices into m_portals
+        uint32_t visiblePass = 0;
+    };
+
+    struct Portal {
+        Vec3 corners[4];
+        uint32_t cells[2];
+        bool open;
+    };
+
+    // pvsRow: bits of the cells that may be entered, or nullptr for all of them
+    void floodFill(const Mat4& viewProjection, uint32_t cameraCell, bool openAll, const uint64_t* pvsRow);
+    bool projectPortal(const Portal& portal, const Mat4& viewProjection, Rect& rect) const;
+    void hashLayout(const void* data, size_t size);
+
+    static constexpr uint64_t EMPTY_LAYOUT = 14695981039346656037ull; // FNV-1a offset basis
+
+    std::vector<Cell> m_cells;
+    std::vector<Portal> m_portals;
+    DynamicBvh m_cellTree;
+    std::vector<uint32_t> m_stack; // scratch: cells whose rectangle grew
+    uint32_t m_pass = 0;
+    size_t m_visibleCount = 0;
+
+    uint64_t m_layout = EMPTY_LAYOUT; // hash of the cells and portal geometry
+    std::vector<uint64_t> m_pvs;      // cell count rows of m_pvsWords bits
+    uint32_t m_pvsWords = 0;
+    uint64_t m_pvsLayout = 0;
+};
+
+} // namespace fe
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <filament_engine/core/name.h>
+
+#include <entt/entt.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace fe {
+
+// Prefab — a reusable entity template: a small tree of nodes (node 0 is the root), each
+// with a name and a set of component values. World::instantiate() stamps out many copies
+// at once: entities are bulk-created per node and each component is inserted for all
+// copies with a single range insert. Resource handles (mesh, material) are stored by value,
+// so spawning does no lookups.
+//
+// Usage:
+//   fe::Prefab crate("Crate");
+//   crate.set(fe::MeshRendererComponent{meshHandle, materialHandle});
+//   auto lid = crate.addChild(fe::Prefab::ROOT, "Lid");
+//   crate.set(lid, fe::TransformComponent{{0, 0.5f, 0}});
+//   world.instantiate(crate, 1000, transforms);
+class Prefab {
+public:
+    static constexpr uint32_t ROOT = 0;
+
+    explicit Prefab(std::string_view rootName = "Entity");
+
+    // Adds a child node under `parent` and returns its index
+    uint32_t addChild(uint32_t parent, std::string_view name = "Entity");
+
+    // Sets the value of component T on a node (replaces a previous value of the same type)
+    template <typename T>
+    Prefab& set(uint32_t node, T value) {
+        auto& components = m_nodes[node].components;
+        const auto type = entt::type_hash<T>::value();
+        for (auto& component : components) {
+            if (component->type == type) {
+                static_cast<TypedComponent<T>&>(*component).value = std::move(value);
+                return *this;
+            }
+        }
+        components.push_back(std::make_unique<TypedComponent<T>>(type, std::move(value)));
+        return *this;
+    }
+
+    template <typename T>
+    Prefab& set(T value) {
+        return set(ROOT, std::move(value));
+    }
+
+    template <typename T>
+    const T* get(uint32_t node = ROOT) const {
+        const auto type = entt::type_hash<T>::value();
+        for (const auto& component : m_nodes[node].components) {
+            if (component->type == type) {
+                return &static_cast<const TypedComponent<T>&>(*component).value;
+            }
+        }
+        return nullptr;
+    }
+
+    size_t getNodeCount() const { return m_nodes.size(); }
+    Name getName(uint32_t node) const { return m_nodes[node].name; }
+    uint32_t getParent(uint32_t node) const { return m_nodes[node].parent; } // ROOT's parent is itself
+
+    // Writes a node's component values to every entity in `entities`: one range insert per
+    // component type, or a replace loop when the entities already carry that component.
+    void applyComponents(uint32_t node, entt::registry& registry, std::span<const entt::entity> entities) const;
+
+private:
+    struct Component {
+        explicit Component(entt::id_type t) : type(t) {}
+        virtual ~Component() = default;
+        virtual void apply(entt::registry& registry, std::span<const entt::entity> entities) const = 0;
+
+        entt::id_type type;
+    };
+
+    template <typename T>
+    struct TypedComponent final : Component {
+        TypedComponent(entt::id_type t, T v) : Component(t), value(std::move(v)) {}
+
+        void apply(entt::registry& registry, std::span<const entt::entity> entities) const override {
+            if (entities.empty()) return;
+            if (registry.storage<T>().contains(entities.front())) {
+                for (auto entity : entities) {
+                    registry.replace<T>(entity, value);
+                }
+            } else {
+                registry.insert<T>(entities.begin(), entities.end(), value);
+            }
+        }
+
+        T value;
+    };
+
+    struct Node {
+        Name name;
+        uint32_t parent = ROOT;
+        std::vector<std::unique_ptr<Component>> components;
+    };
+
+    std::vector<Node> m_nodes;
+};
+
+} // namespace fe
@@ -1,18 +1,29 @@
 #pragma once
 
+#include <filament_engine/ecs/world.h>
+
 #include <entt/entt.hpp>
 
+#include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace fe {
 
-class World;
-class Entity;
+class Scene;
+
+// Stored on every entity that belongs to a Scene.
+// `index` is the entity's slot in the scene's dense member list, which makes
+// membership tests and removal O(1) (swap-and-pop).
+struct SceneMembershipComponent {
+    Scene* scene = nullptr;
+    uint32_t index = 0;
+};
 
 // Scene — a logical group of entities for batch operations (load/unload).
 // Each scene tracks which entities belong to it. Destroying a scene
-// destroys all its entities.
+// destroys all its entities. An entity belongs to at most one scene.
 class Scene {
 public:
     Scene(World& world, const std::string& name);
@@ -21,22 +32,59 @@ public:
     // Create an entity that belongs to this scene
     Entity createEntity(const std::string& name = "Entity");
 
+    // Bulk creation (see World::createEntities); handles valid until the next bulk call on the world
+    std::span<const entt::entity> createEntities(size_t count, Name name = "Entity");
+
+    // Move an existing entity into this scene (it leaves its previous scene, if any)
+    void addEntity(entt::entity entity);
+
+    // Remove an entity from this scene without destroying it
+    void removeEntity(entt::entity entity);
+
     // Destroy a specific entity from this scene
     void destroyEntity(Entity entity);
 
     // Destroy all entities in this scene
     void destroyAll();
 
+    // Iterate members that have all of Components — callback receives (Entity, Components&...).
+    // Walks whichever is smaller: the member list or the component view.
+    // No structural changes to the scene from inside the callback.
+    template <typename... Components, typename Func>
+    void forEach(Func&& func) {
+        auto& registry = m_world.getRegistry();
+        auto view = registry.view<SceneMembershipComponent, Components...>();
+        if (m_entities.size() <= view.size_hint()) {
+            for (auto entity : m_entities) {
+                if (registry.template all_of<Components...>(entity)) {
+                    func(Entity(entity, &m_world), registry.template get<Components>(entity)...);
+                }
+            }
+        } else {
+            for (auto entity : view) {
+                if (view.template get<SceneMembershipComponent>(entity).scene != this) continue;
+                func(Entity(entity, &m_world), view.template get<Components>(entity)...);
+            }
+        }
+    }
+
     // Query
     const std::string& getName() const { return m_name; }
-    const std::vector<entt::entity>& getEntities() const { return m_entities; }
+    const std::vector<entt::entity>& getEntities() const { return m_entities; } // unordered
     size_t getEntityCount() const { return m_entities.size(); }
     bool contains(entt::entity entity) const;
 
+    // Keeps member lists consistent when a member is destroyed outside its scene.
+    // Connected once per registry to on_destroy<SceneMembershipComponent> (done by World).
+    static void onMembershipDestroyed(entt::registry& registry, entt::entity entity);
+
 private:
+    void unlinkMember(uint32_t index);
+
     World& m_world;
     std::string m_name;
-    std::vector<entt::entity> m_entities;
+    std::vector<entt::entity> m_entities; // dense member list, indexed by SceneMembershipComponent::index
+    bool m_clearing = false;
 };
 
 } // namespace fe
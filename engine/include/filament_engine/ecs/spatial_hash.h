@@ -0,0 +1,186 @@
+#pragma once
+
+#include <filament_engine/math/types.h>
+#include <filament_engine/ecs/parallel_for_each.h>
+
+#include <entt/entt.hpp>
+#include <utils/JobSystem.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace fe {
+
+// Uniform grid over points, rebuilt from scratch every frame (no per-object upkeep).
+// Cells are hashed into a table of 2x the point count; build() is a counting sort by bucket,
+// so each bucket's points end up contiguous in the sorted arrays. Neighbor queries walk
+// the buckets of the cells around a point and scan those ranges linearly. Buckets shared
+// by several cells (hash collisions) only cost extra distance tests.
+//
+// Points are addressed by their index in the sorted order: getEntity(i) / getPosition(i).
+class SpatialHash {
+public:
+    // Edge length of a grid cell; queries are cheapest with a radius around one cell
+    void setCellSize(float cellSize) { m_cellSize = std::max(cellSize, 1e-3f); }
+    float getCellSize() const { return m_cellSize; }
+
+    // Rebuilds the grid. Key computation and the gather into sorted order run on the
+    // JobSystem when one is given; the histogram and scatter stay serial, so the layout
+    // is deterministic.
+    void build(std::span<const entt::entity> entities, std::span<const Vec3> positions,
+               utils::JobSystem* jobSystem = nullptr);
+
+    void clear();
+
+    size_t size() const { return m_entities.size(); }
+    entt::entity getEntity(uint32_t index) const { return m_entities[index]; }
+    const Vec3& getPosition(uint32_t index) const { return m_positions[index]; }
+    std::span<const entt::entity> getEntities() const { return m_entities; }
+
+    // Visits every point within `radius` of `point`: func(index, distanceSq)
+    template <typename Func>
+    void forEachInRadius(const Vec3& point, float radius, Func&& func) const {
+        if (m_entities.empty()) return;
+        BucketList buckets;
+        gatherBuckets(cellOf(point), reach(radius), buckets);
+        const float radiusSq = radius * radius;
+        for (uint32_t b = 0; b < buckets.size(); ++b) {
+            const uint32_t bucket = buckets[b];
+            for (uint32_t j = m_bucketStart[bucket]; j < m_bucketStart[bucket + 1]; ++j) {
+                const Vec3 d = m_positions[j] - point;
+                const float distanceSq = dot(d, d);
+                if (distanceSq <= radiusSq) func(j, distanceSq);
+            }
+        }
+    }
+
+    // Batched query: for every indexed point i, visits each other point j within `radius`:
+    // func(i, j, distanceSq). Points are processed in sorted order, so consecutive queries
+    // reuse the same cell ranges while they are still in cache.
+    template <typename Func>
+    void forEachNeighbor(float radius, Func&& func) const {
+        visitNeighbors(0, static_cast<uint32_t>(m_entities.size()), radius, func);
+    }
+
+    // Same, split into chunks of sorted points on the JobSystem. func runs concurrently for
+    // different i and must only write state owned by i. Blocks until every chunk is done.
+    template <typename Func>
+    void forEachNeighborParallel(utils::JobSystem* jobSystem, float radius, Func&& func,
+                                 uint32_t chunkSize = 1024) const {
+        const auto count = static_cast<uint32_t>(m_entities.size());
+        parallelFor(jobSystem, count, chunkSize, [this, radius, &func](uint32_t begin, uint32_t end) {
+            visitNeighbors(begin, end, radius, func);
+        });
+    }
+
+private:
+    struct Cell {
+        int32_t x, y, z;
+        bool operator==(const Cell& other) const { return x == other.x && y == other.y && z == other.z; }
+    };
+
+    // Distinct buckets of a query's cell block: inline storage for the common 3x3x3 case
+    class BucketList {
+    public:
+        void add(uint32_t bucket) {
+            const uint32_t* begin = data();
+            if (std::find(begin, begin + m_size, bucket) != begin + m_size) return;
+            if (m_size < FIXED) m_fixed[m_size] = bucket;
+            else {
+                if (m_size == FIXED) m_overflow.assign(m_fixed, m_fixed + FIXED);
+                m_overflow.push_back(bucket);
+            }
+            ++m_size;
+        }
+        void clear() { m_size = 0; m_overflow.clear(); }
+        uint32_t size() const { return m_size; }
+        uint32_t operator[](uint32_t i) const { return data()[i]; }
+
+    private:
+        const uint32_t* data() const { return m_size > FIXED ? m_overflow.data() : m_fixed; }
+
+        static constexpr uint32_t FIXED = 32;
+        uint32_t m_fixed[FIXED];
+        std::vector<uint32_t> m_overflow;
+        uint32_t m_size = 0;
+    };
+
+    Cell cellOf(const Vec3& p) const {
+        const float inv = 1.0f / m_cellSize;
+        return {static_cast<int32_t>(std::floor(p.x * inv)),
+                static_cast<int32_t>(std::floor(p.y * inv)),
+                static_cast<int32_t>(std::floor(p.z * inv))};
+    }
+
+    uint32_t bucketOf(const Cell& cell) const {
+        // Prime-multiply mix plus a finalizer: planar layouts (y = const) otherwise collide a lot
+        uint32_t h = static_cast<uint32_t>(cell.x) * 0x8da6b343u ^
+                     static_cast<uint32_t>(cell.y) * 0xd8163841u ^
+                     static_cast<uint32_t>(cell.z) * 0xcb1ab31fu;
+        h ^= h >> 16;
+        h *= 0x7feb352du;
+        h ^= h >> 15;
+        return h & m_bucketMask;
+    }
+
+    // Cells to search on each side of the point's cell
+    int32_t reach(float radius) const {
+        return std::max(1, static_cast<int32_t>(std::ceil(radius / m_cellSize)));
+    }
+
+    void gatherBuckets(const Cell& center, int32_t reach, BucketList& buckets) const {
+        buckets.clear();
+        for (int32_t z = center.z - reach; z <= center.z + reach; ++z) {
+            for (int32_t y = center.y - reach; y <= center.y + reach; ++y) {
+                for (int32_t x = center.x - reach; x <= center.x + reach; ++x) {
+                    const uint32_t bucket = bucketOf({x, y, z});
+                    if (m_bucketStart[bucket] != m_bucketStart[bucket + 1]) buckets.add(bucket);
+                }
+            }
+        }
+    }
+
+    // Consecutive points usually share a cell (sorted order), so its bucket list is reused
+    template <typename Func>
+    void visitNeighbors(uint32_t begin, uint32_t end, float radius, Func& func) const {
+        const float radiusSq = radius * radius;
+        const int32_t cellReach = reach(radius);
+        BucketList buckets;
+        Cell lastCell{0, 0, 0};
+        bool haveCell = false;
+
+        for (uint32_t i = begin; i < end; ++i) {
+            const Vec3 p = m_positions[i];
+            const Cell cell = cellOf(p);
+            if (!haveCell || !(cell == lastCell)) {
+                gatherBuckets(cell, cellReach, buckets);
+                lastCell = cell;
+                haveCell = true;
+            }
+
+            for (uint32_t b = 0; b < buckets.size(); ++b) {
+                const uint32_t bucket = buckets[b];
+                for (uint32_t j = m_bucketStart[bucket]; j < m_bucketStart[bucket + 1]; ++j) {
+                    const Vec3 d = m_positions[j] - p;
+                    const float distanceSq = dot(d, d);
+                    if (distanceSq <= radiusSq && j != i) func(i, j, distanceSq);
+                }
+            }
+        }
+    }
+
+    float m_cellSize = 1.0f;
+    uint32_t m_bucketMask = 0;
+    std::vector<uint32_t> m_bucketStart;   // bucket b holds sorted points [start[b], start[b + 1])
+    std::vector<entt::entity> m_entities;  // sorted by bucket
+    std::vector<Vec3> m_positions;         // sorted by bucket
+    std::vector<uint32_t> m_keys;          // scratch: bucket of each input point
+    std::vector<uint32_t> m_order;         // scratch: input index of each sorted point
+    std::vector<uint32_t> m_cursor;        // scratch: next free slot per bucket
+};
+
+} // namespace fe
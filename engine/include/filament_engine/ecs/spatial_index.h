@@ -0,0 +1,69 @@
+#pragma once
+
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/ecs/change_tracker.h>
+#include <filament_engine/math/dynamic_bvh.h>
+
+#include <entt/entt.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace fe {
+
+// Closest hit of World::raycast
+struct RaycastHit {
+    entt::entity entity{entt::null};
+    float distance = 0.0f; // along the normalized ray direction
+    Vec3 point{0, 0, 0};
+};
+
+// Broad-phase index over renderable entities, backing World::raycast / overlapSphere / overlapBox.
+// Every entity with a MeshRendererComponent whose mesh is loaded has a proxy in a DynamicBvh,
+// holding its mesh bounding box transformed by the cached world matrix. Proxies follow
+// WorldTransformComponent and MeshRendererComponent changes through the ChangeTracker and are
+// dropped by the MeshRendererComponent destroy signal. Hits are tested against the entity's
+// world box, not its triangles.
+class SpatialIndex {
+public:
+    SpatialIndex() = default;
+    SpatialIndex(const SpatialIndex&) = delete;
+    SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+    // Hooks the index into the registry's MeshRendererComponent destroy signal
+    void connect(entt::registry& registry);
+
+    // Applies changes recorded since the last call (main thread, not concurrently with queries)
+    void update(entt::registry& registry, ChangeTracker& tracker);
+
+    // Closest entity whose box the ray enters within maxDistance. `direction` need not be normalized.
+    bool raycast(const Vec3& origin, const Vec3& direction, float maxDistance, RaycastHit& hit) const;
+
+    // Appends every entity whose box touches the sphere / box to `out`
+    void overlapSphere(const Vec3& center, float radius, std::vector<entt::entity>& out) const;
+    void overlapBox(const Aabb& box, std::vector<entt::entity>& out) const;
+
+    size_t size() const { return m_tree.size(); }
+    DynamicBvh& getTree() { return m_tree; }
+    const DynamicBvh& getTree() const { return m_tree; }
+
+    // Signal handler
+    void onRendererDestroyed(entt::registry& registry, entt::entity entity);
+
+private:
+    struct Record {
+        entt::entity entity = entt::null;
+        uint32_t proxy = DynamicBvh::NULL_NODE;
+        Aabb box; // exact world box (the tree holds a fattened copy)
+    };
+
+    void refresh(entt::registry& registry, entt::entity entity);
+
+    DynamicBvh m_tree;
+    std::vector<Record> m_records;        // indexed by entity index (the proxies' user data)
+    std::vector<entt::entity> m_pending;  // renderers whose mesh is not loaded yet
+    std::vector<entt::entity> m_retry;    // scratch
+    uint64_t m_changeCursor = 0;
+};
+
+} // namespace fe
@@ -1,9 +1,90 @@
 #pragma once
 
+#include <entt/entt.hpp>
+
+#include <vector>
+
 namespace fe {
 
 class World;
 
+// Declares which components a system reads and writes.
+// The SystemScheduler runs systems with non-conflicting access concurrently.
+// Systems that never declare anything are treated as touching everything and run alone.
+//
+// Usage (in the system constructor):
+//   access.read<TransformComponent>().write<VelocityComponent>();
+//   access.mainThread(); // calls into Filament, must stay on the main thread
+//   access.mainThreadUpdate(); // only update() calls into Filament; fixedUpdate() is worker-safe
+class SystemAccess {
+public:
+    template <typename... Components>
+    SystemAccess& read() {
+        (add<Components>(m_reads), ...);
+        m_declared = true;
+        return *this;
+    }
+
+    template <typename... Components>
+    SystemAccess& write() {
+        (add<Components>(m_writes), ...);
+        m_declared = true;
+        return *this;
+    }
+
+    // Pins the system to the main thread (required for anything calling into Filament)
+    SystemAccess& mainThread() {
+        m_mainThread = true;
+        m_declared = true;
+        return *this;
+    }
+
+    // Pins only update(): fixedUpdate() stays off Filament and may run on a worker,
+    // including the pipelined simulation (see World::setPipelined)
+    SystemAccess& mainThreadUpdate() {
+        m_mainThreadUpdate = true;
+        m_declared = true;
+        return *this;
+    }
+
+    bool isDeclared() const { return m_declared; }
+    bool isMainThread() const { return m_mainThread || m_mainThreadUpdate || !m_declared; }
+    bool isMainThreadStep() const { return m_mainThread || !m_declared; }
+
+    // True if the two systems cannot safely run at the same time
+    bool conflictsWith(const SystemAccess& other) const;
+
+    // Creates the declared storages up front so concurrent views never insert pools
+    void prepare(entt::registry& registry) const;
+
+private:
+    struct ComponentAccess {
+        entt::id_type id;
+        void (*assure)(entt::registry&);
+    };
+
+    template <typename T>
+    static void add(std::vector<ComponentAccess>& list) {
+        list.push_back({entt::type_hash<T>::value(),
+                        [](entt::registry& registry) { registry.storage<T>(); }});
+    }
+
+    static bool intersects(const std::vector<ComponentAccess>& a, const std::vector<ComponentAccess>& b);
+
+    std::vector<ComponentAccess> m_reads;
+    std::vector<ComponentAccess> m_writes;
+    bool m_mainThread = false;
+    bool m_mainThreadUpdate = false;
+    bool m_declared = false;
+};
+
+// Which loop drives a system (see World::updateSystems / World::fixedUpdateSystems)
+enum class UpdateRate {
+    Variable, // update() once per rendered frame
+    Fixed,    // fixedUpdate() once per simulation step
+    Both,     // fixedUpdate() per step and update() per frame
+};
+
 // Base class for ECS systems.
 // Systems process entities with specific component combinations each frame.
 class System {
@@ -13,14 +94,25 @@ public:
     // Called once when the system is registered
     virtual void init(World& world) {}
 
-    // Called every frame
-    virtual void update(World& world, float dt) = 0;
+    // Called every frame (Variable and Both rates)
+    virtual void update(World& world, float dt) {}
+
+    // Called every simulation step with the step length (Fixed and Both rates).
+    // Without fixed stepping the Application runs one step per frame with the frame time.
+    virtual void fixedUpdate(World& world, float step) {}
 
     // Called when the system is removed or the world is destroyed
     virtual void shutdown(World& world) {}
 
     // Execution priority: lower values run first
     int priority = 0;
+
+    UpdateRate rate = UpdateRate::Variable;
+    bool runsPerFrame() const { return rate != UpdateRate::Fixed; }
+    bool runsPerStep() const { return rate != UpdateRate::Variable; }
+
+    // Component access declaration used by the scheduler
+    SystemAccess access;
 };
 
 } // namespace fe
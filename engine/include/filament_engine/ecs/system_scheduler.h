@@ -0,0 +1,51 @@
+#pragma once
+
+#include <filament_engine/ecs/system.h>
+
+#include <memory>
+#include <vector>
+
+namespace utils {
+class JobSystem;
+} // namespace utils
+
+namespace fe {
+
+// Builds a dependency graph from the systems' declared component access and
+// groups them into stages. Systems within a stage don't conflict: worker-safe
+// systems are dispatched as jobs while main-thread systems run on the caller.
+// Conflicting systems keep their relative priority order, and so do all main-thread
+// systems: one never lands in an earlier stage than a main-thread system of lower priority.
+class SystemScheduler {
+public:
+    using Stage = std::vector<System*>;
+
+    // Rebuilds the stages from a priority-sorted system list. A fixed-step schedule holds
+    // the systems that run per step and calls fixedUpdate(); otherwise the per-frame ones
+    // and update(). `workerOnly` leaves out systems pinned to the main thread, for
+    // schedules run from a worker.
+    void build(const std::vector<std::unique_ptr<System>>& systems, bool fixedStep = false,
+               bool workerOnly = false);
+
+    // Runs every stage in order. Falls back to serial execution without a job system.
+    void run(World& world, float dt, utils::JobSystem* jobSystem);
+
+    // Marks the graph for rebuilding (call when systems are added or removed)
+    void invalidate() { m_dirty = true; }
+    bool isDirty() const { return m_dirty; }
+
+    const std::vector<Stage>& getStages() const { return m_stages; }
+
+private:
+    // Whether the system must run on the calling (main) thread in this schedule
+    bool isPinned(const System& system) const {
+        return m_fixedStep ? system.access.isMainThreadStep() : system.access.isMainThread();
+    }
+
+    std::vector<Stage> m_stages;
+    bool m_dirty = true;
+    bool m_prepared = false; // declared storages created for the current graph
+    bool m_fixedStep = false;
+};
+
+} // namespace fe
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <filament_engine/ecs/system.h>
+#include <filament_engine/ecs/components.h>
+
+#include <cstdint>
 
 namespace fe {
 
@@ -8,9 +11,15 @@ namespace fe {
 // Updates projection and position/orientation from TransformComponent.
 class CameraSystem : public System {
 public:
-    CameraSystem() { priority = 300; } // runs after transform and render sync
+    CameraSystem() {
+        priority = 300; // runs after transform and render sync
+        access.read<TransformComponent, CameraComponent>().mainThread();
+    }
 
     void update(World& world, float dt) override;
+
+private:
+    uint64_t m_changeCursor = 0;
 };
 
 } // namespace fe
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <filament_engine/ecs/system.h>
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/ecs/entity_bridge.h>
+#include <filament_engine/ecs/portal_graph.h>
+#include <filament_engine/math/frustum.h>
+#include <filament_engine/math/occlusion_buffer.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace fe {
+
+// Per-frame culling counters
+struct CullingStats {
+    uint32_t groups = 0;             // hierarchy subtrees tested
+    uint32_t visibleGroups = 0;
+    uint32_t renderables = 0;
+    uint32_t visibleRenderables = 0; // left in the scene (Filament still culls these per renderable)
+    uint32_t culledRenderables = 0;  // taken out of the scene (frustum or occlusion)
+    uint32_t visibleCells = 0;       // cells seen from the camera's cell (0 outside every cell)
+    uint32_t cellCulledRenderables = 0; // in the frustum but in a cell not seen through the portals
+    uint32_t occluders = 0;          // occluder meshes rasterized
+    uint32_t occludedRenderables = 0; // in the frustum but hidden behind occluders
+
+    // Share of renderables kept out of the scene
+    float culledRatio() const {
+        return renderables ? static_cast<float>(culledRenderables) / static_cast<float>(renderables) : 0.0f;
+    }
+};
+
+// Keeps BoundsComponent::world current and runs a coarse frustum cull on the engine side.
+// Renderables are grouped by hierarchy root; a group whose merged box lies more than
+// `margin` outside the active camera's frustum is removed from the filament::Scene as a
+// whole and added back once it comes into range. With the camera inside a
+// VisibilityCellComponent, renderables in cells not seen through the portals are dropped
+// next (see PortalGraph). Renderables that pass are then tested against a CPU depth buffer of the OccluderComponent meshes in view (rasterized in bands on
+// the JobSystem) and removed while hidden behind them. Instanced and static batches take
+// part through their cull records (BatchBoundsComponent), each tested as one renderable.
+// Fine per-renderable culling (including shadow passes) is left to Filament.
+class CullingSystem : public System {
+public:
+    CullingSystem() {
+        priority = 350; // runs after the camera has been placed
+        access.read<WorldTransformComponent, HierarchyComponent, FilamentEntityComponent,
+                    OccluderComponent, MeshRendererComponent, PortalComponent, BatchBoundsComponent>()
+              .write<BoundsComponent, VisibilityCellComponent>().mainThread();
+        m_occlusion.resize(320, 192);
+    }
+
+    void init(World& world) override;
+    void update(World& world, float dt) override;
+    void shutdown(World& world) override;
+
+    // Disabling puts every culled renderable back into the scene on the next update
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    // How far (world units) a group must be outside the frustum before it is removed
+    void setMargin(float margin) { m_margin = margin; }
+    float getMargin() const { return m_margin; }
+
+    // Bakes the cell-to-cell PVS of the current cells and portals. Until the layout changes
+    // (doors may toggle), the flood fill through the portals skips cells outside it.
+    void bakePvs(World& world, uint32_t samplesPerAxis = 3);
+    const PortalGraph& getPortalGraph() const { return m_cells; }
+
+    // Occlusion against OccluderComponent meshes (skipped while there are none in view)
+    void setOcclusionEnabled(bool enabled) { m_occlusionEnabled = enabled; }
+    bool isOcclusionEnabled() const { return m_occlusionEnabled; }
+
+    // Depth buffer size in pixels, rounded up to 8x8 tiles
+    void setOcclusionResolution(uint32_t width, uint32_t height) { m_occlusion.resize(width, height); }
+    const OcclusionBuffer& getOcclusionBuffer() const { return m_occlusion; }
+
+    const CullingStats& getStats() const { return m_stats; }
+
+private:
+    void updateWorldBounds(World& world);
+    void rebuildGroups(World& world);
+    void restoreAll(World& world);
+    void rebuildCells(World& world);
+    uint32_t findCell(const entt::registry& registry, entt::entity entity, const BoundsComponent& bounds) const;
+    uint32_t cullByCells(World& world, const Mat4& viewProjection, const Vec3& eye);
+    bool rasterizeOccluders(World& world, const Mat4& viewProjection, const Frustum& frustum);
+    uint32_t cullOccluded(World& world);
+    void onBoundsDestroyed(entt::registry&, entt::entity) { m_groupsDirty = true; }
+    void onCellDestroyed(entt::registry&, entt::entity) { m_cellsDirty = true; }
+
+    std::vector<std::pair<entt::entity, entt::entity>> m_members; // (root, renderable), sorted by root
+    std::vector<uint32_t> m_groupStart;                           // first member of each group (+ end)
+    AabbSoA m_groupBounds;
+    std::vector<uint8_t> m_visible;                               // per group
+    std::vector<uint8_t> m_memberVisible;                         // per member
+    PortalGraph m_cells;
+    OcclusionBuffer m_occlusion;
+    std::vector<utils::Entity> m_toAdd;
+    std::vector<utils::Entity> m_toRemove;
+    CullingStats m_stats;
+    uint64_t m_changeCursor = 0;
+    float m_margin = 1.0f;
+    bool m_enabled = true;
+    bool m_occlusionEnabled = true;
+    bool m_groupsDirty = true;  // membership changed: re-sort by root
+    bool m_boundsDirty = true;  // some world box changed: re-merge group boxes
+    bool m_cellsDirty = true;   // a cell or portal changed: rebuild the graph
+};
+
+} // namespace fe
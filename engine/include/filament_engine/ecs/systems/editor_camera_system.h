@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filament_engine/ecs/system.h>
+#include <filament_engine/ecs/components.h>
 
 namespace fe {
 
@@ -19,7 +20,11 @@ class Input;
 //   "EditorSpeed"     — Scroll wheel (Axis1D)
 class EditorCameraSystem : public System {
 public:
-    EditorCameraSystem() { priority = 290; } // runs before CameraSystem (300)
+    EditorCameraSystem() {
+        priority = 290; // runs before CameraSystem (300)
+        // Main thread: patching transforms fires the registry's update signals
+        access.read<CameraComponent>().write<TransformComponent>().mainThread();
+    }
 
     void init(World& world) override;
     void update(World& world, float dt) override;
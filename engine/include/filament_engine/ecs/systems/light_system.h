@@ -1,16 +1,41 @@
 #pragma once
 
 #include <filament_engine/ecs/system.h>
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/ecs/entity_bridge.h>
+#include <filament_engine/ecs/light_budget.h>
+
+#include <cstdint>
+#include <vector>
 
 namespace fe {
 
 // Syncs LightComponent to Filament's LightManager.
-// Creates Filament lights when components are first seen, and updates them.
+// Creates Filament lights when components are first seen, and pushes parameter and
+// world-transform updates only for lights that changed since the last frame.
+// Every frame the LightBudget ranks the lights against the active camera: only the top
+// ones stay in the scene, and the limited shadow slots go to the best shadow casters.
 class LightSystem : public System {
 public:
-    LightSystem() { priority = 250; } // runs after render sync, before camera
+    LightSystem() {
+        priority = 250; // runs after render sync, before camera
+        access.read<WorldTransformComponent, FilamentEntityComponent>().write<LightComponent>().mainThread();
+    }
 
     void update(World& world, float dt) override;
+
+    // Budget settings and the set chosen last frame (getActiveLights/getShadowCasters/getStats)
+    LightBudget& getBudget() { return m_budget; }
+    const LightBudget& getBudget() const { return m_budget; }
+
+private:
+    void applyBudget(World& world);
+
+    LightBudget m_budget;
+    std::vector<LightCandidate> m_candidates;
+    std::vector<utils::Entity> m_toAdd;
+    std::vector<utils::Entity> m_toRemove;
+    uint64_t m_changeCursor = 0;
 };
 
 } // namespace fe
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <filament_engine/ecs/system.h>
+#include <filament_engine/ecs/components.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace fe {
+
+// Picks a level for every LODGroupComponent from its projected screen size and writes the
+// level's mesh into MeshRendererComponent::mesh; RenderSyncSystem then swaps the geometry.
+// Selection runs in parallel over all groups on the JobSystem; only groups whose level
+// changed are touched afterwards. Uses the active camera as placed last frame (this runs
+// before RenderSyncSystem so the swap lands in the same frame). Entities merged into a
+// static batch keep the mesh they were batched with.
+class LODSystem : public System {
+public:
+    LODSystem() {
+        priority = 180; // after transform sync, before render sync
+        access.read<WorldTransformComponent, StaticComponent>()
+              .write<LODGroupComponent, MeshRendererComponent>().mainThread();
+    }
+
+    void update(World& world, float dt) override;
+
+    // Projected height of a bounding sphere as a fraction of the viewport height, for a
+    // perspective projection whose [1][1] element is `projectionScale` (cot(fov / 2))
+    static float screenSize(float radius, float distance, float projectionScale);
+
+    // Level for `screenSize`, switching away from `current` only once the size is past the
+    // threshold by the group's hysteresis
+    static uint32_t selectLevel(const LODGroupComponent& group, float screenSize, uint32_t current);
+
+    uint32_t getSwitchCount() const { return m_switchCount; } // level changes last frame
+
+private:
+    void resolveBounds(World& world);
+
+    std::vector<entt::entity> m_unresolved; // groups whose first mesh is not loaded yet
+    std::vector<entt::entity> m_switched;   // filled concurrently, sized to the group count
+    std::atomic<uint32_t> m_switchedCount{0};
+    uint32_t m_switchCount = 0;
+    uint64_t m_changeCursor = 0;
+};
+
+} // namespace fe
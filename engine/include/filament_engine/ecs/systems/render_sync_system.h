@@ -1,16 +1,51 @@
 #pragma once
 
 #include <filament_engine/ecs/system.h>
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/ecs/entity_bridge.h>
+#include <filament_engine/ecs/instance_batcher.h>
+
+#include <cstdint>
+#include <vector>
 
 namespace fe {
 
 // Syncs MeshRendererComponent to Filament's RenderableManager.
 // Creates Filament renderables when components are added, removes them when destroyed.
+// Only renderers reported by the ChangeTracker are examined; ones whose mesh or material
+// is not available yet are retried on later frames. Renderers that share mesh, material
+// and shadow flags are instanced through the InstanceBatcher once there are enough of them.
+// MaterialOverrideComponents resolve to pooled material instances; changing one rebuilds
+// the renderer. Changing the mesh of a built renderer swaps the geometry of its own
+// renderable in place, or moves an instanced renderer to its new mesh's batch.
 class RenderSyncSystem : public System {
 public:
-    RenderSyncSystem() { priority = 200; } // runs after transform sync
+    RenderSyncSystem() {
+        priority = 200; // runs after transform sync
+        access.write<MeshRendererComponent, BoundsComponent, MaterialOverrideComponent>()
+              .write<FilamentEntityComponent, BatchBoundsComponent>() // batch cull records
+              .read<WorldTransformComponent>().mainThread();
+    }
 
+    void init(World& world) override;
     void update(World& world, float dt) override;
+    void shutdown(World& world) override;
+
+    InstanceBatcher& getInstanceBatcher() { return m_batcher; }
+
+    // Signal handler (on_destroy<MaterialOverrideComponent>)
+    void onOverrideRemoved(entt::registry&, entt::entity entity) { m_overrideChanged.push_back(entity); }
+
+private:
+    void buildPending(World& world);
+    void teardown(World& world, entt::entity entity);
+    bool swapGeometry(World& world, entt::entity entity);
+
+    InstanceBatcher m_batcher;
+    std::vector<entt::entity> m_pending;         // renderers waiting for their mesh/material
+    std::vector<entt::entity> m_overrideChanged; // renderers whose material instance changed
+    std::vector<entt::entity> m_meshChanged;     // built renderers whose mesh handle changed
+    uint64_t m_changeCursor = 0;
 };
 
 } // namespace fe
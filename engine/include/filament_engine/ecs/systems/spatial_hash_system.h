@@ -0,0 +1,35 @@
+#pragma once
+
+#include <filament_engine/ecs/system.h>
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/ecs/spatial_hash.h>
+
+#include <vector>
+
+namespace fe {
+
+// Rebuilds a SpatialHash over every entity with a SpatialHashComponent each frame, keyed on
+// the world position. Not registered by default; register it and keep the reference:
+//   auto& grid = world.registerSystem<fe::SpatialHashSystem>(2.0f);
+//   grid.getHash().forEachNeighborParallel(world.getJobSystem(), 2.0f, ...);
+// Systems with a priority above 120 see this frame's positions.
+class SpatialHashSystem : public System {
+public:
+    explicit SpatialHashSystem(float cellSize = 1.0f) {
+        priority = 120; // after TransformSyncSystem has updated world matrices
+        access.read<WorldTransformComponent, SpatialHashComponent>();
+        m_hash.setCellSize(cellSize);
+    }
+
+    void update(World& world, float dt) override;
+
+    SpatialHash& getHash() { return m_hash; }
+    const SpatialHash& getHash() const { return m_hash; }
+
+private:
+    SpatialHash m_hash;
+    std::vector<entt::entity> m_entities; // reused every frame to avoid allocations
+    std::vector<Vec3> m_positions;
+};
+
+} // namespace fe
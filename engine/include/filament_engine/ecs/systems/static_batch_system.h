@@ -0,0 +1,109 @@
+#pragma once
+
+#include <filament_engine/ecs/system.h>
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/ecs/entity_bridge.h>
+#include <filament_engine/resources/mesh.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace fe {
+
+// Merges static renderers (StaticComponent + MeshRendererComponent) into a few large
+// renderables. Renderers sharing a material instance and shadow flags within the same grid cell
+// and visibility cell (VisibilityCellComponent) are pre-transformed into world space and
+// concatenated into one vertex/index buffer. Each batch is culled as a unit through a cull
+// record (batch_bounds.h) that belongs to its visibility cell; changing the cells re-buckets
+// every member.
+// Batches are rebuilt when members join, leave, move or change their material override. Static renderers whose mesh kept
+// no CPU geometry (Mesh::create without keepCpuData) fall through to RenderSyncSystem as
+// individual renderables.
+// A changed MeshRendererComponent (mesh, material, shadow flags) sends its member through
+// claim() again, so it may move to another batch or back to RenderSyncSystem.
+class StaticBatchSystem : public System {
+public:
+    // What members of one batch share
+    struct Key {
+        uint32_t material;
+        uint32_t overrideInstance;
+        uint32_t shadowFlags;
+        IVec3 cell;
+        entt::entity visibilityCell{entt::null}; // VisibilityCellComponent entity, if any
+        bool operator==(const Key& other) const {
+            return material == other.material && overrideInstance == other.overrideInstance &&
+                   shadowFlags == other.shadowFlags && visibilityCell == other.visibilityCell &&
+                   cell.x == other.cell.x && cell.y == other.cell.y && cell.z == other.cell.z;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t h = size_t(key.material) * 0x9E3779B1u ^ size_t(key.overrideInstance) * 0x85EBCA6Bu ^
+                       key.shadowFlags ^ size_t(entt::to_integral(key.visibilityCell)) * 0xC2B2AE35u;
+            h = h * 31 + static_cast<uint32_t>(key.cell.x) * 73856093u;
+            h = h * 31 + static_cast<uint32_t>(key.cell.y) * 19349663u;
+            return h * 31 + static_cast<uint32_t>(key.cell.z) * 83492791u;
+        }
+    };
+
+    StaticBatchSystem() {
+        priority = 150; // after world matrices are final, before RenderSyncSystem claims renderers
+        access.read<WorldTransformComponent, VisibilityCellComponent>()
+              .write<MeshRendererComponent, StaticComponent, MaterialOverrideComponent>()
+              .write<FilamentEntityComponent, BoundsComponent, BatchBoundsComponent>() // batch cull records
+              .mainThread();
+    }
+
+    void init(World& world) override;
+    void update(World& world, float dt) override;
+    void shutdown(World& world) override;
+
+    // Edge length of the grid cells that bound each batch (world units)
+    void setCellSize(float size) { m_cellSize = size; }
+    float getCellSize() const { return m_cellSize; }
+
+    size_t getBatchCount() const;
+    size_t getMemberCount() const;
+
+    void connect(entt::registry& registry);
+    void disconnect(entt::registry& registry);
+
+    // Adds a renderer to the batch of `key` (claim() derives the key from its mesh bounds)
+    void insert(entt::registry& registry, entt::entity entity, const Key& key);
+
+    // Signal handlers (on_destroy of StaticComponent / MeshRendererComponent / MaterialOverrideComponent /
+    // VisibilityCellComponent). A renderer that loses its StaticComponent goes back to RenderSyncSystem.
+    void onStaticRemoved(entt::registry& registry, entt::entity entity);
+    void onMemberRemoved(entt::registry& registry, entt::entity entity);
+    void onOverrideRemoved(entt::registry& registry, entt::entity entity);
+    void onCellRemoved(entt::registry&, entt::entity) { m_cellsChanged = true; }
+
+private:
+    struct Batch {
+        Key key{};
+        std::vector<entt::entity> members;
+        Mesh mesh;                 // merged world-space geometry (GPU only)
+        utils::Entity renderable;
+        entt::entity cullRecord{entt::null}; // BatchBoundsComponent entity while the batch is built
+        bool inScene = false;
+        bool dirty = false;
+    };
+
+    void claim(World& world, entt::entity entity);
+    void remove(entt::registry& registry, entt::entity entity, StaticComponent& mobility);
+    void requeue(entt::registry& registry, entt::entity entity);
+    void rebuild(World& world, Batch& batch);
+    void releaseGeometry(World& world, Batch& batch);
+
+    std::unordered_map<Key, uint32_t, KeyHash> m_keys; // key -> batch index
+    std::vector<Batch> m_batches;
+    std::vector<entt::entity> m_pending;
+    std::vector<MeshVertex> m_vertices; // scratch: merged geometry
+    std::vector<uint32_t> m_indices;
+    uint64_t m_changeCursor = 0;
+    float m_cellSize = 64.0f;
+    bool m_cellsChanged = false; // a visibility cell was added, moved or removed
+};
+
+} // namespace fe
@@ -1,16 +1,57 @@
 #pragma once
 
 #include <filament_engine/ecs/system.h>
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/ecs/entity_bridge.h>
+
+#include <cstdint>
+#include <vector>
 
 namespace fe {
 
-// Syncs TransformComponent data from EnTT to Filament's TransformManager.
-// Uses batch transactions for performance when many transforms change.
+// Propagates changed TransformComponents through the engine-side hierarchy and
+// pushes the resulting world matrices to Filament's TransformManager.
+// Cost is proportional to the number of changed entities, not the scene size.
+// Uses batch transactions for performance when many transforms change. Static entities
+// merged by StaticBatchSystem keep their world matrix but are not pushed to Filament.
+//
+// Propagation runs every simulation step; the push to Filament runs once per frame. With
+// fixed stepping, entities that moved during the latest step are drawn between their previous
+// and current world matrix by the world's interpolation alpha. Transforms edited outside the
+// steps (e.g. in onUpdate) are pushed as is.
 class TransformSyncSystem : public System {
 public:
-    TransformSyncSystem() { priority = 100; } // runs before rendering systems
+    TransformSyncSystem() {
+        priority = 100; // runs before rendering systems
+        rate = UpdateRate::Both;
+        access.read<FilamentEntityComponent, StaticComponent>()
+            .write<TransformComponent, HierarchyComponent, WorldTransformComponent>()
+            .mainThreadUpdate(); // propagation is engine-side; only the push calls into Filament
+    }
 
+    void fixedUpdate(World& world, float step) override;
     void update(World& world, float dt) override;
+
+private:
+    // World matrices of an entity across the latest simulation step
+    struct Motion {
+        entt::entity entity;
+        Mat4 from;
+        Mat4 to;
+    };
+
+    static constexpr uint32_t NO_MOTION = UINT32_MAX;
+
+    void propagate(World& world, bool recordMotion);
+    uint32_t findMotion(entt::entity entity) const;
+
+    std::vector<entt::entity> m_dirty;   // reused every frame to avoid allocations
+    std::vector<entt::entity> m_changed;
+    std::vector<Mat4> m_previous;        // world matrix of m_changed[i] before the step
+    std::vector<entt::entity> m_pending; // changed since the last push, pushed unblended
+    std::vector<Motion> m_motions;       // pushed blended every frame until the next step
+    std::vector<uint32_t> m_motionSlot;  // by entity index: position in m_motions
+    uint64_t m_changeCursor = 0;
 };
 
 } // namespace fe
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/math/types.h>
+#include <filament_engine/math/simd_transform.h>
+
+#include <entt/entt.hpp>
+
+#include <vector>
+
+namespace fe {
+
+// Engine-side transform hierarchy.
+// Entities carry TransformComponent (local), HierarchyComponent (links) and
+// WorldTransformComponent (cached world matrix). Updates are driven by the set of
+// changed transforms: small change sets walk only the dirty subtrees, large ones
+// fall back to a single linear pass over the storages, which are kept sorted by
+// depth so parents are always visited before their children. Local TRS matrices of
+// the entities being updated are composed in SIMD batches (see composeTransforms).
+class TransformHierarchy {
+public:
+    // Reparents child under parent (entt::null detaches it to the root).
+    // Returns false if the change would create a cycle.
+    bool setParent(entt::registry& registry, entt::entity child, entt::entity parent);
+
+    // Keeps the links consistent however a HierarchyComponent goes away (destroyEntity,
+    // bulk destruction, command buffers, direct registry calls)
+    void connect(entt::registry& registry);
+
+    // Unlinks an entity that is about to be destroyed. Its children become roots.
+    // Connected to on_destroy<HierarchyComponent> by connect().
+    void onDestroy(entt::registry& registry, entt::entity entity);
+
+    // Recomputes world matrices of the given dirty entities (plus any reparented since the
+    // last update) and their descendants. Entities whose world matrix changed are appended to `changed`,
+    // and, if `previous` is given, their world matrix before the update to it, in the same order.
+    void update(entt::registry& registry, const std::vector<entt::entity>& dirty,
+                std::vector<entt::entity>& changed, std::vector<Mat4>* previous = nullptr);
+
+    // Iterate the direct children of an entity
+    template <typename Func>
+    static void forEachChild(const entt::registry& registry, entt::entity entity, Func&& func) {
+        auto child = registry.get<HierarchyComponent>(entity).firstChild;
+        while (child != entt::null) {
+            auto next = registry.get<HierarchyComponent>(child).nextSibling;
+            func(child);
+            child = next;
+        }
+    }
+
+    // Builds a local matrix from position, rotation, and scale (T * R * S)
+    static Mat4 composeLocal(const TransformComponent& transform);
+
+    // Forces a depth re-sort on the next update (swap-and-pop removals break the order)
+    void invalidateOrder() { m_orderDirty = true; }
+
+private:
+    void collectDirty(entt::registry& registry, entt::entity entity);
+    void updateSubtrees(entt::registry& registry, std::vector<entt::entity>& changed, std::vector<Mat4>* previous);
+    void updateLinear(entt::registry& registry, std::vector<entt::entity>& changed, std::vector<Mat4>* previous);
+    void recomputeOrdered(entt::registry& registry, std::vector<entt::entity>& changed, std::vector<Mat4>* previous);
+    void unlinkFromParent(entt::registry& registry, entt::entity entity, HierarchyComponent& node);
+    void setSubtreeDepth(entt::registry& registry, entt::entity entity, uint32_t depth);
+    void sortByDepth(entt::registry& registry);
+
+    std::vector<entt::entity> m_pendingDirty; // reparented/orphaned since the last update
+    std::vector<entt::entity> m_roots;        // scratch: dirty entities of the current pass
+    std::vector<entt::entity> m_stack;        // scratch: subtree traversal
+    std::vector<entt::entity> m_order;        // scratch: entities to recompute, parents first
+    TransformSoA m_soa;                       // scratch: gathered local transforms
+    std::vector<Mat4> m_locals;               // scratch: composed local matrices
+    uint32_t m_pass = 0;
+    bool m_orderDirty = true;
+};
+
+} // namespace fe
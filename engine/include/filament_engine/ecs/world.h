@@ -4,15 +4,25 @@
 #include <filament_engine/ecs/entity_bridge.h>
 #include <filament_engine/ecs/components.h>
 #include <filament_engine/ecs/system.h>
+#include <filament_engine/ecs/system_scheduler.h>
+#include <filament_engine/ecs/parallel_for_each.h>
+#include <filament_engine/ecs/transform_hierarchy.h>
+#include <filament_engine/ecs/change_tracker.h>
+#include <filament_engine/ecs/name_index.h>
+#include <filament_engine/ecs/spatial_index.h>
+#include <filament_engine/ecs/command_buffer.h>
+#include <filament_engine/ecs/prefab.h>
 #include <filament_engine/core/input.h>
 #include <filament_engine/core/input_map.h>
 
 #include <entt/entt.hpp>
 
 #include <memory>
+#include <span>
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <functional>
 
@@ -30,9 +40,61 @@ public:
 
     // Entity management — returns Entity handle for ergonomic API
     Entity createEntity(const std::string& name = "Entity");
+
+    // Bulk creation: fills `out` with new entities carrying the same default components as
+    // createEntity(). Storages are reserved up front, components are inserted as ranges and the
+    // Filament entities are created in one batch — use this for level loads and spawners.
+    void createEntities(std::span<entt::entity> out, Name name = "Entity");
+
+    // Same, returning the handles in a world-owned buffer valid until the next call
+    std::span<const entt::entity> createEntities(size_t count, Name name = "Entity");
     void destroyEntity(entt::entity entity);
     void destroyEntity(Entity entity);
 
+    // Stamps out `count` copies of a prefab. `rootTransforms` (empty, or one per copy) overrides
+    // the root node's TransformComponent. Returns the root entities in a world-owned buffer
+    // valid until the next call; child entities are reachable through the hierarchy.
+    std::span<const entt::entity> instantiate(const Prefab& prefab, size_t count,
+                                              std::span<const TransformComponent> rootTransforms = {});
+
+    // Bulk destruction: Filament components are destroyed grouped by manager, the entities
+    // leave the filament::Scene in one call and EnTT storages are cleared as ranges.
+    // Invalid handles are skipped; handles must not repeat.
+    void destroyEntities(std::span<const entt::entity> entities);
+
+    // Name lookup (TagComponent). findByName returns any entity with that name, or entt::null.
+    // Renames must go through patchComponent<TagComponent>() to keep the index current.
+    entt::entity findByName(std::string_view name) const;
+    std::vector<entt::entity> findAllByName(std::string_view name) const;
+
+    // Transform hierarchy — parent entt::null detaches to the root.
+    // Returns false if the change would create a cycle.
+    bool setParent(entt::entity child, entt::entity parent);
+    entt::entity getParent(entt::entity entity) const;
+
+    // Cached world matrix (valid after TransformSyncSystem has run this frame)
+    const Mat4& getWorldMatrix(entt::entity entity) const;
+
+    template <typename Func>
+    void forEachChild(entt::entity entity, Func&& func) {
+        TransformHierarchy::forEachChild(m_registry, entity,
+            [this, &func](entt::entity child) { func(Entity(child, this)); });
+    }
+
+    // Spatial queries over renderable entities (world box of each MeshRendererComponent's mesh).
+    // The index is refreshed at the end of updateSystems(); updateSpatialIndex() picks up changes
+    // made since then. Queries are read-only and safe from worker systems.
+    bool raycast(const Vec3& origin, const Vec3& direction, float maxDistance, RaycastHit& hit) const {
+        return m_spatialIndex.raycast(origin, direction, maxDistance, hit);
+    }
+    void overlapSphere(const Vec3& center, float radius, std::vector<entt::entity>& out) const {
+        m_spatialIndex.overlapSphere(center, radius, out);
+    }
+    void overlapBox(const Aabb& box, std::vector<entt::entity>& out) const {
+        m_spatialIndex.overlapBox(box, out);
+    }
+    void updateSpatialIndex() { m_spatialIndex.update(m_registry, m_changeTracker); }
+
     // Component management (also available via Entity handle)
     template <typename T, typename... Args>
     T& addComponent(entt::entity entity, Args&&... args) {
@@ -64,6 +126,25 @@ public:
         m_registry.remove<T>(entity);
     }
 
+    // Change tracking — flags a component as modified so change-driven systems pick it up.
+    // Edits made through a plain reference are invisible to the sync systems otherwise.
+    template <typename T>
+    void markChanged(entt::entity entity) {
+        m_registry.patch<T>(entity);
+    }
+
+    // Applies the given edit functions in place and flags the component as modified
+    template <typename T, typename... Func>
+    T& patchComponent(entt::entity entity, Func&&... func) {
+        return m_registry.patch<T>(entity, std::forward<Func>(func)...);
+    }
+
+    // Deferred structural changes — safe to record from worker jobs and systems.
+    // Each thread records into its own buffer; buffers are played back by flushCommands(),
+    // which updateSystems() calls before the first and after the last system stage.
+    CommandBuffer& commands() { return m_commandQueue.local(); }
+    void flushCommands() { m_commandQueue.flush(*this); }
+
     // System management
     template <typename T, typename... Args>
     T& registerSystem(Args&&... args) {
@@ -73,13 +154,43 @@ public:
         // Sort by priority
         std::sort(m_systems.begin(), m_systems.end(),
             [](const auto& a, const auto& b) { return a->priority < b->priority; });
+        m_scheduler.invalidate();
+        m_fixedScheduler.invalidate();
         ref.init(*this);
         return ref;
     }
 
+    // Runs fixedUpdate() on Fixed/Both-rate systems for one simulation step, then
+    // update() on Variable/Both-rate systems once per frame. The Application calls
+    // fixedUpdateSystems() zero or more times per frame before updateSystems().
+    void fixedUpdateSystems(float step);
     void updateSystems(float dt);
     void shutdownSystems();
 
+    // Pipelined simulation (ApplicationConfig::pipelined): fixedUpdateSystems() runs on a worker
+    // while the main thread renders. The worker owns the registry, the command buffers and
+    // the world's trackers until the join. Meanwhile the main thread touches only Filament
+    // and the DebugRenderer. Command buffers (their playback creates and destroys Filament
+    // entities) and fixed-rate systems pinned to the main thread are deferred.
+    // finishPipelinedSteps() runs them on the main thread after the join: the pinned systems
+    // once per deferred step, after all the worker's steps.
+    void setPipelined(bool enabled);
+    bool isPipelined() const { return m_pipelined; }
+    void finishPipelinedSteps();
+
+    // Set by the Application when simulation runs at a fixed rate, together with how far the
+    // frame is between the last two steps (1 = on the latest step) for interpolating systems
+    void setFixedStepping(bool enabled) { m_fixedStepping = enabled; }
+    bool isFixedStepping() const { return m_fixedStepping; }
+    void setInterpolationAlpha(float alpha) { m_interpolationAlpha = alpha; }
+    float getInterpolationAlpha() const { return m_interpolationAlpha; }
+
+    // When enabled (default), non-conflicting systems run concurrently on Filament's JobSystem
+    void setParallelSystems(bool enabled) { m_parallelSystems = enabled; }
+    bool isParallelSystems() const { return m_parallelSystems; }
+    const SystemScheduler& getScheduler() const { return m_scheduler; }
+    const SystemScheduler& getFixedScheduler() const { return m_fixedScheduler; }
+
     // Ergonomic iteration — callback receives (Entity, Components&...)
     template <typename... Components, typename Func>
     void forEach(Func&& func) {
@@ -89,6 +200,23 @@ public:
         }
     }
 
+    // Parallel iteration on Filament's JobSystem. Returns once every chunk has run.
+    // The callback runs concurrently — no structural changes (create/destroy/add/remove);
+    // record them with commands() instead.
+    template <typename... Components, typename Func>
+    void forEachParallel(Func&& func, uint32_t chunkSize = DEFAULT_PARALLEL_CHUNK_SIZE) {
+        auto* jobSystem = getJobSystem();
+        if (!jobSystem) {
+            forEach<Components...>(std::forward<Func>(func));
+            return;
+        }
+        parallelForEach<Components...>(*jobSystem, m_registry,
+            [this, &func](entt::entity entity, Components&... components) {
+                func(Entity(entity, this), components...);
+            },
+            chunkSize);
+    }
+
     // Scene management
     Scene& createScene(const std::string& name);
     Scene* getScene(const std::string& name);
@@ -98,18 +226,43 @@ public:
     entt::registry& getRegistry() { return m_registry; }
     const entt::registry& getRegistry() const { return m_registry; }
     EntityBridge& getEntityBridge() { return m_entityBridge; }
+    TransformHierarchy& getTransformHierarchy() { return m_hierarchy; }
+    ChangeTracker& getChangeTracker() { return m_changeTracker; }
+    SpatialIndex& getSpatialIndex() { return m_spatialIndex; }
     RenderContext& getRenderContext() { return m_renderContext; }
     Input& getInput() { return m_input; }
     InputMap& getInputMap() { return m_inputMap; }
+    utils::JobSystem* getJobSystem() const;
 
 private:
     entt::registry m_registry;
     EntityBridge m_entityBridge;
+    TransformHierarchy m_hierarchy;
+    ChangeTracker m_changeTracker;
+    NameIndex m_nameIndex;
+    SpatialIndex m_spatialIndex;
+    CommandQueue m_commandQueue;
     RenderContext& m_renderContext;
     Input& m_input;
     InputMap& m_inputMap;
     std::vector<std::unique_ptr<System>> m_systems;
+    SystemScheduler m_scheduler;
+    SystemScheduler m_fixedScheduler;
+    bool m_parallelSystems = true;
+    bool m_fixedStepping = false;
+    bool m_pipelined = false;
+    uint32_t m_deferredSteps = 0; // pipelined steps whose main-thread systems have not run
+    float m_deferredStep = 0.0f;
+    float m_interpolationAlpha = 1.0f;
     std::unordered_map<std::string, std::unique_ptr<Scene>> m_scenes;
+
+    // Scratch buffers for bulk creation/destruction
+    std::vector<entt::entity> m_createdEntities;
+    std::vector<utils::Entity> m_createdFilamentEntities;
+    std::vector<entt::entity> m_destroyedEntities;
+    std::vector<entt::entity> m_destroyedLinked;
+    std::vector<utils::Entity> m_destroyedFilamentEntities;
+    std::vector<entt::entity> m_instantiated; // node-major: node n of copy i at [n * count + i]
 };
 
 } // namespace fe
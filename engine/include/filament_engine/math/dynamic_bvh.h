@@ -0,0 +1,206 @@
+#pragma once
+
+#include <filament_engine/math/frustum.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fe {
+
+// Entry distance of the ray origin + t * direction into the box, clamped to [0, maxDistance].
+// Returns -1 if the ray misses the box within that range.
+float intersectRayAabb(const Vec3& origin, const Vec3& direction, const Aabb& box, float maxDistance);
+
+// True if the sphere touches the box
+bool intersectSphereAabb(const Vec3& center, float radius, const Aabb& box);
+
+// True if the boxes overlap (touching counts)
+bool intersectAabbs(const Aabb& a, const Aabb& b);
+
+// Dynamic AABB tree for broad-phase queries under frequent updates.
+// Leaves hold a "fat" box grown by `margin`, so small motions leave the tree untouched.
+// Inserts descend to the sibling with the lowest surface-area cost and rebalance the path
+// back to the root with AVL-style rotations. Moves are remove + reinsert of one leaf.
+// Queries are const and allocation-free, so concurrent readers are safe between updates.
+class DynamicBvh {
+public:
+    static constexpr uint32_t NULL_NODE = UINT32_MAX;
+
+    // Adds a box and returns its proxy id (stable until removed)
+    uint32_t insert(const Aabb& box, uint32_t userData);
+    void remove(uint32_t proxy);
+
+    // Updates a proxy's box. Returns false (no tree change) while it still fits its fat box.
+    bool move(uint32_t proxy, const Aabb& box);
+
+    uint32_t getUserData(uint32_t proxy) const { return m_nodes[proxy].userData; }
+    Aabb getFatBox(uint32_t proxy) const;
+
+    // Visits every proxy whose fat box overlaps `box`. func(proxy) returns false to stop.
+    template <typename Func>
+    void query(const Aabb& box, Func&& func) const {
+        const Vec3 lo = box.center - box.halfExtent;
+        const Vec3 hi = box.center + box.halfExtent;
+        NodeStack stack;
+        stack.push(m_root);
+        while (!stack.empty()) {
+            const uint32_t index = stack.pop();
+            if (index == NULL_NODE) continue;
+
+            const Node& node = m_nodes[index];
+            if (!overlaps(node, lo, hi)) continue;
+            if (node.isLeaf()) {
+                if (!func(index)) return;
+            } else {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    }
+
+    // Visits every proxy whose fat box touches the sphere. func(proxy) returns false to stop.
+    template <typename Func>
+    void querySphere(const Vec3& center, float radius, Func&& func) const {
+        const float radiusSq = radius * radius;
+        NodeStack stack;
+        stack.push(m_root);
+        while (!stack.empty()) {
+            const uint32_t index = stack.pop();
+            if (index == NULL_NODE) continue;
+
+            const Node& node = m_nodes[index];
+            if (distanceSq(node, center) > radiusSq) continue;
+            if (node.isLeaf()) {
+                if (!func(index)) return;
+            } else {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    }
+
+    // Visits proxies whose fat box the ray enters within maxDistance, roughly front to back.
+    // func(proxy, maxDistance) returns the new max distance: the input to keep searching,
+    // a hit distance to clip the ray (closest-hit queries), or 0 to stop.
+    template <typename Func>
+    void raycast(const Vec3& origin, const Vec3& direction, float maxDistance, Func&& func) const {
+        const Vec3 invDirection{1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z};
+        NodeStack stack;
+        stack.push(m_root);
+        while (!stack.empty() && maxDistance > 0.0f) {
+            const uint32_t index = stack.pop();
+            if (index == NULL_NODE) continue;
+
+            const Node& node = m_nodes[index];
+            if (slabEntry(node, origin, invDirection, maxDistance) < 0.0f) continue;
+            if (node.isLeaf()) {
+                maxDistance = func(index, maxDistance);
+                continue;
+            }
+
+            // Nearer child on top so closest-hit queries clip the ray early
+            const Node& a = m_nodes[node.child1];
+            const Node& b = m_nodes[node.child2];
+            const float da = dot((a.lo + a.hi) * 0.5f - origin, direction);
+            const float db = dot((b.lo + b.hi) * 0.5f - origin, direction);
+            if (da <= db) {
+                stack.push(node.child2);
+                stack.push(node.child1);
+            } else {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    }
+
+    void clear();
+
+    // Extra room (world units) added around each leaf box
+    void setMargin(float margin) { m_margin = std::max(margin, 0.0f); }
+    float getMargin() const { return m_margin; }
+
+    size_t size() const { return m_leafCount; }
+    int32_t getHeight() const { return m_root == NULL_NODE ? 0 : m_nodes[m_root].height; }
+
+    // Checks links, heights and box containment (tests and debugging)
+    bool validate() const;
+
+private:
+    struct Node {
+        Vec3 lo{0, 0, 0};
+        Vec3 hi{0, 0, 0};
+        uint32_t parent = NULL_NODE; // next free node while on the free list
+        uint32_t child1 = NULL_NODE;
+        uint32_t child2 = NULL_NODE;
+        int32_t height = 0;          // leaf = 0, free = -1
+        uint32_t userData = 0;
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    // Traversal stack: fixed storage covers any balanced tree, the vector only catches overflow
+    class NodeStack {
+    public:
+        void push(uint32_t index) {
+            if (m_size < FIXED) m_fixed[m_size] = index;
+            else m_overflow.push_back(index);
+            ++m_size;
+        }
+        uint32_t pop() {
+            --m_size;
+            if (m_size < FIXED) return m_fixed[m_size];
+            uint32_t index = m_overflow.back();
+            m_overflow.pop_back();
+            return index;
+        }
+        bool empty() const { return m_size == 0; }
+
+    private:
+        static constexpr size_t FIXED = 64;
+        uint32_t m_fixed[FIXED];
+        std::vector<uint32_t> m_overflow;
+        size_t m_size = 0;
+    };
+
+    static bool overlaps(const Node& node, const Vec3& lo, const Vec3& hi) {
+        return node.lo.x <= hi.x && node.hi.x >= lo.x &&
+               node.lo.y <= hi.y && node.hi.y >= lo.y &&
+               node.lo.z <= hi.z && node.hi.z >= lo.z;
+    }
+
+    static float distanceSq(const Node& node, const Vec3& point) {
+        const Vec3 closest = min(max(point, node.lo), node.hi);
+        const Vec3 d = closest - point;
+        return dot(d, d);
+    }
+
+    // Slab test; NaNs from 0 * inf (ray in a slab plane) drop out of the min/max
+    static float slabEntry(const Node& node, const Vec3& origin, const Vec3& invDirection, float maxDistance) {
+        float tmin = 0.0f;
+        float tmax = maxDistance;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float t1 = (node.lo[axis] - origin[axis]) * invDirection[axis];
+            const float t2 = (node.hi[axis] - origin[axis]) * invDirection[axis];
+            tmin = std::max(tmin, std::min(t1, t2));
+            tmax = std::min(tmax, std::max(t1, t2));
+        }
+        return tmin <= tmax ? tmin : -1.0f;
+    }
+
+    uint32_t allocateNode();
+    void freeNode(uint32_t index);
+    void insertLeaf(uint32_t leaf);
+    void removeLeaf(uint32_t leaf);
+    void refitFrom(uint32_t index);
+    uint32_t balance(uint32_t index);
+
+    std::vector<Node> m_nodes;
+    uint32_t m_root = NULL_NODE;
+    uint32_t m_freeList = NULL_NODE;
+    size_t m_leafCount = 0;
+    float m_margin = 0.1f;
+};
+
+} // namespace fe
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <filament_engine/math/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fe {
+
+// Axis-aligned box as center + half extent (what the culling kernels consume)
+struct Aabb {
+    Vec3 center{0, 0, 0};
+    Vec3 halfExtent{0, 0, 0};
+};
+
+// Exact AABB of a transformed box: the center goes through the matrix, the extent
+// through the absolute value of its upper 3x3 (Arvo).
+Aabb transformAabb(const Mat4& matrix, const Aabb& local);
+
+// Smallest box containing both
+Aabb mergeAabb(const Aabb& a, const Aabb& b);
+
+// Six inward-facing planes (xyz = normal, w = distance): a point p is inside when
+// dot(xyz, p) + w >= 0 for every plane.
+struct Frustum {
+    Vec4 planes[6];
+
+    // Extracts the planes from a projection * view matrix (Gribb/Hartmann).
+    // The near plane is taken as the conservative one for both [-1,1] and [0,1] clip depth.
+    static Frustum fromMatrix(const Mat4& viewProjection);
+
+    // Same, narrowed to the NDC rectangle [left, right] x [bottom, top] (e.g. a portal's
+    // screen bounds); the full view is [-1, 1] x [-1, 1].
+    static Frustum fromMatrix(const Mat4& viewProjection, float left, float right, float bottom, float top);
+
+    // True unless the box lies entirely outside one plane by more than `margin`
+    bool intersects(const Aabb& box, float margin = 0.0f) const;
+};
+
+// Flat structure-of-arrays box list for batch culling
+struct AabbSoA {
+    std::vector<float> cx, cy, cz;
+    std::vector<float> ex, ey, ez;
+
+    void clear();
+    void push(const Aabb& box);
+    size_t size() const { return cx.size(); }
+};
+
+// Tests every box against the frustum, 4 at a time with SSE2/NEON where available.
+// visible[i] is 1 if box i intersects the frustum grown by `margin`, else 0.
+// Returns the number of visible boxes.
+size_t cullAabbs(const Frustum& frustum, const AabbSoA& boxes, float margin, uint8_t* visible);
+
+} // namespace fe
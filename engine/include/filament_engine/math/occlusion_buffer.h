@@ -0,0 +1,78 @@
+#pragma once
+
+#include <filament_engine/math/frustum.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fe {
+
+// Low-resolution CPU depth buffer for software occlusion culling.
+// Occluder triangles are transformed and clipped against w > 0 once per frame, then
+// rasterized in horizontal bands of whole tiles, 4 pixels at a time with SSE2/NEON where
+// available. Each pixel keeps 1/w of the nearest occluder (0 = empty). Every 8x8 tile also
+// keeps the farthest depth it contains, a one-level hierarchical Z that decides most box
+// tests without touching pixels.
+class OcclusionBuffer {
+public:
+    static constexpr uint32_t TILE_SIZE = 8;
+    static constexpr uint32_t BAND_HEIGHT = 4 * TILE_SIZE;
+
+    // Sizes are rounded up to whole tiles
+    void resize(uint32_t width, uint32_t height);
+    uint32_t getWidth() const { return m_width; }
+    uint32_t getHeight() const { return m_height; }
+
+    // Starts a frame: drops the previous occluders and sets the projection * view matrix
+    void begin(const Mat4& viewProjection);
+
+    // Adds an occluder mesh: `vertexCount` object-space positions `stride` bytes apart and
+    // a triangle list. Both windings are rasterized.
+    void addOccluder(const Mat4& model, const float* positions, size_t stride, size_t vertexCount,
+                     const uint32_t* indices, size_t indexCount);
+
+    // Clears and rasterizes one band, then refreshes its tiles. Distinct bands touch
+    // disjoint rows and may run concurrently.
+    uint32_t getBandCount() const { return (m_height + BAND_HEIGHT - 1) / BAND_HEIGHT; }
+    void rasterizeBand(uint32_t band);
+
+    // Every band on the calling thread
+    void rasterize();
+
+    // True if the box lies entirely behind the rasterized occluders. Boxes crossing the
+    // camera plane or leaving the screen are reported visible (the frustum cull owns those).
+    bool isOccluded(const Aabb& box) const;
+
+    size_t getTriangleCount() const { return m_triangles.size(); }
+
+    // Stored 1/w of a pixel and the farthest one of a tile (tests and debug views)
+    float getDepth(uint32_t x, uint32_t y) const { return m_depth[y * m_width + x]; }
+    float getTileDepth(uint32_t tileX, uint32_t tileY) const { return m_tiles[tileY * m_tilesX + tileX]; }
+
+private:
+    // Screen-space triangle: pixel coordinates (y up) and 1/w per vertex
+    struct Triangle {
+        float x[3];
+        float y[3];
+        float z[3];
+        float minY;
+        float maxY;
+    };
+
+    void addClipped(const Vec4& a, const Vec4& b, const Vec4& c);
+    void addScreen(const Vec4& a, const Vec4& b, const Vec4& c);
+    void rasterizeTriangle(const Triangle& triangle, uint32_t rowBegin, uint32_t rowEnd);
+
+    Mat4 m_viewProjection;
+    std::vector<Triangle> m_triangles;
+    std::vector<Vec4> m_clip;   // scratch: clip-space vertices of the current occluder
+    std::vector<float> m_depth; // m_width * m_height
+    std::vector<float> m_tiles; // m_tilesX * m_tilesY
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint32_t m_tilesX = 0;
+    uint32_t m_tilesY = 0;
+};
+
+} // namespace fe
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <filament_engine/math/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fe {
+
+// Instruction sets the batch transform kernels can run on
+enum class SimdLevel : uint8_t {
+    Scalar,
+    SSE2,   // 4 transforms per iteration
+    AVX2,   // 8 transforms per iteration
+    NEON,   // 4 transforms per iteration
+};
+
+// Best level supported by the running CPU (detected once)
+SimdLevel getSimdLevel();
+bool isSimdLevelSupported(SimdLevel level);
+const char* getSimdLevelName(SimdLevel level);
+
+// Structure-of-arrays position/rotation/scale input for composeTransforms().
+// Each channel is contiguous so the kernels load one component for N entities at once.
+struct TransformSoA {
+    std::vector<float> px, py, pz;
+    std::vector<float> qx, qy, qz, qw;
+    std::vector<float> sx, sy, sz;
+
+    void resize(size_t count);
+    size_t size() const { return px.size(); }
+
+    void set(size_t index, const Vec3& position, const Quat& rotation, const Vec3& scale) {
+        px[index] = position.x; py[index] = position.y; pz[index] = position.z;
+        qx[index] = rotation.x; qy[index] = rotation.y; qz[index] = rotation.z; qw[index] = rotation.w;
+        sx[index] = scale.x; sy[index] = scale.y; sz[index] = scale.z;
+    }
+};
+
+// Composes T * R * S for every entry of `input` into out[0 .. input.size()).
+// Rotations are expected to be unit quaternions (same contract as mat3f(quat)).
+void composeTransforms(const TransformSoA& input, Mat4* out);
+
+// Same, forcing a specific kernel. `level` must be supported (used by tests/benchmarks).
+void composeTransforms(const TransformSoA& input, Mat4* out, SimdLevel level);
+
+} // namespace fe
@@ -15,6 +15,7 @@
 #include <utils/Entity.h>
 #include <utils/EntityManager.h>
 
+#include <cstdint>
 #include <string>
 
 namespace fe {
@@ -22,11 +23,15 @@ enum class GraphicsBackend {
     Vulkan,
     Metal,
     OpenGL,
+    Noop,   // No GPU work: the full CPU side of Filament runs, nothing reaches a driver
     Default // Auto-detect: Metal on macOS, Vulkan on Linux/Windows
 };
 class RenderContext {
 public:
     RenderContext(Window& window, GraphicsBackend backend = GraphicsBackend::Default);
+
+    // Headless: renders into an offscreen swap chain of the given size, no window needed
+    RenderContext(uint32_t width, uint32_t height, GraphicsBackend backend = GraphicsBackend::Noop);
     static GraphicsBackend getPlatformDefaultBackend();
     ~RenderContext();
 
@@ -47,12 +52,14 @@ public:
     filament::Camera* createCamera();
     void setActiveCamera(filament::Camera* camera);
     filament::Camera* getActiveCamera() const { return m_activeCamera; }
+    bool isHeadless() const { return m_window == nullptr; }
 
     // Loads KTX cubemaps from a directory (ibl.ktx, skybox.ktx, sh.txt)
     bool loadIBL(const std::string& iblDirectory);
 
 private:
-    void createSwapChain(Window& window);
+    void init(uint32_t width, uint32_t height, GraphicsBackend backend);
+    void createSwapChain();
 
     filament::Engine* m_engine = nullptr;
     filament::Renderer* m_renderer = nullptr;
@@ -66,7 +73,9 @@ private:
     filament::Texture* m_skyboxTexture = nullptr;
 
     utils::Entity m_cameraEntity;
-    Window& m_window;
+    Window* m_window = nullptr; // null when headless
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
 };
 
 } // namespace fe
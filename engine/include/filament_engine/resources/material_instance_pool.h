@@ -0,0 +1,68 @@
+#pragma once
+
+#include <filament_engine/resources/material_parameters.h>
+#include <filament_engine/resources/resource_handle.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace filament {
+class Engine;
+class MaterialInstance;
+} // namespace filament
+
+namespace fe {
+
+class MaterialWrapper;
+
+// Shares one filament::MaterialInstance per unique (parent material, parameter set).
+// Instances are duplicated from the parent's default instance (so parameters set on the
+// MaterialWrapper are inherited) and reference counted. Unreferenced instances are only
+// destroyed by collectGarbage(), once renderables have stopped pointing at them.
+class MaterialInstancePool {
+public:
+    explicit MaterialInstancePool(filament::Engine& engine) : m_engine(engine) {}
+    ~MaterialInstancePool();
+
+    MaterialInstancePool(const MaterialInstancePool&) = delete;
+    MaterialInstancePool& operator=(const MaterialInstancePool&) = delete;
+
+    // Returns the id (never 0) of the shared instance and adds a reference to it
+    uint32_t acquire(ResourceHandle<MaterialWrapper> parentHandle, const MaterialWrapper& parent,
+                     const MaterialParameters& parameters);
+    void release(uint32_t id);
+
+    // True if `id` is the instance for exactly this parent and parameter set
+    bool matches(uint32_t id, ResourceHandle<MaterialWrapper> parentHandle, const MaterialParameters& parameters) const;
+
+    filament::MaterialInstance* getInstance(uint32_t id) const;
+    uint32_t getRefCount(uint32_t id) const;
+
+    // Destroys unreferenced instances
+    void collectGarbage();
+    void destroyAll();
+
+    size_t size() const { return m_lookup.size(); } // live (still referenced or not yet collected)
+
+private:
+    struct Entry {
+        ResourceHandle<MaterialWrapper> parent;
+        MaterialParameters parameters;
+        size_t hash = 0;
+        filament::MaterialInstance* instance = nullptr;
+        uint32_t refCount = 0;
+    };
+
+    static size_t combine(ResourceHandle<MaterialWrapper> parent, size_t parametersHash) {
+        return parametersHash ^ (size_t(parent.getId()) * 0x9E3779B97F4A7C15ull);
+    }
+
+    filament::Engine& m_engine;
+    std::vector<Entry> m_entries;                       // indexed by id - 1
+    std::vector<uint32_t> m_freeIds;
+    std::unordered_multimap<size_t, uint32_t> m_lookup; // hash -> id
+    std::vector<uint32_t> m_unreferenced;               // candidates for collectGarbage
+};
+
+} // namespace fe
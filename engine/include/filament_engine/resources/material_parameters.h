@@ -0,0 +1,60 @@
+#pragma once
+
+#include <filament_engine/math/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace filament {
+class MaterialInstance;
+} // namespace filament
+
+namespace fe {
+
+// A small set of named float/vector material parameters, kept sorted by name so that
+// equal sets compare and hash equal regardless of the order they were set in.
+class MaterialParameters {
+public:
+    struct Parameter {
+        std::string name;
+        uint8_t size = 0; // 1 = float, 2..4 = vector
+        float value[4] = {0, 0, 0, 0};
+
+        bool operator==(const Parameter& other) const;
+    };
+
+    MaterialParameters& set(std::string_view name, float value);
+    MaterialParameters& set(std::string_view name, const Vec2& value);
+    MaterialParameters& set(std::string_view name, const Vec3& value);
+    MaterialParameters& set(std::string_view name, const Vec4& value);
+    bool remove(std::string_view name);
+    void clear() { m_parameters.clear(); }
+
+    // Common PBR parameters (same names as MaterialWrapper's setters)
+    MaterialParameters& setBaseColor(const Vec4& color) { return set("baseColor", color); }
+    MaterialParameters& setMetallic(float metallic) { return set("metallic", metallic); }
+    MaterialParameters& setRoughness(float roughness) { return set("roughness", roughness); }
+    MaterialParameters& setReflectance(float reflectance) { return set("reflectance", reflectance); }
+
+    const Parameter* find(std::string_view name) const;
+    const std::vector<Parameter>& getParameters() const { return m_parameters; }
+    bool empty() const { return m_parameters.empty(); }
+    size_t size() const { return m_parameters.size(); }
+
+    size_t hash() const;
+    bool operator==(const MaterialParameters& other) const { return m_parameters == other.m_parameters; }
+    bool operator!=(const MaterialParameters& other) const { return !(*this == other); }
+
+    // Writes every parameter to a Filament material instance
+    void applyTo(filament::MaterialInstance& instance) const;
+
+private:
+    MaterialParameters& set(std::string_view name, const float* value, uint8_t size);
+
+    std::vector<Parameter> m_parameters;
+};
+
+} // namespace fe
@@ -4,6 +4,9 @@
 
 #include <filament/Box.h>
 
+#include <cstdint>
+#include <vector>
+
 namespace filament {
 class Engine;
 class VertexBuffer;
@@ -12,6 +15,13 @@ class IndexBuffer;
 
 namespace fe {
 
+// Interleaved vertex layout shared by every engine mesh
+struct MeshVertex {
+    Vec3 position;
+    Vec3 normal;
+    Vec2 uv;
+};
+
 // Represents a renderable mesh: vertex and index buffers with a bounding box
 struct Mesh {
     filament::VertexBuffer* vertexBuffer = nullptr;
@@ -19,9 +29,18 @@ struct Mesh {
     uint32_t indexCount = 0;
     filament::Box boundingBox;
 
+    // CPU copy of the geometry, needed for static batching and occluders (empty unless kept)
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+
+    // Uploads the geometry (16-bit indices when they fit) and computes the bounding box.
+    // Pass keepCpuData = true for meshes that are statically batched or used as occluders.
+    static Mesh create(filament::Engine& engine, std::vector<MeshVertex> vertices,
+                       std::vector<uint32_t> indices, bool keepCpuData = false);
+
     // Primitive geometry constructors
-    static Mesh createCube(filament::Engine& engine, float halfExtent = 0.5f);
-    static Mesh createPlane(filament::Engine& engine, float halfExtent = 1.0f);
+    static Mesh createCube(filament::Engine& engine, float halfExtent = 0.5f, bool keepCpuData = false);
+    static Mesh createPlane(filament::Engine& engine, float halfExtent = 1.0f, bool keepCpuData = false);
 };
 
 } // namespace fe
@@ -3,6 +3,7 @@
 #include <filament_engine/resources/resource_handle.h>
 #include <filament_engine/resources/mesh.h>
 #include <filament_engine/resources/material.h>
+#include <filament_engine/resources/material_instance_pool.h>
 
 #include <unordered_map>
 #include <cstdint>
@@ -38,11 +39,15 @@ public:
     // Create material from compiled package data
     ResourceHandle<MaterialWrapper> createMaterial(const void* data, size_t size);
 
+    // Shared material instances for per-entity parameter overrides
+    MaterialInstancePool& getMaterialInstancePool() { return m_instancePool; }
+
     // Cleanup all resources
     void destroyAll();
 
 private:
     filament::Engine& m_engine;
+    MaterialInstancePool m_instancePool;
     uint32_t m_nextId = 1; // 0 is reserved for invalid
 
     std::unordered_map<uint32_t, Mesh> m_meshes;
@@ -6,6 +6,9 @@
 #include <filament_engine/ecs/systems/camera_system.h>
 #include <filament_engine/ecs/systems/light_system.h>
 #include <filament_engine/ecs/systems/editor_camera_system.h>
+#include <filament_engine/ecs/systems/culling_system.h>
+#include <filament_engine/ecs/systems/static_batch_system.h>
+#include <filament_engine/ecs/systems/lod_system.h>
 #include <filament_engine/resources/resource_manager.h>
 
 namespace fe {
@@ -22,11 +25,17 @@ void Application::run() {
         FILAMENT_ENGINE_VERSION_MINOR,
         FILAMENT_ENGINE_VERSION_PATCH);
 
-    // Create window
-    m_window = std::make_unique<Window>(m_config.window);
-
-    // Create render context
-    m_renderContext = std::make_unique<RenderContext>(*m_window, m_config.backend);
+    // Create window and render context; headless runs skip SDL entirely
+    if (m_config.headless) {
+        if (m_config.backend != GraphicsBackend::Noop) {
+            FE_LOG_INFO("Headless run: using the Noop backend");
+        }
+        m_renderContext = std::make_unique<RenderContext>(static_cast<uint32_t>(m_config.window.width),
+            static_cast<uint32_t>(m_config.window.height), GraphicsBackend::Noop);
+    } else {
+        m_window = std::make_unique<Window>(m_config.window);
+        m_renderContext = std::make_unique<RenderContext>(*m_window, m_config.backend);
+    }
 
     // Create resource manager
     auto resourceManager = std::make_unique<ResourceManager>(*m_renderContext->getEngine());
@@ -35,31 +44,55 @@ void Application::run() {
     m_debugRenderer = std::make_unique<DebugRenderer>(*m_renderContext);
 
     // Create ImGui layer
-    m_imguiLayer = std::make_unique<ImGuiLayer>(*m_renderContext, *m_window);
+    if (m_window) {
+        m_imguiLayer = std::make_unique<ImGuiLayer>(*m_renderContext, *m_window);
+    }
 
     // Create ECS world
     m_world = std::make_unique<World>(*m_renderContext, m_input, m_inputMap);
 
     // Register built-in systems (in priority order)
     m_world->registerSystem<TransformSyncSystem>();
+    m_world->registerSystem<StaticBatchSystem>();
+    m_world->registerSystem<LODSystem>();
     m_world->registerSystem<RenderSyncSystem>();
     m_world->registerSystem<LightSystem>();
     m_world->registerSystem<EditorCameraSystem>();
     m_world->registerSystem<CameraSystem>();
+    m_world->registerSystem<CullingSystem>();
+
+    const bool fixedStepping = m_config.fixedUpdateRate > 0.0f;
+    if (fixedStepping) {
+        m_fixedTimestep.setRate(m_config.fixedUpdateRate);
+        m_fixedTimestep.setMaxSteps(m_config.maxFixedSteps);
+    }
+    m_world->setFixedStepping(fixedStepping);
+    m_world->setPipelined(m_config.pipelined);
 
     // User initialization
     onInit();
 
     FE_LOG_INFO("Entering main loop");
 
+    // Frame times start here, not at construction: initialization is not a frame
+    m_clock.tick();
+    m_loopStartTime = m_clock.getElapsedTime();
+    m_frameCount = 0;
+
     // Main loop
-    while (!m_window->shouldClose()) {
+    while (!shouldStop()) {
         // Update clock
         m_clock.tick();
         float dt = m_clock.getDeltaTime();
 
+        // Sync point: the registry and input belong to the main thread until the next
+        // simulation starts
+        waitForSimulation();
+
         // Poll events and update input
-        m_window->pollEvents(m_input, m_eventBus);
+        if (m_window) {
+            m_window->pollEvents(m_input, m_eventBus);
+        }
 
         // Update input actions
         m_inputMap.update(m_input);
@@ -73,27 +106,42 @@ void Application::run() {
         m_debugRenderer->beginFrame();
 
         // Begin ImGui frame
-        m_imguiLayer->beginFrame(dt);
+        if (m_imguiLayer) {
+            m_imguiLayer->beginFrame(dt);
+        }
+
+        // Simulation steps; pipelined, they already ran during the previous frame's render
+        if (!m_config.pipelined) {
+            simulate(dt);
+            finishSimulation();
+        }
 
         // User update
         onUpdate(dt);
 
-        // User ImGui drawing
-        onImGui();
+        if (m_imguiLayer) {
+            // User ImGui drawing
+            onImGui();
 
-        // Draw overlays
-        for (auto& overlay : m_overlays) {
-            if (overlay->isEnabled()) {
-                overlay->onDraw();
+            // Draw overlays
+            for (auto& overlay : m_overlays) {
+                if (overlay->isEnabled()) {
+                    overlay->onDraw();
+                }
             }
-        }
 
-        // End ImGui frame
-        m_imguiLayer->endFrame();
+            // End ImGui frame
+            m_imguiLayer->endFrame();
+        }
 
         // ECS systems update (syncs to Filament)
         m_world->updateSystems(dt);
 
+        // Filament now holds this frame's state: the next frame can be simulated meanwhile
+        if (m_config.pipelined) {
+            beginSimulation(dt);
+        }
+
         // Render debug geometry
         m_debugRenderer->render();
 
@@ -102,8 +150,17 @@ void Application::run() {
             m_renderContext->render();
             m_renderContext->endFrame();
         }
+        ++m_frameCount;
     }
 
+    waitForSimulation();
+
+    m_clock.tick();
+    const double loopSeconds = m_clock.getElapsedTime() - m_loopStartTime;
+    FE_LOG_INFO("Ran %llu frames in %.2f s (%.3f ms/frame)",
+        static_cast<unsigned long long>(m_frameCount), loopSeconds,
+        m_frameCount ? 1000.0 * loopSeconds / static_cast<double>(m_frameCount) : 0.0);
+
     FE_LOG_INFO("Shutting down");
 
     // User cleanup
@@ -133,4 +190,57 @@ void Application::run() {
     FE_LOG_INFO("Engine shutdown complete");
 }
 
+bool Application::shouldStop() const {
+    if (m_quitRequested) return true;
+    if (m_window && m_window->shouldClose()) return true;
+    if (m_config.maxFrames > 0 && m_frameCount >= m_config.maxFrames) return true;
+    return m_config.maxDuration > 0.0 && m_clock.getElapsedTime() - m_loopStartTime >= m_config.maxDuration;
+}
+
+void Application::simulate(float dt) {
+    // As many steps as the frame time covers, or one of dt
+    if (!m_world->isFixedStepping()) {
+        onFixedUpdate(dt);
+        m_world->fixedUpdateSystems(dt);
+        return;
+    }
+
+    const float step = m_fixedTimestep.getStep();
+    for (uint32_t steps = m_fixedTimestep.advance(dt); steps > 0; --steps) {
+        onFixedUpdate(step);
+        m_world->fixedUpdateSystems(step);
+    }
+    m_simulatedAlpha = m_fixedTimestep.getAlpha();
+}
+
+void Application::finishSimulation() {
+    // Pipelined: command playback and main-thread systems deferred by the worker
+    if (m_world->isPipelined()) {
+        m_world->finishPipelinedSteps();
+    }
+    m_world->setInterpolationAlpha(m_simulatedAlpha);
+}
+
+void Application::beginSimulation(float dt) {
+    auto* jobSystem = m_world->getJobSystem();
+    if (!jobSystem) {
+        simulate(dt);
+        finishSimulation();
+        return;
+    }
+
+    // Retained so the next frame can wait on it; fixedUpdateSystems() fans out from the worker
+    auto* job = jobSystem->createJob(nullptr, [this, dt](utils::JobSystem&, utils::JobSystem::Job*) {
+        simulate(dt);
+    });
+    m_simulationJob = jobSystem->runAndRetain(job);
+}
+
+void Application::waitForSimulation() {
+    if (!m_simulationJob) return;
+    m_world->getJobSystem()->waitAndRelease(m_simulationJob);
+    m_simulationJob = nullptr;
+    finishSimulation();
+}
+
 } // namespace fe
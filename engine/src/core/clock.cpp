@@ -1,5 +1,8 @@
 #include <filament_engine/core/clock.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace fe {
 
 Clock::Clock()
@@ -22,4 +25,35 @@ float Clock::getFPS() const {
     return 0.0f;
 }
 
+FixedTimestep::FixedTimestep(float rateHz, uint32_t maxSteps)
+    : m_step(1.0f / 60.0f)
+    , m_maxSteps(maxSteps > 0 ? maxSteps : 1) {
+    setRate(rateHz);
+}
+
+void FixedTimestep::setRate(float rateHz) {
+    if (rateHz > 0.0f) {
+        m_step = 1.0f / rateHz;
+    }
+}
+
+uint32_t FixedTimestep::advance(float dt) {
+    m_accumulator += std::max(dt, 0.0f);
+
+    // A frame that is a hair short of a step (vsync jitter) still takes it, rather than
+    // alternating between zero and two steps
+    const float tolerance = m_step * 1e-3f;
+    uint32_t steps = 0;
+    while (m_accumulator + tolerance >= m_step && steps < m_maxSteps) {
+        m_accumulator = std::max(m_accumulator - m_step, 0.0f);
+        ++steps;
+    }
+
+    // Over the cap: keep only the fraction of a step so interpolation stays continuous
+    if (m_accumulator >= m_step) {
+        m_accumulator = std::fmod(m_accumulator, m_step);
+    }
+    return steps;
+}
+
 } // namespace fe
@@ -0,0 +1,47 @@
+#include <filament_engine/ecs/batch_bounds.h>
+#include <filament_engine/ecs/entity_bridge.h>
+
+#include <cmath>
+
+namespace fe {
+
+entt::entity updateBatchBounds(entt::registry& registry, entt::entity record, utils::Entity renderable,
+                               const Aabb& worldBounds, entt::entity cell) {
+    if (record == entt::null) {
+        record = registry.create();
+        registry.emplace<FilamentEntityComponent>(record, renderable);
+        registry.emplace<BatchBoundsComponent>(record, cell);
+        registry.emplace<BoundsComponent>(record, BoundsComponent{worldBounds, worldBounds});
+        return record;
+    }
+
+    registry.get<BatchBoundsComponent>(record).cell = cell;
+    registry.patch<BoundsComponent>(record, [&worldBounds](BoundsComponent& bounds) {
+        bounds.local = worldBounds;
+        bounds.world = worldBounds;
+    });
+    return record;
+}
+
+void destroyBatchBounds(entt::registry& registry, entt::entity& record) {
+    if (record == entt::null) return;
+    if (registry.valid(record)) registry.destroy(record);
+    record = entt::null;
+}
+
+entt::entity findVisibilityCell(const entt::registry& registry, const Vec3& point) {
+    for (auto [entity, cell] : registry.view<VisibilityCellComponent>().each()) {
+        auto* worldTransform = registry.try_get<WorldTransformComponent>(entity);
+        if (!worldTransform) continue;
+
+        const Aabb box = transformAabb(worldTransform->matrix, {{0, 0, 0}, cell.halfExtent});
+        const Vec3 offset = point - box.center;
+        if (std::abs(offset.x) <= box.halfExtent.x && std::abs(offset.y) <= box.halfExtent.y &&
+            std::abs(offset.z) <= box.halfExtent.z) {
+            return entity;
+        }
+    }
+    return entt::null;
+}
+
+} // namespace fe
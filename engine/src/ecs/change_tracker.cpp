@@ -0,0 +1,43 @@
+#include <filament_engine/ecs/change_tracker.h>
+
+namespace fe {
+
+void ChangeLog::record(entt::entity entity, uint64_t version) {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_latest.size()) {
+        m_latest.resize(index + 1, Entry{entt::null, 0});
+    }
+
+    auto& latest = m_latest[index];
+    if (latest.entity == entity && latest.version == version) return; // already logged this version
+
+    if (latest.version == 0 || latest.entity != entity) {
+        if (latest.version != 0) --m_liveCount; // index reused by a new entity
+        ++m_liveCount;
+    }
+    latest = {entity, version};
+    m_entries.push_back({entity, version});
+
+    // Keep the log proportional to the number of changed entities
+    if (m_entries.size() > 2 * m_liveCount + 64) {
+        compact();
+    }
+}
+
+void ChangeLog::forget(entt::entity entity) {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_latest.size()) return;
+
+    auto& latest = m_latest[index];
+    if (latest.entity == entity && latest.version != 0) {
+        latest = {entt::null, 0};
+        --m_liveCount;
+    }
+}
+
+void ChangeLog::compact() {
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+        [this](const Entry& entry) { return !isLatest(entry); }), m_entries.end());
+}
+
+} // namespace fe
@@ -0,0 +1,159 @@
+#include <filament_engine/ecs/command_buffer.h>
+#include <filament_engine/ecs/world.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace fe {
+
+// CommandBuffer
+
+CommandBuffer::~CommandBuffer() {
+    clear();
+}
+
+CommandEntity CommandBuffer::create(std::string_view name) {
+    CommandEntity entity;
+    entity.pending = static_cast<uint32_t>(m_creates.size());
+    m_creates.emplace_back(name);
+    return entity;
+}
+
+void CommandBuffer::destroy(CommandEntity entity) {
+    m_destroys.push_back(entity);
+}
+
+void CommandBuffer::play(entt::registry& registry, std::span<const entt::entity> created) {
+    for (auto& command : m_commands) {
+        command.play(command.payload, registry, created);
+    }
+}
+
+void CommandBuffer::collectDestroys(std::span<const entt::entity> created, std::vector<entt::entity>& out) const {
+    for (const auto& target : m_destroys) {
+        out.push_back(resolve(target, created));
+    }
+}
+
+void CommandBuffer::clear() {
+    for (auto& command : m_commands) {
+        if (command.destroy) command.destroy(command.payload);
+    }
+    m_commands.clear();
+    m_creates.clear();
+    m_destroys.clear();
+
+    // Keep the regular blocks for the next frame
+    m_oversized.clear();
+    m_block = 0;
+    m_offset = 0;
+}
+
+void* CommandBuffer::allocate(size_t size, size_t alignment) {
+    if (size > BLOCK_SIZE) {
+        m_oversized.push_back(std::make_unique<std::byte[]>(size));
+        return m_oversized.back().get();
+    }
+
+    size_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+    if (m_block < m_blocks.size() && offset + size > BLOCK_SIZE) {
+        ++m_block;
+        offset = 0;
+    }
+    if (m_block == m_blocks.size()) {
+        m_blocks.push_back(std::make_unique<std::byte[]>(BLOCK_SIZE));
+        offset = 0;
+    }
+
+    m_offset = offset + size;
+    return m_blocks[m_block].get() + offset;
+}
+
+// CommandQueue
+
+namespace {
+
+std::atomic<uint64_t> s_nextQueueId{1};
+
+// Per-thread cache of the last queue/buffer pair, so local() is lock-free after the first call
+struct LocalBufferCache {
+    uint64_t queueId = 0;
+    CommandBuffer* buffer = nullptr;
+};
+thread_local LocalBufferCache t_localBuffer;
+
+} // namespace
+
+CommandQueue::CommandQueue() : m_id(s_nextQueueId.fetch_add(1, std::memory_order_relaxed)) {}
+
+CommandBuffer& CommandQueue::local() {
+    if (t_localBuffer.queueId == m_id) {
+        return *t_localBuffer.buffer;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto thread = std::this_thread::get_id();
+    auto it = std::find_if(m_buffers.begin(), m_buffers.end(),
+        [thread](const ThreadBuffer& entry) { return entry.thread == thread; });
+    if (it == m_buffers.end()) {
+        m_buffers.push_back({thread, std::make_unique<CommandBuffer>()});
+        it = m_buffers.end() - 1;
+    }
+
+    t_localBuffer = {m_id, it->buffer.get()};
+    return *it->buffer;
+}
+
+bool CommandQueue::empty() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::all_of(m_buffers.begin(), m_buffers.end(),
+        [](const ThreadBuffer& entry) { return entry.buffer->empty(); });
+}
+
+void CommandQueue::flush(World& world) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // 1. Every pending create from every thread in one bulk call
+    size_t createCount = 0;
+    for (auto& entry : m_buffers) {
+        createCount += entry.buffer->getCreates().size();
+    }
+    m_created.resize(createCount);
+    if (createCount > 0) {
+        const Name defaultName("Entity");
+        world.createEntities(std::span<entt::entity>(m_created), defaultName);
+
+        // Names other than the default are patched so the name index sees them
+        size_t next = 0;
+        for (auto& entry : m_buffers) {
+            for (const auto& name : entry.buffer->getCreates()) {
+                if (!(name == defaultName)) {
+                    world.patchComponent<TagComponent>(m_created[next], [&name](auto& tag) { tag.name = name; });
+                }
+                ++next;
+            }
+        }
+    }
+
+    // 2. Commands in record order, buffer by buffer
+    m_destroyed.clear();
+    size_t firstCreated = 0;
+    for (auto& entry : m_buffers) {
+        auto& buffer = *entry.buffer;
+        std::span<const entt::entity> created(m_created.data() + firstCreated, buffer.getCreates().size());
+        firstCreated += created.size();
+
+        buffer.play(world.getRegistry(), created);
+        buffer.collectDestroys(created, m_destroyed);
+        buffer.clear();
+    }
+
+    // 3. Destroys last, as one batch
+    if (!m_destroyed.empty()) {
+        std::sort(m_destroyed.begin(), m_destroyed.end());
+        m_destroyed.erase(std::unique(m_destroyed.begin(), m_destroyed.end()), m_destroyed.end());
+        world.destroyEntities(m_destroyed);
+    }
+}
+
+} // namespace fe
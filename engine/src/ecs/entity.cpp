@@ -30,7 +30,7 @@ const TransformComponent& Entity::transform() const {
 }
 
 const std::string& Entity::name() const {
-    return m_world->getComponent<TagComponent>(m_handle).name;
+    return m_world->getComponent<TagComponent>(m_handle).name.str();
 }
 
 // Template method implementations — must be in a header that includes world.h,
@@ -1,5 +1,7 @@
 #include <filament_engine/ecs/entity_bridge.h>
 
+#include <vector>
+
 namespace fe {
 
 utils::Entity EntityBridge::link(entt::registry& registry, entt::entity entity) {
@@ -10,17 +12,34 @@ utils::Entity EntityBridge::link(entt::registry& registry, entt::entity entity)
     registry.emplace<FilamentEntityComponent>(entity, filamentEntity);
 
     // Register reverse lookup
-    m_filamentToEntt[filamentEntity.getId()] = entity;
+    setReverse(filamentEntity, entity);
 
     return filamentEntity;
 }
 
+void EntityBridge::linkRange(entt::registry& registry, std::span<const entt::entity> entities,
+                             std::span<utils::Entity> out) {
+    const size_t count = entities.size();
+    if (count == 0) return;
+
+    // One EntityManager lock for the whole batch
+    utils::EntityManager::get().create(count, out.data());
+
+    std::vector<FilamentEntityComponent> components(count);
+    for (size_t i = 0; i < count; ++i) {
+        components[i].filamentEntity = out[i];
+        setReverse(out[i], entities[i]);
+    }
+
+    registry.insert<FilamentEntityComponent>(entities.begin(), entities.end(), components.begin());
+}
+
 void EntityBridge::unlink(entt::registry& registry, entt::entity entity) {
     auto* comp = registry.try_get<FilamentEntityComponent>(entity);
     if (!comp) return;
 
     // Remove reverse lookup
-    m_filamentToEntt.erase(comp->filamentEntity.getId());
+    clearReverse(comp->filamentEntity);
 
     // Destroy the Filament entity
     utils::EntityManager::get().destroy(comp->filamentEntity);
@@ -29,12 +48,23 @@ void EntityBridge::unlink(entt::registry& registry, entt::entity entity) {
     registry.remove<FilamentEntityComponent>(entity);
 }
 
-entt::entity EntityBridge::getEnttEntity(utils::Entity filamentEntity) const {
-    auto it = m_filamentToEntt.find(filamentEntity.getId());
-    if (it != m_filamentToEntt.end()) {
-        return it->second;
+void EntityBridge::unlinkRange(entt::registry& registry, std::span<const entt::entity> entities,
+                               std::span<utils::Entity> filamentEntities) {
+    if (entities.empty()) return;
+
+    for (auto filamentEntity : filamentEntities) {
+        clearReverse(filamentEntity);
     }
-    return entt::null;
+
+    // One EntityManager lock for the whole batch
+    utils::EntityManager::get().destroy(filamentEntities.size(), filamentEntities.data());
+
+    registry.remove<FilamentEntityComponent>(entities.begin(), entities.end());
+}
+
+entt::entity EntityBridge::getEnttEntity(utils::Entity filamentEntity) const {
+    const auto* slot = findSlot(filamentEntity);
+    return slot ? slot->entity : entt::null;
 }
 
 utils::Entity EntityBridge::getFilamentEntity(const entt::registry& registry, entt::entity entity) const {
@@ -49,4 +79,43 @@ bool EntityBridge::hasFilamentEntity(const entt::registry& registry, entt::entit
     return registry.all_of<FilamentEntityComponent>(entity);
 }
 
+EntityBridge::Slot& EntityBridge::assureSlot(utils::Entity filamentEntity) {
+    const size_t index = utils::EntityManager::getIndex(filamentEntity);
+    const size_t page = index / PAGE_SIZE;
+    if (page >= m_pages.size()) {
+        m_pages.resize(page + 1);
+    }
+    if (!m_pages[page]) {
+        m_pages[page] = std::make_unique<Page>();
+    }
+    return (*m_pages[page])[index % PAGE_SIZE];
+}
+
+const EntityBridge::Slot* EntityBridge::findSlot(utils::Entity filamentEntity) const {
+    if (filamentEntity.isNull()) return nullptr;
+
+    const size_t index = utils::EntityManager::getIndex(filamentEntity);
+    const size_t page = index / PAGE_SIZE;
+    if (page >= m_pages.size() || !m_pages[page]) return nullptr;
+
+    // The full id includes the generation: a recycled index with a newer entity does not match
+    const auto& slot = (*m_pages[page])[index % PAGE_SIZE];
+    return slot.filamentId == filamentEntity.getId() ? &slot : nullptr;
+}
+
+void EntityBridge::setReverse(utils::Entity filamentEntity, entt::entity entity) {
+    auto& slot = assureSlot(filamentEntity);
+    if (slot.filamentId == 0) ++m_linkCount;
+    slot.filamentId = filamentEntity.getId();
+    slot.entity = entity;
+}
+
+void EntityBridge::clearReverse(utils::Entity filamentEntity) {
+    auto* slot = const_cast<Slot*>(findSlot(filamentEntity));
+    if (!slot) return;
+
+    *slot = Slot{};
+    --m_linkCount;
+}
+
 } // namespace fe
@@ -0,0 +1,232 @@
+#include <filament_engine/ecs/instance_batcher.h>
+#include <filament_engine/ecs/batch_bounds.h>
+#include <filament_engine/ecs/world.h>
+#include <filament_engine/rendering/render_context.h>
+#include <filament_engine/resources/mesh.h>
+#include <filament_engine/resources/material.h>
+#include <filament_engine/resources/resource_manager.h>
+#include <filament_engine/resources/material_instance_pool.h>
+
+#include <filament/Engine.h>
+#include <filament/InstanceBuffer.h>
+#include <filament/RenderableManager.h>
+#include <filament/Scene.h>
+
+#include <utils/EntityManager.h>
+
+#include <algorithm>
+
+namespace fe {
+
+void InstanceBatcher::connect(entt::registry& registry) {
+    registry.on_destroy<MeshRendererComponent>().connect<&InstanceBatcher::onRendererDestroyed>(*this);
+}
+
+void InstanceBatcher::disconnect(entt::registry& registry) {
+    registry.on_destroy<MeshRendererComponent>().disconnect<&InstanceBatcher::onRendererDestroyed>(*this);
+}
+
+bool InstanceBatcher::add(World& world, entt::entity entity, MeshRendererComponent& renderer, const Mesh&,
+                          uint32_t overrideInstance) {
+    renderer.batch = MeshRendererComponent::NO_BATCH;
+    renderer.batchKey = MeshRendererComponent::NO_BATCH;
+    if (m_grouping.getThreshold() == 0 || !renderer.allowInstancing) return false;
+
+    const uint32_t key = m_grouping.findOrAddKey({renderer.mesh.getId(), renderer.material.getId(), overrideInstance,
+                                                  (renderer.castShadows ? 1u : 0u) | (renderer.receiveShadows ? 2u : 0u)});
+    if (!m_grouping.wantsInstancing(key)) {
+        renderer.batchKey = key;
+        renderer.batchSlot = m_grouping.addIndividual(key, entity);
+        return false;
+    }
+    if (!m_grouping.isInstanced(key)) {
+        promote(world, key);
+    }
+
+    insert(world.getRegistry(), key, entity, renderer);
+    return true;
+}
+
+void InstanceBatcher::promote(World& world, uint32_t key) {
+    auto& registry = world.getRegistry();
+    auto* engine = world.getRenderContext().getEngine();
+    auto& rcm = engine->getRenderableManager();
+    auto* scene = world.getRenderContext().getScene();
+
+    // Filament can be built with a lower instance limit than its default
+    m_grouping.setBatchCapacity(static_cast<uint32_t>(
+        std::min<size_t>(MAX_INSTANCES_PER_BATCH, engine->getMaxAutomaticInstances())));
+
+    // The existing individual renderables are replaced by instances
+    for (auto entity : m_grouping.promote(key)) {
+        auto& renderer = registry.get<MeshRendererComponent>(entity);
+        auto filamentEntity = registry.get<FilamentEntityComponent>(entity).filamentEntity;
+        scene->remove(filamentEntity);
+        rcm.destroy(filamentEntity);
+        registry.remove<BoundsComponent>(entity);
+
+        renderer.batchKey = MeshRendererComponent::NO_BATCH;
+        insert(registry, key, entity, renderer);
+    }
+}
+
+void InstanceBatcher::insert(entt::registry& registry, uint32_t key, entt::entity entity,
+                             MeshRendererComponent& renderer) {
+    auto* worldTransform = registry.try_get<WorldTransformComponent>(entity);
+    auto placement = m_grouping.insert(key, entity, worldTransform ? worldTransform->matrix : Mat4());
+    if (m_renderables.size() <= placement.batch) {
+        m_renderables.resize(placement.batch + 1);
+    }
+    renderer.batch = placement.batch;
+    renderer.batchSlot = placement.slot;
+}
+
+void InstanceBatcher::remove(entt::registry& registry, entt::entity entity) {
+    auto& renderer = registry.get<MeshRendererComponent>(entity);
+
+    entt::entity moved = entt::null;
+    const uint32_t slot = renderer.batchSlot;
+    if (renderer.batch != MeshRendererComponent::NO_BATCH) {
+        // Swap-and-pop; the renderable is rebuilt (or torn down once empty) on the next update
+        moved = m_grouping.removeInstance(renderer.batch, slot);
+        renderer.batch = MeshRendererComponent::NO_BATCH;
+    } else if (renderer.batchKey != MeshRendererComponent::NO_BATCH) {
+        moved = m_grouping.removeIndividual(renderer.batchKey, slot);
+        renderer.batchKey = MeshRendererComponent::NO_BATCH;
+    }
+
+    if (moved != entt::null) {
+        registry.get<MeshRendererComponent>(moved).batchSlot = slot;
+    }
+}
+
+void InstanceBatcher::update(World& world) {
+    auto& registry = world.getRegistry();
+    auto& tracker = world.getChangeTracker();
+    auto& batches = m_grouping.getBatches();
+
+    uint64_t since = m_changeCursor;
+    m_changeCursor = tracker.advance();
+    if (batches.empty()) return;
+
+    tracker.forEachChanged<WorldTransformComponent>(since, [&](entt::entity entity) {
+        auto* renderer = registry.try_get<MeshRendererComponent>(entity);
+        if (!renderer || renderer->batch == MeshRendererComponent::NO_BATCH) return;
+
+        auto& batch = batches[renderer->batch];
+        batch.transforms[renderer->batchSlot] = registry.get<WorldTransformComponent>(entity).matrix;
+        batch.transformsDirty = true;
+    });
+
+    auto& rcm = world.getRenderContext().getEngine()->getRenderableManager();
+    for (uint32_t index = 0; index < batches.size(); ++index) {
+        auto& batch = batches[index];
+        auto& target = m_renderables[index];
+        if (batch.membershipDirty) {
+            rebuild(world, index);
+        } else if (batch.transformsDirty && target.buffer) {
+            target.buffer->setLocalTransforms(batch.transforms.data(), batch.transforms.size());
+            auto instance = rcm.getInstance(target.renderable);
+            Aabb bounds = computeBounds(batch, target.localBounds);
+            rcm.setAxisAlignedBoundingBox(instance, {bounds.center, bounds.halfExtent});
+            target.cullRecord = updateBatchBounds(registry, target.cullRecord, target.renderable, bounds);
+        }
+        batch.membershipDirty = false;
+        batch.transformsDirty = false;
+    }
+}
+
+void InstanceBatcher::rebuild(World& world, uint32_t index) {
+    auto* engine = world.getRenderContext().getEngine();
+    auto* scene = world.getRenderContext().getScene();
+    auto& rcm = engine->getRenderableManager();
+    const auto& batch = m_grouping.getBatches()[index];
+    auto& target = m_renderables[index];
+
+    // The instance count is fixed at build time: membership changes rebuild the renderable
+    if (!target.renderable.isNull() && rcm.hasComponent(target.renderable)) {
+        rcm.destroy(target.renderable);
+    }
+    if (target.buffer) {
+        engine->destroy(target.buffer);
+        target.buffer = nullptr;
+    }
+
+    if (batch.members.empty()) {
+        destroyBatchBounds(world.getRegistry(), target.cullRecord);
+        if (target.inScene) {
+            scene->remove(target.renderable);
+            target.inScene = false;
+        }
+        return;
+    }
+
+    // A reused batch may belong to a different key than last time
+    const InstanceKey& key = m_grouping.getKey(batch.key);
+    auto* resourceMgr = ResourceManager::getInstance();
+    const Mesh* mesh = resourceMgr ? resourceMgr->getMesh(ResourceHandle<Mesh>(key.mesh)) : nullptr;
+    const MaterialWrapper* material =
+        resourceMgr ? resourceMgr->getMaterial(ResourceHandle<MaterialWrapper>(key.material)) : nullptr;
+    if (!mesh || !material) return;
+
+    filament::MaterialInstance* materialInstance = key.overrideInstance
+        ? resourceMgr->getMaterialInstancePool().getInstance(key.overrideInstance)
+        : material->getInstance();
+    if (!materialInstance) return;
+
+    if (target.renderable.isNull()) {
+        target.renderable = utils::EntityManager::get().create();
+    }
+    target.localBounds = {mesh->boundingBox.center, mesh->boundingBox.halfExtent};
+
+    const auto count = batch.members.size();
+    target.buffer = filament::InstanceBuffer::Builder(count)
+        .localTransforms(batch.transforms.data())
+        .build(*engine);
+
+    Aabb bounds = computeBounds(batch, target.localBounds);
+    filament::RenderableManager::Builder(1)
+        .boundingBox({bounds.center, bounds.halfExtent})
+        .material(0, materialInstance)
+        .geometry(0, filament::RenderableManager::PrimitiveType::TRIANGLES,
+                  mesh->vertexBuffer, mesh->indexBuffer,
+                  0, mesh->indexCount)
+        .instances(count, target.buffer)
+        .culling(true)
+        .castShadows((key.shadowFlags & 1u) != 0)
+        .receiveShadows((key.shadowFlags & 2u) != 0)
+        .build(*engine, target.renderable);
+    target.cullRecord = updateBatchBounds(world.getRegistry(), target.cullRecord, target.renderable, bounds);
+
+    if (!target.inScene) {
+        scene->addEntity(target.renderable);
+        target.inScene = true;
+    }
+}
+
+Aabb InstanceBatcher::computeBounds(const InstanceGrouping::Batch& batch, const Aabb& localBounds) const {
+    // Renderable sits at the origin, so its box is the union of the instances' world boxes
+    Aabb bounds = transformAabb(batch.transforms[0], localBounds);
+    for (size_t i = 1; i < batch.transforms.size(); ++i) {
+        bounds = mergeAabb(bounds, transformAabb(batch.transforms[i], localBounds));
+    }
+    return bounds;
+}
+
+void InstanceBatcher::destroyAll(World& world) {
+    auto* engine = world.getRenderContext().getEngine();
+    auto* scene = world.getRenderContext().getScene();
+
+    for (auto& target : m_renderables) {
+        destroyBatchBounds(world.getRegistry(), target.cullRecord);
+        if (target.renderable.isNull()) continue;
+        if (target.inScene) scene->remove(target.renderable);
+        engine->destroy(target.renderable);
+        if (target.buffer) engine->destroy(target.buffer);
+        utils::EntityManager::get().destroy(target.renderable);
+    }
+    m_renderables.clear();
+    m_grouping.clear();
+}
+
+} // namespace fe
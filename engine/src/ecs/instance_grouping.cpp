@@ -0,0 +1,102 @@
+#include <filament_engine/ecs/instance_grouping.h>
+
+namespace fe {
+
+uint32_t InstanceGrouping::findOrAddKey(const InstanceKey& key) {
+    auto [it, inserted] = m_keys.try_emplace(key, static_cast<uint32_t>(m_keyStates.size()));
+    if (inserted) {
+        m_keyStates.emplace_back().key = key;
+    }
+    return it->second;
+}
+
+bool InstanceGrouping::wantsInstancing(uint32_t key) const {
+    const auto& state = m_keyStates[key];
+    if (state.instanced) return true;
+    return m_threshold > 0 && state.individual.size() + 1 >= m_threshold;
+}
+
+uint32_t InstanceGrouping::addIndividual(uint32_t key, entt::entity entity) {
+    auto& individual = m_keyStates[key].individual;
+    individual.push_back(entity);
+    return static_cast<uint32_t>(individual.size() - 1);
+}
+
+entt::entity InstanceGrouping::removeIndividual(uint32_t key, uint32_t slot) {
+    auto& individual = m_keyStates[key].individual;
+    individual[slot] = individual.back();
+    individual.pop_back();
+    return slot < individual.size() ? individual[slot] : entt::null;
+}
+
+std::vector<entt::entity> InstanceGrouping::promote(uint32_t key) {
+    auto& state = m_keyStates[key];
+    state.instanced = true;
+    std::vector<entt::entity> promoted;
+    promoted.swap(state.individual);
+    return promoted;
+}
+
+InstanceGrouping::Placement InstanceGrouping::insert(uint32_t key, entt::entity entity, const Mat4& transform) {
+    auto& state = m_keyStates[key];
+
+    // Fill the key's last batch before opening a new one
+    uint32_t index = state.batches.empty() ? NONE : state.batches.back();
+    if (index == NONE || m_batches[index].members.size() >= m_batchCapacity) {
+        if (!m_freeBatches.empty()) {
+            index = m_freeBatches.back();
+            m_freeBatches.pop_back();
+        } else {
+            index = static_cast<uint32_t>(m_batches.size());
+            m_batches.emplace_back();
+        }
+        m_batches[index].key = key;
+        state.batches.push_back(index);
+    }
+
+    auto& batch = m_batches[index];
+    batch.members.push_back(entity);
+    batch.transforms.push_back(transform);
+    batch.membershipDirty = true;
+    return {index, static_cast<uint32_t>(batch.members.size() - 1)};
+}
+
+entt::entity InstanceGrouping::removeInstance(uint32_t index, uint32_t slot) {
+    auto& batch = m_batches[index];
+    batch.members[slot] = batch.members.back();
+    batch.transforms[slot] = batch.transforms.back();
+    batch.members.pop_back();
+    batch.transforms.pop_back();
+    batch.membershipDirty = true;
+
+    if (!batch.members.empty()) {
+        return slot < batch.members.size() ? batch.members[slot] : entt::null;
+    }
+
+    // Release the batch; its renderable is torn down (or rebuilt for a new key) on the next update
+    auto& batches = m_keyStates[batch.key].batches;
+    for (size_t i = 0; i < batches.size(); ++i) {
+        if (batches[i] == index) {
+            batches.erase(batches.begin() + static_cast<std::ptrdiff_t>(i));
+            break;
+        }
+    }
+    batch.key = NONE;
+    m_freeBatches.push_back(index);
+    return entt::null;
+}
+
+size_t InstanceGrouping::getInstanceCount() const {
+    size_t count = 0;
+    for (const auto& batch : m_batches) count += batch.members.size();
+    return count;
+}
+
+void InstanceGrouping::clear() {
+    m_keys.clear();
+    m_keyStates.clear();
+    m_batches.clear();
+    m_freeBatches.clear();
+}
+
+} // namespace fe
@@ -0,0 +1,92 @@
+#include <filament_engine/ecs/light_budget.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace fe {
+
+float LightBudget::score(const LightCandidate& light, const Vec3& viewPosition, const Frustum* frustum) {
+    const float luminance = 0.2126f * light.color.x + 0.7152f * light.color.y + 0.0722f * light.color.z;
+    const float brightness = light.intensity * luminance;
+    if (light.type == LightComponent::Type::Directional) return brightness;
+    if (light.radius <= 0.0f || brightness <= 0.0f) return 0.0f;
+
+    // The light only matters inside its range; spots are bounded by the same sphere
+    if (frustum && !frustum->intersects({light.position, {light.radius, light.radius, light.radius}})) {
+        return 0.0f;
+    }
+
+    // Approximate solid angle of the range sphere, saturating once the viewer is inside it
+    const Vec3 offset = light.position - viewPosition;
+    const float distanceSq = dot(offset, offset);
+    const float radiusSq = light.radius * light.radius;
+    const float coverage = distanceSq <= radiusSq ? 1.0f : radiusSq / distanceSq;
+    return brightness * coverage;
+}
+
+void LightBudget::select(std::vector<LightCandidate>& candidates, const Vec3& viewPosition, const Frustum* frustum) {
+    m_stats = {};
+    m_stats.lights = static_cast<uint32_t>(candidates.size());
+    m_active.clear();
+    m_shadowCasters.clear();
+    m_order.clear();
+
+    for (uint32_t i = 0; i < candidates.size(); ++i) {
+        auto& light = candidates[i];
+        light.active = false;
+        light.shadowCaster = false;
+
+        if (light.type == LightComponent::Type::Directional) {
+            light.score = score(light, viewPosition, frustum);
+            light.active = true;
+            light.shadowCaster = light.castShadows;
+            m_active.push_back(light.entity);
+            if (light.shadowCaster) m_shadowCasters.push_back(light.entity);
+            continue;
+        }
+
+        light.score = score(light, viewPosition, frustum);
+        if (light.score <= 0.0f) {
+            ++m_stats.outOfView;
+            continue;
+        }
+        if (light.wasActive) light.score *= 1.0f + m_hysteresis;
+        m_order.push_back(i);
+    }
+
+    // Punctual lights: the highest scores fill the light budget
+    auto byScore = [&candidates](uint32_t a, uint32_t b) {
+        return candidates[a].score > candidates[b].score;
+    };
+    const size_t keep = std::min<size_t>(m_order.size(), m_maxLights);
+    std::partial_sort(m_order.begin(), m_order.begin() + keep, m_order.end(), byScore);
+    m_stats.overBudget = static_cast<uint32_t>(m_order.size() - keep);
+
+    for (size_t rank = 0; rank < keep; ++rank) {
+        auto& light = candidates[m_order[rank]];
+        light.active = true;
+        m_active.push_back(light.entity);
+    }
+
+    // The best shadow casters among them get the shadow slots; current holders get the
+    // bonus again so a slot only changes hands for a clearly better light
+    m_order.resize(keep);
+    m_order.erase(std::remove_if(m_order.begin(), m_order.end(),
+        [&candidates](uint32_t i) { return !candidates[i].castShadows; }), m_order.end());
+    auto shadowScore = [this, &candidates](uint32_t i) {
+        return candidates[i].score * (candidates[i].wasShadowCaster ? 1.0f + m_hysteresis : 1.0f);
+    };
+    const size_t slots = std::min<size_t>(m_order.size(), m_maxShadowCasters);
+    std::partial_sort(m_order.begin(), m_order.begin() + slots, m_order.end(),
+        [&shadowScore](uint32_t a, uint32_t b) { return shadowScore(a) > shadowScore(b); });
+    for (size_t rank = 0; rank < slots; ++rank) {
+        auto& light = candidates[m_order[rank]];
+        light.shadowCaster = true;
+        m_shadowCasters.push_back(light.entity);
+    }
+
+    m_stats.active = static_cast<uint32_t>(m_active.size());
+    m_stats.shadowCasters = static_cast<uint32_t>(slots);
+}
+
+} // namespace fe
@@ -0,0 +1,32 @@
+#include <filament_engine/ecs/material_override.h>
+#include <filament_engine/resources/resource_manager.h>
+
+namespace fe {
+
+filament::MaterialInstance* resolveMaterialOverride(MaterialOverrideComponent& override,
+                                                    ResourceHandle<MaterialWrapper> material) {
+    auto* resourceMgr = ResourceManager::getInstance();
+    auto* parent = resourceMgr ? resourceMgr->getMaterial(material) : nullptr;
+    if (!parent) return nullptr;
+
+    auto& pool = resourceMgr->getMaterialInstancePool();
+    if (!pool.matches(override.instance, material, override.parameters)) {
+        // Acquire first so an unchanged set never drops to zero references in between
+        uint32_t previous = override.instance;
+        override.instance = pool.acquire(material, *parent, override.parameters);
+        pool.release(previous);
+    }
+    return pool.getInstance(override.instance);
+}
+
+void releaseMaterialOverride(entt::registry& registry, entt::entity entity) {
+    auto& override = registry.get<MaterialOverrideComponent>(entity);
+    if (override.instance == 0) return;
+
+    if (auto* resourceMgr = ResourceManager::getInstance()) {
+        resourceMgr->getMaterialInstancePool().release(override.instance);
+    }
+    override.instance = 0;
+}
+
+} // namespace fe
@@ -0,0 +1,69 @@
+#include <filament_engine/ecs/name_index.h>
+
+namespace fe {
+
+void NameIndex::connect(entt::registry& registry) {
+    registry.on_construct<TagComponent>().connect<&NameIndex::onTagChanged>(*this);
+    registry.on_update<TagComponent>().connect<&NameIndex::onTagChanged>(*this);
+    registry.on_destroy<TagComponent>().connect<&NameIndex::onTagDestroyed>(*this);
+}
+
+entt::entity NameIndex::find(Name name) const {
+    auto it = m_buckets.find(name.id());
+    if (it == m_buckets.end() || it->second.empty()) return entt::null;
+    return it->second.front();
+}
+
+void NameIndex::findAll(Name name, std::vector<entt::entity>& out) const {
+    auto it = m_buckets.find(name.id());
+    if (it == m_buckets.end()) return;
+    out.insert(out.end(), it->second.begin(), it->second.end());
+}
+
+size_t NameIndex::count(Name name) const {
+    auto it = m_buckets.find(name.id());
+    return it != m_buckets.end() ? it->second.size() : 0;
+}
+
+void NameIndex::onTagChanged(entt::registry& registry, entt::entity entity) {
+    // Renames arrive through patch(): drop the old entry first
+    erase(entity);
+    insert(entity, registry.get<TagComponent>(entity).name.id());
+}
+
+void NameIndex::onTagDestroyed(entt::registry&, entt::entity entity) {
+    erase(entity);
+}
+
+void NameIndex::insert(entt::entity entity, uint32_t nameId) {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_records.size()) {
+        m_records.resize(index + 1);
+    }
+
+    auto& bucket = m_buckets[nameId];
+    m_records[index] = {entity, nameId, static_cast<uint32_t>(bucket.size())};
+    bucket.push_back(entity);
+}
+
+void NameIndex::erase(entt::entity entity) {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_records.size() || m_records[index].entity != entity) return;
+
+    auto& record = m_records[index];
+    auto& bucket = m_buckets[record.nameId];
+
+    // Swap-and-pop, then fix the moved entity's slot
+    const auto last = bucket.back();
+    bucket[record.slot] = last;
+    bucket.pop_back();
+    if (last != entity) {
+        m_records[static_cast<size_t>(entt::to_entity(last))].slot = record.slot;
+    }
+    if (bucket.empty()) {
+        m_buckets.erase(record.nameId);
+    }
+    record = Record{};
+}
+
+} // namespace fe
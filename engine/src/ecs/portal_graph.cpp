@@ -0,0 +1,213 @@
+#include <filament_engine/ecs/portal_graph.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace fe {
+
+namespace {
+
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+// Camera-facing view matrix for the PVS samples
+Mat4 lookAlong(const Vec3& eye, const Vec3& forward, const Vec3& up) {
+    const Vec3 side = normalize(cross(forward, up));
+    const Vec3 trueUp = cross(side, forward);
+
+    Mat4 view;
+    for (int axis = 0; axis < 3; ++axis) {
+        view[axis][0] = side[axis];
+        view[axis][1] = trueUp[axis];
+        view[axis][2] = -forward[axis];
+        view[axis][3] = 0.0f;
+    }
+    view[3][0] = -dot(side, eye);
+    view[3][1] = -dot(trueUp, eye);
+    view[3][2] = dot(forward, eye);
+    view[3][3] = 1.0f;
+    return view;
+}
+
+} // namespace
+
+void PortalGraph::clear() {
+    m_cells.clear();
+    m_portals.clear();
+    m_cellTree.clear();
+    m_visibleCount = 0;
+    m_layout = EMPTY_LAYOUT;
+}
+
+uint32_t PortalGraph::addCell(const Aabb& bounds) {
+    const auto index = static_cast<uint32_t>(m_cells.size());
+    Cell cell;
+    cell.bounds = bounds;
+    m_cells.push_back(cell);
+
+    m_cellTree.insert(bounds, index);
+    hashLayout(&bounds, sizeof(bounds));
+    return index;
+}
+
+void PortalGraph::addPortal(uint32_t cellA, uint32_t cellB, const Vec3 (&corners)[4], bool open) {
+    const auto index = static_cast<uint32_t>(m_portals.size());
+    Portal portal;
+    std::copy(std::begin(corners), std::end(corners), portal.corners);
+    portal.cells[0] = cellA;
+    portal.cells[1] = cellB;
+    portal.open = open;
+    m_portals.push_back(portal);
+
+    m_cells[cellA].portals.push_back(index);
+    if (cellB != cellA) m_cells[cellB].portals.push_back(index);
+    hashLayout(portal.corners, sizeof(portal.corners));
+    hashLayout(portal.cells, sizeof(portal.cells));
+}
+
+void PortalGraph::hashLayout(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        m_layout = (m_layout ^ bytes[i]) * FNV_PRIME;
+    }
+}
+
+uint32_t PortalGraph::findCell(const Vec3& point) const {
+    uint32_t found = NO_CELL;
+    m_cellTree.query({point, {0, 0, 0}}, [&](uint32_t proxy) {
+        // The tree holds padded boxes: check the cell itself
+        const uint32_t cell = m_cellTree.getUserData(proxy);
+        const Vec3 offset = point - m_cells[cell].bounds.center;
+        const Vec3& extent = m_cells[cell].bounds.halfExtent;
+        if (std::abs(offset.x) <= extent.x && std::abs(offset.y) <= extent.y && std::abs(offset.z) <= extent.z) {
+            found = std::min(found, cell);
+        }
+        return true;
+    });
+    return found;
+}
+
+void PortalGraph::computeVisibility(const Mat4& viewProjection, uint32_t cameraCell) {
+    if (++m_pass == 0) m_pass = 1;
+    m_visibleCount = 0;
+    if (cameraCell >= m_cells.size()) return;
+
+    const uint64_t* pvsRow = hasPvs() ? &m_pvs[static_cast<size_t>(cameraCell) * m_pvsWords] : nullptr;
+    floodFill(viewProjection, cameraCell, false, pvsRow);
+}
+
+void PortalGraph::floodFill(const Mat4& viewProjection, uint32_t cameraCell, bool openAll, const uint64_t* pvsRow) {
+    Cell& start = m_cells[cameraCell];
+    start.visiblePass = m_pass;
+    start.rect = {-1.0f, -1.0f, 1.0f, 1.0f};
+    m_visibleCount = 1;
+
+    // A cell reached along several paths sees the union of their rectangles. It is walked
+    // again whenever that union grows; the budget bounds pathological layouts.
+    size_t budget = 8 * m_cells.size() + m_portals.size();
+    m_stack.clear();
+    m_stack.push_back(cameraCell);
+    while (!m_stack.empty() && budget-- > 0) {
+        const uint32_t index = m_stack.back();
+        m_stack.pop_back();
+        const Rect rect = m_cells[index].rect;
+
+        for (uint32_t portalIndex : m_cells[index].portals) {
+            const Portal& portal = m_portals[portalIndex];
+            if (!portal.open && !openAll) continue;
+            const uint32_t next = portal.cells[0] == index ? portal.cells[1] : portal.cells[0];
+            if (pvsRow && !((pvsRow[next / 64] >> (next % 64)) & 1)) continue;
+
+            Rect through;
+            if (!projectPortal(portal, viewProjection, through)) continue;
+            through = {std::max(through.x0, rect.x0), std::max(through.y0, rect.y0),
+                       std::min(through.x1, rect.x1), std::min(through.y1, rect.y1)};
+            if (through.x0 >= through.x1 || through.y0 >= through.y1) continue;
+
+            Cell& cell = m_cells[next];
+            if (cell.visiblePass != m_pass) {
+                cell.visiblePass = m_pass;
+                cell.rect = through;
+                ++m_visibleCount;
+            } else if (through.x0 < cell.rect.x0 || through.y0 < cell.rect.y0 ||
+                       through.x1 > cell.rect.x1 || through.y1 > cell.rect.y1) {
+                cell.rect = {std::min(cell.rect.x0, through.x0), std::min(cell.rect.y0, through.y0),
+                             std::max(cell.rect.x1, through.x1), std::max(cell.rect.y1, through.y1)};
+            } else {
+                continue;
+            }
+            m_stack.push_back(next);
+        }
+    }
+
+    for (auto& cell : m_cells) {
+        if (cell.visiblePass != m_pass) continue;
+        cell.frustum = Frustum::fromMatrix(viewProjection, cell.rect.x0, cell.rect.x1, cell.rect.y0, cell.rect.y1);
+    }
+}
+
+bool PortalGraph::projectPortal(const Portal& portal, const Mat4& viewProjection, Rect& rect) const {
+    rect = {1.0f, 1.0f, -1.0f, -1.0f};
+    int behind = 0;
+    for (const auto& corner : portal.corners) {
+        const Vec4 clip = viewProjection * Vec4{corner.x, corner.y, corner.z, 1.0f};
+        if (clip.z + clip.w < 0.0f || clip.w <= 0.0f) {
+            ++behind;
+            continue;
+        }
+        const float x = clip.x / clip.w;
+        const float y = clip.y / clip.w;
+        rect = {std::min(rect.x0, x), std::min(rect.y0, y), std::max(rect.x1, x), std::max(rect.y1, y)};
+    }
+
+    // Entirely behind the camera; partly behind means the camera stands in the opening
+    if (behind == 4) return false;
+    if (behind > 0) {
+        rect = {-1.0f, -1.0f, 1.0f, 1.0f};
+        return true;
+    }
+
+    rect = {std::max(rect.x0, -1.0f), std::max(rect.y0, -1.0f), std::min(rect.x1, 1.0f), std::min(rect.y1, 1.0f)};
+    return rect.x0 < rect.x1 && rect.y0 < rect.y1;
+}
+
+void PortalGraph::bakePvs(uint32_t samplesPerAxis) {
+    samplesPerAxis = std::max(samplesPerAxis, 1u);
+    const auto cellCount = static_cast<uint32_t>(m_cells.size());
+    m_pvsWords = (cellCount + 63) / 64;
+    m_pvs.assign(static_cast<size_t>(cellCount) * m_pvsWords, 0);
+    m_pvsLayout = m_layout;
+
+    // 90 degree views along the six axes cover every direction
+    const Mat4 projection = Mat4::perspective(90.0f, 1.0f, 0.01f, 10000.0f);
+    const Vec3 forwards[6] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+    const Vec3 ups[6] = {{0, 1, 0}, {0, 1, 0}, {0, 0, 1}, {0, 0, 1}, {0, 1, 0}, {0, 1, 0}};
+
+    for (uint32_t from = 0; from < cellCount; ++from) {
+        const Aabb bounds = m_cells[from].bounds;
+        uint64_t* row = &m_pvs[static_cast<size_t>(from) * m_pvsWords];
+
+        for (uint32_t i = 0; i < samplesPerAxis * samplesPerAxis * samplesPerAxis; ++i) {
+            const uint32_t grid[3] = {i % samplesPerAxis, (i / samplesPerAxis) % samplesPerAxis,
+                                      i / (samplesPerAxis * samplesPerAxis)};
+            Vec3 eye;
+            for (int axis = 0; axis < 3; ++axis) {
+                const float t = (static_cast<float>(grid[axis]) + 0.5f) / static_cast<float>(samplesPerAxis);
+                eye[axis] = bounds.center[axis] + bounds.halfExtent[axis] * (2.0f * t - 1.0f);
+            }
+
+            for (int face = 0; face < 6; ++face) {
+                if (++m_pass == 0) m_pass = 1;
+                floodFill(projection * lookAlong(eye, forwards[face], ups[face]), from, true, nullptr);
+                for (uint32_t to = 0; to < cellCount; ++to) {
+                    if (m_cells[to].visiblePass == m_pass) row[to / 64] |= uint64_t{1} << (to % 64);
+                }
+            }
+        }
+    }
+
+    // The bake reuses the runtime markers; nothing is visible until the next frame
+    if (++m_pass == 0) m_pass = 1;
+    m_visibleCount = 0;
+}
+
+} // namespace fe
@@ -0,0 +1,22 @@
+#include <filament_engine/ecs/prefab.h>
+
+namespace fe {
+
+Prefab::Prefab(std::string_view rootName) {
+    m_nodes.push_back({Name(rootName), ROOT, {}});
+}
+
+uint32_t Prefab::addChild(uint32_t parent, std::string_view name) {
+    // Children always come after their parent, so instantiating in node order is parent-first
+    const auto index = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.push_back({Name(name), parent, {}});
+    return index;
+}
+
+void Prefab::applyComponents(uint32_t node, entt::registry& registry, std::span<const entt::entity> entities) const {
+    for (const auto& component : m_nodes[node].components) {
+        component->apply(registry, entities);
+    }
+}
+
+} // namespace fe
@@ -3,8 +3,6 @@
 #include <filament_engine/ecs/entity.h>
 #include <filament_engine/core/log.h>
 
-#include <algorithm>
-
 namespace fe {
 
 Scene::Scene(World& world, const std::string& name)
@@ -18,31 +16,83 @@ Scene::~Scene() {
 
 Entity Scene::createEntity(const std::string& name) {
     Entity entity = m_world.createEntity(name);
-    m_entities.push_back(entity.getHandle());
+    addEntity(entity.getHandle());
     return entity;
 }
 
+std::span<const entt::entity> Scene::createEntities(size_t count, Name name) {
+    auto entities = m_world.createEntities(count, name);
+
+    // Fresh entities cannot belong to another scene, so memberships go in as one range
+    const auto first = static_cast<uint32_t>(m_entities.size());
+    std::vector<SceneMembershipComponent> memberships(entities.size());
+    for (size_t i = 0; i < memberships.size(); ++i) {
+        memberships[i] = {this, first + static_cast<uint32_t>(i)};
+    }
+    m_world.getRegistry().insert<SceneMembershipComponent>(entities.begin(), entities.end(), memberships.begin());
+    m_entities.insert(m_entities.end(), entities.begin(), entities.end());
+    return entities;
+}
+
+void Scene::addEntity(entt::entity entity) {
+    auto& registry = m_world.getRegistry();
+    if (!registry.valid(entity)) return;
+
+    if (auto* membership = registry.try_get<SceneMembershipComponent>(entity)) {
+        if (membership->scene == this) return;
+        membership->scene->removeEntity(entity);
+    }
+
+    registry.emplace<SceneMembershipComponent>(entity, this, static_cast<uint32_t>(m_entities.size()));
+    m_entities.push_back(entity);
+}
+
+void Scene::removeEntity(entt::entity entity) {
+    if (!contains(entity)) return;
+
+    // The on_destroy handler does the swap-and-pop
+    m_world.getRegistry().remove<SceneMembershipComponent>(entity);
+}
+
 void Scene::destroyEntity(Entity entity) {
-    auto it = std::find(m_entities.begin(), m_entities.end(), entity.getHandle());
-    if (it != m_entities.end()) {
+    if (contains(entity.getHandle())) {
         m_world.destroyEntity(entity.getHandle());
-        m_entities.erase(it);
     }
 }
 
 void Scene::destroyAll() {
-    // Destroy in reverse order for safety
-    for (auto it = m_entities.rbegin(); it != m_entities.rend(); ++it) {
-        if (m_world.getRegistry().valid(*it)) {
-            m_world.destroyEntity(*it);
-        }
-    }
+    // One batched teardown instead of a destroyEntity call per member.
+    // The whole list goes away, so skip the per-entity swap-and-pop.
+    m_clearing = true;
+    m_world.destroyEntities(m_entities);
     m_entities.clear();
+    m_clearing = false;
     FE_LOG_DEBUG("Scene '%s' cleared", m_name.c_str());
 }
 
 bool Scene::contains(entt::entity entity) const {
-    return std::find(m_entities.begin(), m_entities.end(), entity) != m_entities.end();
+    const auto& registry = m_world.getRegistry();
+    if (!registry.valid(entity)) return false;
+
+    const auto* membership = registry.try_get<SceneMembershipComponent>(entity);
+    return membership && membership->scene == this;
+}
+
+void Scene::onMembershipDestroyed(entt::registry& registry, entt::entity entity) {
+    const auto& membership = registry.get<SceneMembershipComponent>(entity);
+    if (membership.scene && !membership.scene->m_clearing) {
+        membership.scene->unlinkMember(membership.index);
+    }
+}
+
+void Scene::unlinkMember(uint32_t index) {
+    // Swap-and-pop, then fix the moved entity's slot
+    const auto last = m_entities.back();
+    m_entities[index] = last;
+    m_entities.pop_back();
+    if (index < m_entities.size()) {
+        m_world.getRegistry().get<SceneMembershipComponent>(last).index = index;
+    }
 }
 
 } // namespace fe
@@ -0,0 +1,68 @@
+#include <filament_engine/ecs/spatial_hash.h>
+
+namespace fe {
+
+namespace {
+
+// Chunk size for the parallel build passes (cheap per point, so larger than the default)
+constexpr uint32_t BUILD_CHUNK_SIZE = 4096;
+
+} // namespace
+
+void SpatialHash::build(std::span<const entt::entity> entities, std::span<const Vec3> positions,
+                        utils::JobSystem* jobSystem) {
+    const auto count = static_cast<uint32_t>(std::min(entities.size(), positions.size()));
+    if (count == 0) {
+        clear();
+        return;
+    }
+
+    // Power-of-two table with ~2 buckets per point keeps collisions rare
+    uint32_t bucketCount = 64;
+    while (bucketCount < count * 2) bucketCount <<= 1;
+    m_bucketMask = bucketCount - 1;
+
+    // 1. Bucket of every point
+    m_keys.resize(count);
+    parallelFor(jobSystem, count, BUILD_CHUNK_SIZE, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            m_keys[i] = bucketOf(cellOf(positions[i]));
+        }
+    });
+
+    // 2. Histogram and exclusive prefix sum: bucket b starts at m_bucketStart[b]
+    m_bucketStart.assign(bucketCount + 1, 0);
+    for (uint32_t i = 0; i < count; ++i) {
+        ++m_bucketStart[m_keys[i] + 1];
+    }
+    for (uint32_t b = 0; b < bucketCount; ++b) {
+        m_bucketStart[b + 1] += m_bucketStart[b];
+    }
+
+    // 3. Stable scatter: input order is kept within a bucket
+    m_cursor.assign(m_bucketStart.begin(), m_bucketStart.end() - 1);
+    m_order.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        m_order[m_cursor[m_keys[i]]++] = i;
+    }
+
+    // 4. Gather into sorted order so every bucket is one contiguous range
+    m_entities.resize(count);
+    m_positions.resize(count);
+    parallelFor(jobSystem, count, BUILD_CHUNK_SIZE, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t k = begin; k < end; ++k) {
+            const uint32_t source = m_order[k];
+            m_entities[k] = entities[source];
+            m_positions[k] = positions[source];
+        }
+    });
+}
+
+void SpatialHash::clear() {
+    m_bucketMask = 0;
+    m_bucketStart.clear();
+    m_entities.clear();
+    m_positions.clear();
+}
+
+} // namespace fe
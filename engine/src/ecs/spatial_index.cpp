@@ -0,0 +1,113 @@
+#include <filament_engine/ecs/spatial_index.h>
+#include <filament_engine/resources/resource_manager.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace fe {
+
+void SpatialIndex::connect(entt::registry& registry) {
+    registry.on_destroy<MeshRendererComponent>().connect<&SpatialIndex::onRendererDestroyed>(*this);
+}
+
+void SpatialIndex::onRendererDestroyed(entt::registry&, entt::entity entity) {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_records.size()) return;
+
+    auto& record = m_records[index];
+    if (record.entity != entity || record.proxy == DynamicBvh::NULL_NODE) return;
+
+    m_tree.remove(record.proxy);
+    record = Record{};
+}
+
+void SpatialIndex::update(entt::registry& registry, ChangeTracker& tracker) {
+    uint64_t since = m_changeCursor;
+    m_changeCursor = tracker.advance();
+
+    // Renderers that were waiting on their mesh
+    m_retry.swap(m_pending);
+    m_pending.clear();
+    std::sort(m_retry.begin(), m_retry.end());
+    m_retry.erase(std::unique(m_retry.begin(), m_retry.end()), m_retry.end());
+    for (auto entity : m_retry) {
+        if (registry.valid(entity)) refresh(registry, entity);
+    }
+
+    auto visit = [&](entt::entity entity) { refresh(registry, entity); };
+    tracker.forEachChanged<WorldTransformComponent>(since, visit);
+    tracker.forEachChanged<MeshRendererComponent>(since, visit);
+}
+
+void SpatialIndex::refresh(entt::registry& registry, entt::entity entity) {
+    auto* renderer = registry.try_get<MeshRendererComponent>(entity);
+    auto* world = registry.try_get<WorldTransformComponent>(entity);
+    if (!renderer || !world) return;
+
+    auto* resourceMgr = ResourceManager::getInstance();
+    const Mesh* mesh = resourceMgr && renderer->mesh.isValid() ? resourceMgr->getMesh(renderer->mesh) : nullptr;
+    if (!mesh) {
+        m_pending.push_back(entity);
+        return;
+    }
+
+    const Aabb box = transformAabb(world->matrix, {mesh->boundingBox.center, mesh->boundingBox.halfExtent});
+
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_records.size()) {
+        m_records.resize(index + 1);
+    }
+
+    auto& record = m_records[index];
+    if (record.entity == entity && record.proxy != DynamicBvh::NULL_NODE) {
+        record.box = box;
+        m_tree.move(record.proxy, box);
+        return;
+    }
+
+    // A recycled index whose previous owner left no destroy signal behind
+    if (record.proxy != DynamicBvh::NULL_NODE) {
+        m_tree.remove(record.proxy);
+    }
+    record.entity = entity;
+    record.box = box;
+    record.proxy = m_tree.insert(box, static_cast<uint32_t>(index));
+}
+
+bool SpatialIndex::raycast(const Vec3& origin, const Vec3& direction, float maxDistance, RaycastHit& hit) const {
+    const float len = length(direction);
+    if (len <= 0.0f || maxDistance <= 0.0f) return false;
+    const Vec3 dir = direction / len;
+
+    bool found = false;
+    m_tree.raycast(origin, dir, maxDistance, [&](uint32_t proxy, float maxT) {
+        const auto& record = m_records[m_tree.getUserData(proxy)];
+        const float t = intersectRayAabb(origin, dir, record.box, maxT);
+        if (t < 0.0f) return maxT;
+
+        hit.entity = record.entity;
+        hit.distance = t;
+        hit.point = origin + dir * t;
+        found = true;
+        return t;
+    });
+    return found;
+}
+
+void SpatialIndex::overlapSphere(const Vec3& center, float radius, std::vector<entt::entity>& out) const {
+    m_tree.querySphere(center, radius, [&](uint32_t proxy) {
+        const auto& record = m_records[m_tree.getUserData(proxy)];
+        if (intersectSphereAabb(center, radius, record.box)) out.push_back(record.entity);
+        return true;
+    });
+}
+
+void SpatialIndex::overlapBox(const Aabb& box, std::vector<entt::entity>& out) const {
+    m_tree.query(box, [&](uint32_t proxy) {
+        const auto& record = m_records[m_tree.getUserData(proxy)];
+        if (intersectAabbs(box, record.box)) out.push_back(record.entity);
+        return true;
+    });
+}
+
+} // namespace fe
@@ -0,0 +1,128 @@
+#include <filament_engine/ecs/system_scheduler.h>
+#include <filament_engine/ecs/world.h>
+
+#include <utils/JobSystem.h>
+
+#include <algorithm>
+
+namespace fe {
+
+// SystemAccess
+
+bool SystemAccess::intersects(const std::vector<ComponentAccess>& a, const std::vector<ComponentAccess>& b) {
+    for (const auto& lhs : a) {
+        for (const auto& rhs : b) {
+            if (lhs.id == rhs.id) return true;
+        }
+    }
+    return false;
+}
+
+bool SystemAccess::conflictsWith(const SystemAccess& other) const {
+    // Undeclared systems may touch anything
+    if (!m_declared || !other.m_declared) return true;
+
+    return intersects(m_writes, other.m_writes) ||
+           intersects(m_writes, other.m_reads) ||
+           intersects(m_reads, other.m_writes);
+}
+
+void SystemAccess::prepare(entt::registry& registry) const {
+    for (const auto& access : m_reads) access.assure(registry);
+    for (const auto& access : m_writes) access.assure(registry);
+}
+
+// SystemScheduler
+
+void SystemScheduler::build(const std::vector<std::unique_ptr<System>>& systems, bool fixedStep,
+                            bool workerOnly) {
+    m_stages.clear();
+    m_fixedStep = fixedStep;
+
+    auto scheduled = [this, fixedStep, workerOnly](const System& system) {
+        if (workerOnly && isPinned(system)) return false;
+        return fixedStep ? system.runsPerStep() : system.runsPerFrame();
+    };
+
+    // Stage of each system = one past the latest earlier system it conflicts with.
+    // Main-thread systems also go no earlier than the previous main-thread system; within
+    // a stage they run in list order, so their priority order holds across the frame.
+    std::vector<size_t> stageOf(systems.size(), 0);
+    size_t lastPinnedStage = 0;
+    for (size_t i = 0; i < systems.size(); ++i) {
+        if (!scheduled(*systems[i])) continue;
+
+        const bool pinned = isPinned(*systems[i]);
+        size_t stage = pinned ? lastPinnedStage : 0;
+        for (size_t j = 0; j < i; ++j) {
+            if (!scheduled(*systems[j])) continue;
+            if (systems[i]->access.conflictsWith(systems[j]->access)) {
+                stage = std::max(stage, stageOf[j] + 1);
+            }
+        }
+        stageOf[i] = stage;
+        if (pinned) lastPinnedStage = stage;
+
+        if (m_stages.size() <= stage) {
+            m_stages.resize(stage + 1);
+        }
+        m_stages[stage].push_back(systems[i].get());
+    }
+
+    m_dirty = false;
+    m_prepared = false;
+}
+
+void SystemScheduler::run(World& world, float dt, utils::JobSystem* jobSystem) {
+    if (!m_prepared) {
+        for (const auto& stage : m_stages) {
+            for (auto* system : stage) {
+                system->access.prepare(world.getRegistry());
+            }
+        }
+        m_prepared = true;
+    }
+
+    const bool fixedStep = m_fixedStep;
+    auto runSystem = [&world, dt, fixedStep](System* system) {
+        if (fixedStep) {
+            system->fixedUpdate(world, dt);
+        } else {
+            system->update(world, dt);
+        }
+    };
+
+    for (const auto& stage : m_stages) {
+        // Nothing to overlap: skip the job round-trip
+        bool hasWorkerSystems = std::any_of(stage.begin(), stage.end(),
+            [this](const System* system) { return !isPinned(*system); });
+        if (!jobSystem || stage.size() == 1 || !hasWorkerSystems) {
+            for (auto* system : stage) {
+                runSystem(system);
+            }
+            continue;
+        }
+
+        auto* parent = jobSystem->createJob();
+        for (auto* system : stage) {
+            if (isPinned(*system)) continue;
+
+            auto* job = jobSystem->createJob(parent,
+                [system, &runSystem](utils::JobSystem&, utils::JobSystem::Job*) {
+                    runSystem(system);
+                });
+            jobSystem->run(job);
+        }
+
+        // Main-thread systems run in priority order while the workers are busy
+        for (auto* system : stage) {
+            if (isPinned(*system)) {
+                runSystem(system);
+            }
+        }
+
+        jobSystem->runAndWait(parent);
+    }
+}
+
+} // namespace fe
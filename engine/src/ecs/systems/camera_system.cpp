@@ -15,6 +15,18 @@ namespace fe {
 void CameraSystem::update(World& world, float dt) {
     auto& registry = world.getRegistry();
     auto& renderCtx = world.getRenderContext();
+    auto& tracker = world.getChangeTracker();
+
+    // Projection only needs updating when a camera's parameters changed
+    uint64_t since = m_changeCursor;
+    m_changeCursor = tracker.advance();
+
+    bool projectionChanged = false;
+    tracker.forEachChanged<CameraComponent>(since, [&](entt::entity entity) {
+        if (registry.get<CameraComponent>(entity).isActive) {
+            projectionChanged = true;
+        }
+    });
 
     auto view = registry.view<CameraComponent, TransformComponent>();
     for (auto entity : view) {
@@ -26,11 +38,11 @@ void CameraSystem::update(World& world, float dt) {
         if (!camera) continue;
 
         // Update projection if camera params changed
-        if (cam.dirty) {
+        if (projectionChanged) {
             auto viewport = renderCtx.getView()->getViewport();
             float aspect = static_cast<float>(viewport.width) / static_cast<float>(viewport.height);
             camera->setProjection(cam.fov, aspect, cam.nearPlane, cam.farPlane);
-            cam.dirty = false;
+            projectionChanged = false;
         }
 
         // Compute forward and up vectors from the rotation quaternion
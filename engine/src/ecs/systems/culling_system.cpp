@@ -0,0 +1,341 @@
+#include <filament_engine/ecs/systems/culling_system.h>
+#include <filament_engine/ecs/world.h>
+#include <filament_engine/core/log.h>
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/ecs/parallel_for_each.h>
+#include <filament_engine/rendering/render_context.h>
+#include <filament_engine/resources/resource_manager.h>
+
+#include <filament/Camera.h>
+#include <filament/Scene.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace fe {
+
+namespace {
+
+// Renderables per occlusion test job
+constexpr uint32_t OCCLUSION_CHUNK_SIZE = 256;
+
+} // namespace
+
+void CullingSystem::init(World& world) {
+    auto& registry = world.getRegistry();
+    registry.on_destroy<BoundsComponent>().connect<&CullingSystem::onBoundsDestroyed>(*this);
+    registry.on_destroy<VisibilityCellComponent>().connect<&CullingSystem::onCellDestroyed>(*this);
+    registry.on_destroy<PortalComponent>().connect<&CullingSystem::onCellDestroyed>(*this);
+}
+
+void CullingSystem::shutdown(World& world) {
+    auto& registry = world.getRegistry();
+    registry.on_destroy<BoundsComponent>().disconnect<&CullingSystem::onBoundsDestroyed>(*this);
+    registry.on_destroy<VisibilityCellComponent>().disconnect<&CullingSystem::onCellDestroyed>(*this);
+    registry.on_destroy<PortalComponent>().disconnect<&CullingSystem::onCellDestroyed>(*this);
+}
+
+void CullingSystem::update(World& world, float dt) {
+    updateWorldBounds(world);
+    if (m_cellsDirty) rebuildCells(world);
+
+    auto* camera = world.getRenderContext().getActiveCamera();
+    if (!m_enabled || !camera) {
+        restoreAll(world);
+        return;
+    }
+
+    if (m_groupsDirty) rebuildGroups(world);
+
+    auto& registry = world.getRegistry();
+    const size_t groupCount = m_groupStart.empty() ? 0 : m_groupStart.size() - 1;
+
+    // Merged box per group; only redone when some world box moved
+    if (m_boundsDirty) {
+        m_groupBounds.clear();
+        for (size_t g = 0; g < groupCount; ++g) {
+            Aabb merged = registry.get<BoundsComponent>(m_members[m_groupStart[g]].second).world;
+            for (uint32_t i = m_groupStart[g] + 1; i < m_groupStart[g + 1]; ++i) {
+                merged = mergeAabb(merged, registry.get<BoundsComponent>(m_members[i].second).world);
+            }
+            m_groupBounds.push(merged);
+        }
+        m_boundsDirty = false;
+    }
+
+    Mat4 viewProjection = Mat4(camera->getCullingProjectionMatrix() * camera->getViewMatrix());
+    Frustum frustum = Frustum::fromMatrix(viewProjection);
+
+    m_visible.resize(groupCount);
+    m_stats = {};
+    m_stats.groups = static_cast<uint32_t>(groupCount);
+    m_stats.visibleGroups = static_cast<uint32_t>(cullAabbs(frustum, m_groupBounds, m_margin, m_visible.data()));
+    m_stats.renderables = static_cast<uint32_t>(m_members.size());
+
+    // Members inherit their group's result; cells and occlusion then drop the hidden ones
+    m_memberVisible.resize(m_members.size());
+    for (size_t g = 0; g < groupCount; ++g) {
+        std::fill(m_memberVisible.begin() + m_groupStart[g], m_memberVisible.begin() + m_groupStart[g + 1],
+                  m_visible[g]);
+    }
+    if (m_cells.getCellCount() > 0) {
+        const auto eye = camera->getPosition();
+        m_stats.cellCulledRenderables = cullByCells(world, viewProjection,
+            Vec3{static_cast<float>(eye.x), static_cast<float>(eye.y), static_cast<float>(eye.z)});
+    }
+    if (m_occlusionEnabled && rasterizeOccluders(world, viewProjection, frustum)) {
+        m_stats.occludedRenderables = cullOccluded(world);
+    }
+
+    // Only renderables whose state changed touch the scene
+    m_toAdd.clear();
+    m_toRemove.clear();
+    for (size_t i = 0; i < m_members.size(); ++i) {
+        const bool visible = m_memberVisible[i] != 0;
+        ++(visible ? m_stats.visibleRenderables : m_stats.culledRenderables);
+
+        auto entity = m_members[i].second;
+        auto& bounds = registry.get<BoundsComponent>(entity);
+        if (bounds.culled != visible) continue;
+
+        bounds.culled = !visible;
+        auto filamentEntity = registry.get<FilamentEntityComponent>(entity).filamentEntity;
+        (visible ? m_toAdd : m_toRemove).push_back(filamentEntity);
+    }
+
+    auto* scene = world.getRenderContext().getScene();
+    if (!m_toRemove.empty()) scene->removeEntities(m_toRemove.data(), m_toRemove.size());
+    if (!m_toAdd.empty()) scene->addEntities(m_toAdd.data(), m_toAdd.size());
+}
+
+void CullingSystem::bakePvs(World& world, uint32_t samplesPerAxis) {
+    updateWorldBounds(world);
+    if (m_cellsDirty) rebuildCells(world);
+    m_cells.bakePvs(samplesPerAxis);
+}
+
+void CullingSystem::rebuildCells(World& world) {
+    auto& registry = world.getRegistry();
+    m_cells.clear();
+
+    for (auto [entity, cell] : registry.view<VisibilityCellComponent>().each()) {
+        cell.index = PortalGraph::NO_CELL;
+        if (auto* worldTransform = registry.try_get<WorldTransformComponent>(entity)) {
+            cell.index = m_cells.addCell(transformAabb(worldTransform->matrix, {{0, 0, 0}, cell.halfExtent}));
+        }
+    }
+
+    auto portals = registry.view<PortalComponent, WorldTransformComponent>();
+    for (auto entity : portals) {
+        const auto& portal = portals.get<PortalComponent>(entity);
+        auto cellIndex = [&registry](entt::entity cell) {
+            auto* component = registry.valid(cell) ? registry.try_get<VisibilityCellComponent>(cell) : nullptr;
+            return component ? component->index : PortalGraph::NO_CELL;
+        };
+        const uint32_t a = cellIndex(portal.cellA);
+        const uint32_t b = cellIndex(portal.cellB);
+        if (a == PortalGraph::NO_CELL || b == PortalGraph::NO_CELL) {
+            FE_LOG_WARN("Portal ignored: cellA and cellB must be entities with a VisibilityCellComponent and a transform");
+            continue;
+        }
+
+        const Mat4& matrix = portals.get<WorldTransformComponent>(entity).matrix;
+        const Vec2 half = portal.halfSize;
+        const Vec2 local[4] = {{-half.x, -half.y}, {half.x, -half.y}, {half.x, half.y}, {-half.x, half.y}};
+        Vec3 corners[4];
+        for (int i = 0; i < 4; ++i) {
+            const Vec4 p = matrix * Vec4{local[i].x, local[i].y, 0.0f, 1.0f};
+            corners[i] = {p.x, p.y, p.z};
+        }
+        m_cells.addPortal(a, b, corners, portal.open);
+    }
+
+    // Every renderable may have changed cell
+    for (auto [entity, bounds] : registry.view<BoundsComponent>().each()) {
+        bounds.cell = findCell(registry, entity, bounds);
+    }
+    m_cellsDirty = false;
+}
+
+uint32_t CullingSystem::findCell(const entt::registry& registry, entt::entity entity, const BoundsComponent& bounds) const {
+    if (m_cells.getCellCount() == 0) return PortalGraph::NO_CELL;
+
+    // A batch may be larger than its cell: it belongs to the cell its members were keyed by
+    if (auto* batch = registry.try_get<BatchBoundsComponent>(entity)) {
+        auto* cell = registry.valid(batch->cell) ? registry.try_get<VisibilityCellComponent>(batch->cell) : nullptr;
+        return cell ? cell->index : PortalGraph::NO_CELL;
+    }
+    return m_cells.findCell(bounds.world.center);
+}
+
+uint32_t CullingSystem::cullByCells(World& world, const Mat4& viewProjection, const Vec3& eye) {
+    // From outside every cell the building is left to the frustum and occlusion stages
+    const uint32_t cameraCell = m_cells.findCell(eye);
+    if (cameraCell == PortalGraph::NO_CELL) return 0;
+
+    m_cells.computeVisibility(viewProjection, cameraCell);
+    m_stats.visibleCells = static_cast<uint32_t>(m_cells.getVisibleCellCount());
+
+    // Renderables in a visible cell must also be inside the part of the view its portals let through
+    auto& registry = world.getRegistry();
+    uint32_t hidden = 0;
+    for (size_t i = 0; i < m_members.size(); ++i) {
+        if (!m_memberVisible[i]) continue;
+        const auto& bounds = registry.get<BoundsComponent>(m_members[i].second);
+        if (bounds.cell == PortalGraph::NO_CELL) continue;
+        if (!m_cells.isCellVisible(bounds.cell) || !m_cells.getCellFrustum(bounds.cell).intersects(bounds.world)) {
+            m_memberVisible[i] = 0;
+            ++hidden;
+        }
+    }
+    return hidden;
+}
+
+bool CullingSystem::rasterizeOccluders(World& world, const Mat4& viewProjection, const Frustum& frustum) {
+    auto& registry = world.getRegistry();
+    auto* resourceMgr = ResourceManager::getInstance();
+
+    m_occlusion.begin(viewProjection);
+    auto view = registry.view<OccluderComponent, WorldTransformComponent>();
+    for (auto entity : view) {
+        auto handle = view.get<OccluderComponent>(entity).mesh;
+        if (!handle.isValid()) {
+            auto* renderer = registry.try_get<MeshRendererComponent>(entity);
+            if (renderer) handle = renderer->mesh;
+        }
+
+        // Skipped until the mesh is loaded; meshes without CPU data cannot occlude
+        const Mesh* mesh = resourceMgr && handle.isValid() ? resourceMgr->getMesh(handle) : nullptr;
+        if (!mesh || mesh->vertices.empty()) continue;
+
+        const Mat4& matrix = view.get<WorldTransformComponent>(entity).matrix;
+        const Aabb local{mesh->boundingBox.center, mesh->boundingBox.halfExtent};
+        if (!frustum.intersects(transformAabb(matrix, local))) continue;
+
+        m_occlusion.addOccluder(matrix, &mesh->vertices[0].position.x, sizeof(MeshVertex), mesh->vertices.size(),
+                                mesh->indices.data(), mesh->indices.size());
+        ++m_stats.occluders;
+    }
+    if (m_stats.occluders == 0) return false;
+
+    parallelFor(world.getJobSystem(), m_occlusion.getBandCount(), 1, [this](uint32_t begin, uint32_t end) {
+        for (uint32_t band = begin; band < end; ++band) m_occlusion.rasterizeBand(band);
+    });
+    return true;
+}
+
+uint32_t CullingSystem::cullOccluded(World& world) {
+    auto& registry = world.getRegistry();
+    const auto& bounds = registry.storage<BoundsComponent>();
+    const auto& occluders = registry.storage<OccluderComponent>();
+
+    // Occluders are never hidden by themselves or each other
+    std::atomic<uint32_t> occluded{0};
+    parallelFor(world.getJobSystem(), static_cast<uint32_t>(m_members.size()), OCCLUSION_CHUNK_SIZE,
+        [&](uint32_t begin, uint32_t end) {
+            uint32_t count = 0;
+            for (uint32_t i = begin; i < end; ++i) {
+                auto entity = m_members[i].second;
+                if (!m_memberVisible[i] || occluders.contains(entity)) continue;
+                if (m_occlusion.isOccluded(bounds.get(entity).world)) {
+                    m_memberVisible[i] = 0;
+                    ++count;
+                }
+            }
+            occluded.fetch_add(count, std::memory_order_relaxed);
+        });
+    return occluded.load(std::memory_order_relaxed);
+}
+
+void CullingSystem::updateWorldBounds(World& world) {
+    auto& registry = world.getRegistry();
+    auto& tracker = world.getChangeTracker();
+
+    uint64_t since = m_changeCursor;
+    m_changeCursor = tracker.advance();
+
+    auto refresh = [&](entt::entity entity) {
+        if (registry.any_of<VisibilityCellComponent, PortalComponent>(entity)) m_cellsDirty = true;
+
+        auto* bounds = registry.try_get<BoundsComponent>(entity);
+        if (!bounds) return;
+
+        // Batch cull records have no transform: their box is already in world space
+        auto* worldTransform = registry.try_get<WorldTransformComponent>(entity);
+        if (worldTransform) {
+            bounds->world = transformAabb(worldTransform->matrix, bounds->local);
+        } else if (registry.all_of<BatchBoundsComponent>(entity)) {
+            bounds->world = bounds->local;
+        } else {
+            return;
+        }
+        bounds->cell = findCell(registry, entity, *bounds);
+        m_boundsDirty = true;
+
+        // Reparenting marks the whole subtree's world transform as changed, so the root is
+        // re-resolved for every renderable whose grouping could have moved
+        auto root = entity;
+        for (auto* node = registry.try_get<HierarchyComponent>(root);
+             node && node->parent != entt::null;
+             node = registry.try_get<HierarchyComponent>(root)) {
+            root = node->parent;
+        }
+        if (bounds->root != root) {
+            bounds->root = root;
+            m_groupsDirty = true;
+        }
+    };
+    tracker.forEachChanged<WorldTransformComponent>(since, refresh);
+    tracker.forEachChanged<BoundsComponent>(since, refresh);
+
+    auto cellChanged = [this](entt::entity) { m_cellsDirty = true; };
+    tracker.forEachChanged<VisibilityCellComponent>(since, cellChanged);
+    tracker.forEachChanged<PortalComponent>(since, cellChanged);
+}
+
+void CullingSystem::rebuildGroups(World& world) {
+    auto& registry = world.getRegistry();
+
+    m_members.clear();
+    auto view = registry.view<BoundsComponent, FilamentEntityComponent>();
+    for (auto entity : view) {
+        const auto& bounds = view.get<BoundsComponent>(entity);
+        m_members.emplace_back(bounds.root == entt::null ? entity : bounds.root, entity);
+    }
+    std::sort(m_members.begin(), m_members.end());
+
+    m_groupStart.clear();
+    for (uint32_t i = 0; i < m_members.size(); ++i) {
+        if (i == 0 || m_members[i].first != m_members[i - 1].first) {
+            m_groupStart.push_back(i);
+        }
+    }
+    m_groupStart.push_back(static_cast<uint32_t>(m_members.size()));
+
+    m_groupsDirty = false;
+    m_boundsDirty = true;
+}
+
+void CullingSystem::restoreAll(World& world) {
+    auto& registry = world.getRegistry();
+    auto view = registry.view<BoundsComponent, FilamentEntityComponent>();
+
+    if (m_stats.culledRenderables > 0) {
+        m_toAdd.clear();
+        for (auto entity : view) {
+            auto& bounds = view.get<BoundsComponent>(entity);
+            if (!bounds.culled) continue;
+            bounds.culled = false;
+            m_toAdd.push_back(view.get<FilamentEntityComponent>(entity).filamentEntity);
+        }
+        if (!m_toAdd.empty()) {
+            world.getRenderContext().getScene()->addEntities(m_toAdd.data(), m_toAdd.size());
+        }
+    }
+
+    m_stats = {};
+    m_stats.renderables = static_cast<uint32_t>(view.size_hint());
+    m_stats.visibleRenderables = m_stats.renderables;
+}
+
+} // namespace fe
@@ -119,7 +119,7 @@ void EditorCameraSystem::update(World& world, float dt) {
             transform.position += movement * speed * dt;
         }
 
-        transform.dirty = true;
+        registry.patch<TransformComponent>(entity);
         break; // only process the first active camera
     }
 }
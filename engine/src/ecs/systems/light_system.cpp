@@ -3,6 +3,7 @@
 #include <filament_engine/ecs/components.h>
 #include <filament_engine/rendering/render_context.h>
 
+#include <filament/Camera.h>
 #include <filament/LightManager.h>
 #include <filament/Scene.h>
 
@@ -17,73 +18,147 @@ static filament::LightManager::Type toFilamentLightType(LightComponent::Type typ
     return filament::LightManager::Type::POINT;
 }
 
+// Light direction is the world-space -Z axis of the entity
+static Vec3 worldDirection(const Mat4& world) {
+    return normalize(world.upperLeft() * Vec3{0, 0, -1});
+}
+
+static Vec3 worldPosition(const Mat4& world) {
+    return world[3].xyz;
+}
+
 void LightSystem::update(World& world, float dt) {
     auto& registry = world.getRegistry();
-    auto& bridge = world.getEntityBridge();
+    auto& tracker = world.getChangeTracker();
     auto& renderCtx = world.getRenderContext();
     auto* engine = renderCtx.getEngine();
-    auto* scene = renderCtx.getScene();
     auto& lightMgr = renderCtx.getLightManager();
 
-    auto view = registry.view<LightComponent, TransformComponent, FilamentEntityComponent>();
-    for (auto entity : view) {
-        auto& light = view.get<LightComponent>(entity);
-        auto& transform = view.get<TransformComponent>(entity);
-        auto& fec = view.get<FilamentEntityComponent>(entity);
-        auto filamentEntity = fec.filamentEntity;
-
-        if (!light.initialized) {
-            // Create the Filament light on first encounter
-            auto builder = filament::LightManager::Builder(toFilamentLightType(light.type))
-                .color({light.color.x, light.color.y, light.color.z})
-                .intensity(light.intensity)
-                .castShadows(light.castShadows);
-
-            if (light.type == LightComponent::Type::Directional) {
-                auto rotationMat = filament::math::mat3f(transform.rotation);
-                Vec3 direction = rotationMat * Vec3{0, 0, -1};
-                builder.direction(direction);
+    // Only lights whose parameters or world transform changed since our last run are touched
+    uint64_t since = m_changeCursor;
+    m_changeCursor = tracker.advance();
+
+    auto syncLight = [&](entt::entity entity) {
+        auto* light = registry.try_get<LightComponent>(entity);
+        auto* fec = registry.try_get<FilamentEntityComponent>(entity);
+        auto* worldTransform = registry.try_get<WorldTransformComponent>(entity);
+        if (!light || !fec || !worldTransform) return;
+
+        auto filamentEntity = fec->filamentEntity;
+        const Mat4& matrix = worldTransform->matrix;
+
+        if (!light->initialized) {
+            // Create the Filament light on first encounter; the budget decides whether it
+            // enters the scene and whether it gets a shadow map
+            auto builder = filament::LightManager::Builder(toFilamentLightType(light->type))
+                .color({light->color.x, light->color.y, light->color.z})
+                .intensity(light->intensity)
+                .castShadows(false);
+
+            if (light->type == LightComponent::Type::Directional ||
+                light->type == LightComponent::Type::Spot) {
+                builder.direction(worldDirection(matrix));
             }
 
-            if (light.type == LightComponent::Type::Point ||
-                light.type == LightComponent::Type::Spot) {
-                builder.falloff(light.radius);
+            if (light->type == LightComponent::Type::Point ||
+                light->type == LightComponent::Type::Spot) {
+                builder.position(worldPosition(matrix));
+                builder.falloff(light->radius);
             }
 
-            if (light.type == LightComponent::Type::Spot) {
-                builder.spotLightCone(light.innerConeAngle, light.outerConeAngle);
+            if (light->type == LightComponent::Type::Spot) {
+                builder.spotLightCone(light->innerConeAngle, light->outerConeAngle);
             }
 
             builder.build(*engine, filamentEntity);
 
-            // Add to scene
-            scene->addEntity(filamentEntity);
-
-            light.initialized = true;
-        } else {
-            // Continuously update light properties every frame (after first initialization)
-            auto instance = lightMgr.getInstance(filamentEntity);
-            if (!instance.isValid()) continue;
-
-            // Update direction from transform rotation (for directional and spot lights)
-            if (light.type == LightComponent::Type::Directional ||
-                light.type == LightComponent::Type::Spot) {
-                auto rotationMat = filament::math::mat3f(transform.rotation);
-                Vec3 direction = rotationMat * Vec3{0, 0, -1};
-                lightMgr.setDirection(instance, direction);
-            }
+            light->initialized = true;
+            return;
+        }
 
-            // Update position for point/spot lights
-            if (light.type == LightComponent::Type::Point ||
-                light.type == LightComponent::Type::Spot) {
-                lightMgr.setPosition(instance, transform.position);
-            }
+        auto instance = lightMgr.getInstance(filamentEntity);
+        if (!instance.isValid()) return;
+
+        // Update direction from world rotation (for directional and spot lights)
+        if (light->type == LightComponent::Type::Directional ||
+            light->type == LightComponent::Type::Spot) {
+            lightMgr.setDirection(instance, worldDirection(matrix));
+        }
+
+        // Update position for point/spot lights
+        if (light->type == LightComponent::Type::Point ||
+            light->type == LightComponent::Type::Spot) {
+            lightMgr.setPosition(instance, worldPosition(matrix));
+        }
+
+        // Update color and intensity
+        lightMgr.setColor(instance, {light->color.x, light->color.y, light->color.z});
+        lightMgr.setIntensity(instance, light->intensity);
+    };
 
-            // Update color and intensity
-            lightMgr.setColor(instance, {light.color.x, light.color.y, light.color.z});
-            lightMgr.setIntensity(instance, light.intensity);
+    tracker.forEachChanged<LightComponent>(since, syncLight);
+    tracker.forEachChanged<WorldTransformComponent>(since, syncLight);
+
+    applyBudget(world);
+}
+
+void LightSystem::applyBudget(World& world) {
+    auto& registry = world.getRegistry();
+    auto& renderCtx = world.getRenderContext();
+    auto& lightMgr = renderCtx.getLightManager();
+
+    m_candidates.clear();
+    auto view = registry.view<LightComponent, WorldTransformComponent>();
+    for (auto [entity, light, worldTransform] : view.each()) {
+        if (!light.initialized) continue;
+
+        LightCandidate candidate;
+        candidate.entity = entity;
+        candidate.type = light.type;
+        candidate.position = worldPosition(worldTransform.matrix);
+        candidate.color = light.color;
+        candidate.intensity = light.intensity;
+        candidate.radius = light.radius;
+        candidate.castShadows = light.castShadows;
+        candidate.wasActive = light.active;
+        candidate.wasShadowCaster = light.shadowActive;
+        m_candidates.push_back(candidate);
+    }
+
+    // Rank against the active camera (brightness only without one)
+    Vec3 viewPosition{0, 0, 0};
+    Frustum frustum;
+    const Frustum* viewFrustum = nullptr;
+    if (auto* camera = renderCtx.getActiveCamera()) {
+        auto position = camera->getPosition();
+        viewPosition = {static_cast<float>(position.x), static_cast<float>(position.y), static_cast<float>(position.z)};
+        frustum = Frustum::fromMatrix(Mat4(camera->getCullingProjectionMatrix() * camera->getViewMatrix()));
+        viewFrustum = &frustum;
+    }
+    m_budget.select(m_candidates, viewPosition, viewFrustum);
+
+    // Only lights whose selection changed touch the scene or the light manager
+    m_toAdd.clear();
+    m_toRemove.clear();
+    for (const auto& candidate : m_candidates) {
+        auto& light = registry.get<LightComponent>(candidate.entity);
+        auto* fec = registry.try_get<FilamentEntityComponent>(candidate.entity);
+        if (!fec) continue;
+
+        if (candidate.active != light.active) {
+            (candidate.active ? m_toAdd : m_toRemove).push_back(fec->filamentEntity);
+            light.active = candidate.active;
+        }
+        if (candidate.shadowCaster != light.shadowActive) {
+            auto instance = lightMgr.getInstance(fec->filamentEntity);
+            if (instance.isValid()) lightMgr.setShadowCaster(instance, candidate.shadowCaster);
+            light.shadowActive = candidate.shadowCaster;
         }
     }
+
+    auto* scene = renderCtx.getScene();
+    if (!m_toRemove.empty()) scene->removeEntities(m_toRemove.data(), m_toRemove.size());
+    if (!m_toAdd.empty()) scene->addEntities(m_toAdd.data(), m_toAdd.size());
 }
 
 } // namespace fe
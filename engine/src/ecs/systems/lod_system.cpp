@@ -0,0 +1,140 @@
+#include <filament_engine/ecs/systems/lod_system.h>
+#include <filament_engine/ecs/world.h>
+#include <filament_engine/rendering/render_context.h>
+#include <filament_engine/resources/resource_manager.h>
+
+#include <filament/Camera.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace fe {
+
+float LODSystem::screenSize(float radius, float distance, float projectionScale) {
+    // Inside the sphere the object covers the whole view
+    if (distance <= radius) return std::numeric_limits<float>::max();
+    return radius * projectionScale / distance;
+}
+
+uint32_t LODSystem::selectLevel(const LODGroupComponent& group, float screenSize, uint32_t current) {
+    const auto count = static_cast<uint32_t>(group.levels.size());
+    if (count == 0) return 0;
+
+    // First level whose threshold the size reaches; the last level is the fallback
+    auto levelFor = [&](float size) {
+        for (uint32_t i = 0; i + 1 < count; ++i) {
+            if (size >= group.levels[i].screenSize) return i;
+        }
+        return count - 1;
+    };
+
+    // Going coarser needs the object to be smaller than the threshold by the band, going
+    // finer needs it to be larger by the band
+    const uint32_t coarser = levelFor(screenSize * (1.0f + group.hysteresis));
+    const uint32_t finer = levelFor(screenSize * (1.0f - group.hysteresis));
+    current = std::min(current, count - 1);
+    if (coarser > current) return coarser;
+    if (finer < current) return finer;
+    return current;
+}
+
+void LODSystem::update(World& world, float dt) {
+    auto& registry = world.getRegistry();
+    resolveBounds(world);
+
+    m_switchCount = 0;
+    auto* camera = world.getRenderContext().getActiveCamera();
+    if (!camera) return;
+
+    const auto position = camera->getPosition();
+    const Vec3 eye{static_cast<float>(position.x), static_cast<float>(position.y), static_cast<float>(position.z)};
+    const float projectionScale = static_cast<float>(camera->getCullingProjectionMatrix()[1][1]);
+
+    auto& groups = registry.storage<LODGroupComponent>();
+    m_switched.resize(groups.size());
+    m_switchedCount.store(0, std::memory_order_relaxed);
+
+    // Each job only writes its own groups; switches are appended through an atomic cursor
+    auto select = [&](entt::entity entity, LODGroupComponent& group, const WorldTransformComponent& worldTransform) {
+        if (group.localRadius < 0.0f || group.levels.size() < 2) return;
+
+        const Mat4& m = worldTransform.matrix;
+        const Vec3 center = (m * Vec4(group.localCenter, 1.0f)).xyz;
+        const float scale = std::sqrt(std::max({dot(m[0].xyz, m[0].xyz), dot(m[1].xyz, m[1].xyz),
+                                                dot(m[2].xyz, m[2].xyz)}));
+        const float size = screenSize(group.localRadius * scale, length(center - eye), projectionScale);
+
+        group.target = selectLevel(group, size, group.current);
+        if (group.target != group.current) {
+            m_switched[m_switchedCount.fetch_add(1, std::memory_order_relaxed)] = entity;
+        }
+    };
+    if (auto* jobSystem = world.getJobSystem()) {
+        parallelForEach<LODGroupComponent, WorldTransformComponent>(*jobSystem, registry, select);
+    } else {
+        for (auto [entity, group, worldTransform] : registry.view<LODGroupComponent, WorldTransformComponent>().each()) {
+            select(entity, group, worldTransform);
+        }
+    }
+
+    // Apply the switches; RenderSyncSystem picks up the mesh change
+    m_switchCount = m_switchedCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < m_switchCount; ++i) {
+        const auto entity = m_switched[i];
+        auto& group = registry.get<LODGroupComponent>(entity);
+        auto* renderer = registry.try_get<MeshRendererComponent>(entity);
+        auto* mobility = registry.try_get<StaticComponent>(entity);
+        if (!renderer || (mobility && mobility->batch != StaticComponent::NO_BATCH)) continue;
+
+        group.current = group.target;
+        const auto mesh = group.levels[group.current].mesh;
+        if (renderer->mesh != mesh) {
+            registry.patch<MeshRendererComponent>(entity, [mesh](MeshRendererComponent& r) { r.mesh = mesh; });
+        }
+    }
+}
+
+void LODSystem::resolveBounds(World& world) {
+    auto& registry = world.getRegistry();
+    auto& tracker = world.getChangeTracker();
+
+    uint64_t since = m_changeCursor;
+    m_changeCursor = tracker.advance();
+    tracker.forEachChanged<LODGroupComponent>(since, [this](entt::entity entity) {
+        m_unresolved.push_back(entity);
+    });
+    if (m_unresolved.empty()) return;
+
+    std::sort(m_unresolved.begin(), m_unresolved.end());
+    m_unresolved.erase(std::unique(m_unresolved.begin(), m_unresolved.end()), m_unresolved.end());
+
+    // The sphere around the most detailed mesh bounds every level
+    auto* resourceMgr = ResourceManager::getInstance();
+    auto stillUnresolved = m_unresolved.begin();
+    for (auto entity : m_unresolved) {
+        auto* group = registry.valid(entity) ? registry.try_get<LODGroupComponent>(entity) : nullptr;
+        if (!group || group->levels.empty()) continue;
+
+        const Mesh* mesh = resourceMgr && group->levels[0].mesh.isValid()
+            ? resourceMgr->getMesh(group->levels[0].mesh) : nullptr;
+        if (!mesh) {
+            *stillUnresolved++ = entity;
+            continue;
+        }
+        group->localCenter = mesh->boundingBox.center;
+        group->localRadius = length(mesh->boundingBox.halfExtent);
+        group->current = std::min(group->current, static_cast<uint32_t>(group->levels.size() - 1));
+        group->target = group->current;
+
+        // Start from the current level's mesh whatever the renderer was created with
+        const auto levelMesh = group->levels[group->current].mesh;
+        auto* renderer = registry.try_get<MeshRendererComponent>(entity);
+        if (renderer && renderer->mesh != levelMesh) {
+            registry.patch<MeshRendererComponent>(entity, [levelMesh](MeshRendererComponent& r) { r.mesh = levelMesh; });
+        }
+    }
+    m_unresolved.erase(stillUnresolved, m_unresolved.end());
+}
+
+} // namespace fe
@@ -1,55 +1,206 @@
 #include <filament_engine/ecs/systems/render_sync_system.h>
 #include <filament_engine/ecs/world.h>
 #include <filament_engine/ecs/components.h>
+#include <filament_engine/ecs/material_override.h>
 #include <filament_engine/rendering/render_context.h>
 #include <filament_engine/resources/resource_manager.h>
 
 #include <filament/RenderableManager.h>
 #include <filament/Scene.h>
 
+#include <algorithm>
+
 namespace fe {
 
+void RenderSyncSystem::init(World& world) {
+    m_batcher.connect(world.getRegistry());
+    world.getRegistry().on_destroy<MaterialOverrideComponent>()
+        .connect<&RenderSyncSystem::onOverrideRemoved>(*this);
+}
+
+void RenderSyncSystem::shutdown(World& world) {
+    world.getRegistry().on_destroy<MaterialOverrideComponent>()
+        .disconnect<&RenderSyncSystem::onOverrideRemoved>(*this);
+    m_batcher.disconnect(world.getRegistry());
+    m_batcher.destroyAll(world);
+}
+
 void RenderSyncSystem::update(World& world, float dt) {
+    auto& tracker = world.getChangeTracker();
+
+    // Candidates: renderers that changed since our last run, plus the ones still waiting
+    // on a mesh/material from previous frames
+    auto& registry = world.getRegistry();
+    uint64_t since = m_changeCursor;
+    m_changeCursor = tracker.advance();
+    tracker.forEachChanged<MeshRendererComponent>(since, [&](entt::entity entity) {
+        const auto& renderer = registry.get<MeshRendererComponent>(entity);
+        if (renderer.initialized && renderer.builtMesh != renderer.mesh.getId()) {
+            m_meshChanged.push_back(entity);
+        } else {
+            m_pending.push_back(entity);
+        }
+    });
+
+    // A different material instance can move a renderer to another batch: rebuild it
+    tracker.forEachChanged<MaterialOverrideComponent>(since, [this](entt::entity entity) {
+        m_overrideChanged.push_back(entity);
+    });
+    for (auto entity : m_overrideChanged) {
+        teardown(world, entity);
+    }
+    m_overrideChanged.clear();
+
+    // A new mesh (e.g. an LOD switch) is swapped into an own renderable in place;
+    // instanced renderers are rebuilt into the batch of their new mesh
+    for (auto entity : m_meshChanged) {
+        if (!swapGeometry(world, entity)) {
+            teardown(world, entity);
+        }
+    }
+    m_meshChanged.clear();
+
+    if (!m_pending.empty()) {
+        buildPending(world);
+    }
+
+    // Instance transforms and batch rebuilds
+    m_batcher.update(world);
+
+    // Renderables no longer point at released override instances
+    if (auto* resourceMgr = ResourceManager::getInstance()) {
+        resourceMgr->getMaterialInstancePool().collectGarbage();
+    }
+}
+
+void RenderSyncSystem::teardown(World& world, entt::entity entity) {
+    auto& registry = world.getRegistry();
+    if (!registry.valid(entity)) return;
+
+    auto* meshRenderer = registry.try_get<MeshRendererComponent>(entity);
+    if (!meshRenderer || !meshRenderer->initialized) return;
+
+    // Static batches handle their own members (StaticBatchSystem re-claims them on changes)
+    auto* mobility = registry.try_get<StaticComponent>(entity);
+    if (mobility && mobility->batch != StaticComponent::NO_BATCH) return;
+
+    m_batcher.remove(registry, entity);
+    if (auto* fec = registry.try_get<FilamentEntityComponent>(entity)) {
+        auto& rcm = world.getRenderContext().getEngine()->getRenderableManager();
+        if (rcm.hasComponent(fec->filamentEntity)) {
+            world.getRenderContext().getScene()->remove(fec->filamentEntity);
+            rcm.destroy(fec->filamentEntity);
+            registry.remove<BoundsComponent>(entity);
+        }
+    }
+
+    meshRenderer->initialized = false;
+    m_pending.push_back(entity);
+}
+
+bool RenderSyncSystem::swapGeometry(World& world, entt::entity entity) {
+    auto& registry = world.getRegistry();
+    if (!registry.valid(entity)) return true;
+
+    auto* meshRenderer = registry.try_get<MeshRendererComponent>(entity);
+    if (!meshRenderer || !meshRenderer->initialized) return true;
+
+    // Static batches rebuild their merged geometry: StaticBatchSystem re-claims changed members
+    auto* mobility = registry.try_get<StaticComponent>(entity);
+    if (mobility && mobility->batch != StaticComponent::NO_BATCH) return true;
+
+    // The instancing key includes the mesh
+    if (meshRenderer->batch != MeshRendererComponent::NO_BATCH ||
+        meshRenderer->batchKey != MeshRendererComponent::NO_BATCH) return false;
+
+    auto* resourceMgr = ResourceManager::getInstance();
+    auto* fec = registry.try_get<FilamentEntityComponent>(entity);
+    const Mesh* mesh = resourceMgr && meshRenderer->mesh.isValid() ? resourceMgr->getMesh(meshRenderer->mesh) : nullptr;
+    if (!mesh || !fec) return false;
+
+    auto& rcm = world.getRenderContext().getEngine()->getRenderableManager();
+    auto instance = rcm.getInstance(fec->filamentEntity);
+    if (!instance) return false;
+
+    rcm.setGeometryAt(instance, 0, filament::RenderableManager::PrimitiveType::TRIANGLES,
+                      mesh->vertexBuffer, mesh->indexBuffer, 0, mesh->indexCount);
+    rcm.setAxisAlignedBoundingBox(instance, mesh->boundingBox);
+    meshRenderer->builtMesh = meshRenderer->mesh.getId();
+
+    if (registry.all_of<BoundsComponent>(entity)) {
+        registry.patch<BoundsComponent>(entity, [mesh](BoundsComponent& bounds) {
+            bounds.local = {mesh->boundingBox.center, mesh->boundingBox.halfExtent};
+        });
+    }
+    return true;
+}
+
+void RenderSyncSystem::buildPending(World& world) {
     auto& registry = world.getRegistry();
-    auto& bridge = world.getEntityBridge();
     auto& renderCtx = world.getRenderContext();
     auto* engine = renderCtx.getEngine();
     auto* scene = renderCtx.getScene();
 
-    auto view = registry.view<MeshRendererComponent, FilamentEntityComponent>();
-    for (auto entity : view) {
-        auto& meshRenderer = view.get<MeshRendererComponent>(entity);
-        if (meshRenderer.initialized) continue;
-        if (!meshRenderer.mesh.isValid() || !meshRenderer.material.isValid()) continue;
+    std::sort(m_pending.begin(), m_pending.end());
+    m_pending.erase(std::unique(m_pending.begin(), m_pending.end()), m_pending.end());
 
-        auto& fec = view.get<FilamentEntityComponent>(entity);
-        auto filamentEntity = fec.filamentEntity;
+    auto* resourceMgr = ResourceManager::getInstance();
 
-        // Get the actual mesh and material from ResourceManager
-        auto* resourceMgr = ResourceManager::getInstance();
-        if (!resourceMgr) continue;
+    auto stillPending = m_pending.begin();
+    for (auto entity : m_pending) {
+        auto* meshRenderer = registry.try_get<MeshRendererComponent>(entity);
+        auto* fec = registry.try_get<FilamentEntityComponent>(entity);
+        if (!meshRenderer || !fec || meshRenderer->initialized) continue;
 
-        auto* mesh = resourceMgr->getMesh(meshRenderer.mesh);
-        auto* material = resourceMgr->getMaterial(meshRenderer.material);
-        if (!mesh || !material) continue;
+        // Keep waiting until the handles are set and the resources are loaded
+        Mesh* mesh = nullptr;
+        MaterialWrapper* material = nullptr;
+        if (resourceMgr && meshRenderer->mesh.isValid() && meshRenderer->material.isValid()) {
+            mesh = resourceMgr->getMesh(meshRenderer->mesh);
+            material = resourceMgr->getMaterial(meshRenderer->material);
+        }
+        if (!mesh || !material) {
+            *stillPending++ = entity;
+            continue;
+        }
+
+        // Per-entity parameters map to a shared instance from the pool
+        filament::MaterialInstance* materialInstance = material->getInstance();
+        uint32_t overrideInstance = 0;
+        if (auto* override = registry.try_get<MaterialOverrideComponent>(entity)) {
+            if (auto* pooled = resolveMaterialOverride(*override, meshRenderer->material)) {
+                materialInstance = pooled;
+                overrideInstance = override->instance;
+            }
+        }
+
+        // Renderers sharing mesh/material with enough others become instances of one renderable
+        meshRenderer->initialized = true;
+        meshRenderer->builtMesh = meshRenderer->mesh.getId();
+        if (m_batcher.add(world, entity, *meshRenderer, *mesh, overrideInstance)) continue;
+
+        auto filamentEntity = fec->filamentEntity;
 
         // Build the Filament renderable
         filament::RenderableManager::Builder(1)
             .boundingBox(mesh->boundingBox)
-            .material(0, material->getInstance())
+            .material(0, materialInstance)
             .geometry(0, filament::RenderableManager::PrimitiveType::TRIANGLES,
                       mesh->vertexBuffer, mesh->indexBuffer,
                       0, mesh->indexCount)
-            .culling(false)
-            .receiveShadows(meshRenderer.receiveShadows)
-            .castShadows(meshRenderer.castShadows)
+            .culling(true)
+            .receiveShadows(meshRenderer->receiveShadows)
+            .castShadows(meshRenderer->castShadows)
             .build(*engine, filamentEntity);
 
+        // Local bounds for the engine-side cull (world bounds follow from the world matrix)
+        registry.emplace_or_replace<BoundsComponent>(entity, BoundsComponent{
+            {mesh->boundingBox.center, mesh->boundingBox.halfExtent}, {}});
+
         // Add to scene
         scene->addEntity(filamentEntity);
-
-        meshRenderer.initialized = true;
     }
+    m_pending.erase(stillPending, m_pending.end());
 }
 
 } // namespace fe
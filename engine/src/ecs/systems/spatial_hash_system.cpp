@@ -0,0 +1,22 @@
+#include <filament_engine/ecs/systems/spatial_hash_system.h>
+#include <filament_engine/ecs/world.h>
+
+namespace fe {
+
+void SpatialHashSystem::update(World& world, float dt) {
+    auto view = world.getRegistry().view<WorldTransformComponent, SpatialHashComponent>();
+
+    m_entities.clear();
+    m_positions.clear();
+    m_entities.reserve(view.size_hint());
+    m_positions.reserve(view.size_hint());
+    for (auto [entity, worldTransform] : view.each()) {
+        const auto& m = worldTransform.matrix;
+        m_entities.push_back(entity);
+        m_positions.push_back({m[3][0], m[3][1], m[3][2]});
+    }
+
+    m_hash.build(m_entities, m_positions, world.getJobSystem());
+}
+
+} // namespace fe
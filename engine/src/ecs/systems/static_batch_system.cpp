@@ -0,0 +1,306 @@
+#include <filament_engine/ecs/systems/static_batch_system.h>
+#include <filament_engine/ecs/batch_bounds.h>
+#include <filament_engine/ecs/world.h>
+#include <filament_engine/ecs/components.h>
+#include <filament_engine/ecs/material_override.h>
+#include <filament_engine/math/frustum.h>
+#include <filament_engine/rendering/render_context.h>
+#include <filament_engine/resources/resource_manager.h>
+
+#include <filament/Engine.h>
+#include <filament/IndexBuffer.h>
+#include <filament/RenderableManager.h>
+#include <filament/Scene.h>
+#include <filament/VertexBuffer.h>
+
+#include <utils/EntityManager.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace fe {
+
+void StaticBatchSystem::init(World& world) {
+    connect(world.getRegistry());
+}
+
+void StaticBatchSystem::connect(entt::registry& registry) {
+    registry.on_destroy<StaticComponent>().connect<&StaticBatchSystem::onStaticRemoved>(*this);
+    registry.on_destroy<MeshRendererComponent>().connect<&StaticBatchSystem::onMemberRemoved>(*this);
+    registry.on_destroy<MaterialOverrideComponent>().connect<&StaticBatchSystem::onOverrideRemoved>(*this);
+    registry.on_destroy<VisibilityCellComponent>().connect<&StaticBatchSystem::onCellRemoved>(*this);
+}
+
+void StaticBatchSystem::disconnect(entt::registry& registry) {
+    registry.on_destroy<StaticComponent>().disconnect<&StaticBatchSystem::onStaticRemoved>(*this);
+    registry.on_destroy<MeshRendererComponent>().disconnect<&StaticBatchSystem::onMemberRemoved>(*this);
+    registry.on_destroy<MaterialOverrideComponent>().disconnect<&StaticBatchSystem::onOverrideRemoved>(*this);
+    registry.on_destroy<VisibilityCellComponent>().disconnect<&StaticBatchSystem::onCellRemoved>(*this);
+}
+
+void StaticBatchSystem::shutdown(World& world) {
+    disconnect(world.getRegistry());
+
+    auto* scene = world.getRenderContext().getScene();
+    for (auto& batch : m_batches) {
+        releaseGeometry(world, batch);
+        destroyBatchBounds(world.getRegistry(), batch.cullRecord);
+        if (batch.renderable.isNull()) continue;
+        if (batch.inScene) scene->remove(batch.renderable);
+        utils::EntityManager::get().destroy(batch.renderable);
+    }
+    m_batches.clear();
+    m_keys.clear();
+}
+
+void StaticBatchSystem::update(World& world, float dt) {
+    auto& registry = world.getRegistry();
+    auto& tracker = world.getChangeTracker();
+
+    uint64_t since = m_changeCursor;
+    m_changeCursor = tracker.advance();
+
+    // New static renderers (either component may arrive last)
+    auto queue = [&](entt::entity entity) {
+        if (registry.all_of<StaticComponent, MeshRendererComponent>(entity)) {
+            m_pending.push_back(entity);
+        }
+    };
+    tracker.forEachChanged<StaticComponent>(since, queue);
+
+    // Members that moved or changed mesh, material or shadow flags leave their batch and are
+    // claimed again (RenderSyncSystem leaves batched members to us)
+    auto requeueMember = [&](entt::entity entity) { requeue(registry, entity); };
+    tracker.forEachChanged<MeshRendererComponent>(since, [&](entt::entity entity) {
+        requeue(registry, entity);
+        queue(entity);
+    });
+    tracker.forEachChanged<WorldTransformComponent>(since, [&](entt::entity entity) {
+        if (registry.all_of<VisibilityCellComponent>(entity)) m_cellsChanged = true;
+        requeue(registry, entity);
+    });
+    tracker.forEachChanged<MaterialOverrideComponent>(since, requeueMember);
+
+    // Batches are keyed by visibility cell: a new, moved or removed cell re-buckets everything
+    tracker.forEachChanged<VisibilityCellComponent>(since, [this](entt::entity) { m_cellsChanged = true; });
+    if (m_cellsChanged) {
+        for (auto& batch : m_batches) {
+            while (!batch.members.empty()) requeue(registry, batch.members.back());
+        }
+        m_cellsChanged = false;
+    }
+
+    if (!m_pending.empty()) {
+        std::sort(m_pending.begin(), m_pending.end());
+        m_pending.erase(std::unique(m_pending.begin(), m_pending.end()), m_pending.end());
+
+        auto* resourceMgr = ResourceManager::getInstance();
+        auto stillPending = m_pending.begin();
+        for (auto entity : m_pending) {
+            if (!registry.valid(entity)) continue;
+            auto* renderer = registry.try_get<MeshRendererComponent>(entity);
+            auto* mobility = registry.try_get<StaticComponent>(entity);
+            if (!renderer || !mobility || renderer->initialized ||
+                mobility->batch != StaticComponent::NO_BATCH) continue;
+
+            const Mesh* mesh = nullptr;
+            if (resourceMgr && renderer->mesh.isValid() && renderer->material.isValid() &&
+                resourceMgr->getMaterial(renderer->material)) {
+                mesh = resourceMgr->getMesh(renderer->mesh);
+            }
+            if (!mesh) {
+                *stillPending++ = entity; // resources not loaded yet
+                continue;
+            }
+            if (mesh->vertices.empty()) continue; // no CPU geometry: RenderSyncSystem builds it
+
+            claim(world, entity);
+        }
+        m_pending.erase(stillPending, m_pending.end());
+    }
+
+    for (auto& batch : m_batches) {
+        if (batch.dirty) rebuild(world, batch);
+    }
+}
+
+void StaticBatchSystem::claim(World& world, entt::entity entity) {
+    auto& registry = world.getRegistry();
+    auto& renderer = registry.get<MeshRendererComponent>(entity);
+    const Mesh* mesh = ResourceManager::getInstance()->getMesh(renderer.mesh);
+
+    // Bucket by the cell containing the world-space center of the renderer's bounds
+    Aabb bounds = transformAabb(registry.get<WorldTransformComponent>(entity).matrix,
+                                {mesh->boundingBox.center, mesh->boundingBox.halfExtent});
+    IVec3 cell{static_cast<int>(std::floor(bounds.center.x / m_cellSize)),
+               static_cast<int>(std::floor(bounds.center.y / m_cellSize)),
+               static_cast<int>(std::floor(bounds.center.z / m_cellSize))};
+    uint32_t overrideInstance = 0;
+    if (auto* override = registry.try_get<MaterialOverrideComponent>(entity)) {
+        if (resolveMaterialOverride(*override, renderer.material)) overrideInstance = override->instance;
+    }
+    insert(registry, entity, {renderer.material.getId(), overrideInstance,
+                              (renderer.castShadows ? 1u : 0u) | (renderer.receiveShadows ? 2u : 0u), cell,
+                              findVisibilityCell(registry, bounds.center)});
+}
+
+void StaticBatchSystem::insert(entt::registry& registry, entt::entity entity, const Key& key) {
+    auto [it, inserted] = m_keys.try_emplace(key, static_cast<uint32_t>(m_batches.size()));
+    if (inserted) {
+        m_batches.emplace_back().key = key;
+    }
+
+    auto& batch = m_batches[it->second];
+    auto& mobility = registry.get<StaticComponent>(entity);
+    mobility.batch = it->second;
+    mobility.batchSlot = static_cast<uint32_t>(batch.members.size());
+    batch.members.push_back(entity);
+    batch.dirty = true;
+    registry.get<MeshRendererComponent>(entity).initialized = true; // RenderSyncSystem must not build its own renderable
+}
+
+void StaticBatchSystem::onStaticRemoved(entt::registry& registry, entt::entity entity) {
+    auto& mobility = registry.get<StaticComponent>(entity);
+    if (mobility.batch == StaticComponent::NO_BATCH) return;
+    remove(registry, entity, mobility);
+
+    // The renderer is no longer drawn by the batch: hand it back to RenderSyncSystem. If the
+    // entity is being destroyed, the renderer's own removal forgets this change again.
+    if (registry.all_of<MeshRendererComponent>(entity)) {
+        registry.patch<MeshRendererComponent>(entity, [](MeshRendererComponent& renderer) {
+            renderer.initialized = false;
+        });
+    }
+}
+
+void StaticBatchSystem::onMemberRemoved(entt::registry& registry, entt::entity entity) {
+    auto* mobility = registry.try_get<StaticComponent>(entity);
+    if (mobility && mobility->batch != StaticComponent::NO_BATCH) {
+        remove(registry, entity, *mobility);
+    }
+}
+
+void StaticBatchSystem::onOverrideRemoved(entt::registry& registry, entt::entity entity) {
+    requeue(registry, entity);
+}
+
+void StaticBatchSystem::requeue(entt::registry& registry, entt::entity entity) {
+    auto* mobility = registry.try_get<StaticComponent>(entity);
+    if (!mobility || mobility->batch == StaticComponent::NO_BATCH) return;
+
+    remove(registry, entity, *mobility);
+    if (auto* renderer = registry.try_get<MeshRendererComponent>(entity)) {
+        renderer->initialized = false;
+        m_pending.push_back(entity);
+    }
+}
+
+void StaticBatchSystem::remove(entt::registry& registry, entt::entity entity, StaticComponent& mobility) {
+    auto& batch = m_batches[mobility.batch];
+    const uint32_t slot = mobility.batchSlot;
+    batch.members[slot] = batch.members.back();
+    batch.members.pop_back();
+    if (slot < batch.members.size()) {
+        registry.get<StaticComponent>(batch.members[slot]).batchSlot = slot;
+    }
+    mobility.batch = StaticComponent::NO_BATCH;
+    batch.dirty = true;
+}
+
+void StaticBatchSystem::rebuild(World& world, Batch& batch) {
+    auto& registry = world.getRegistry();
+    auto* engine = world.getRenderContext().getEngine();
+    auto* scene = world.getRenderContext().getScene();
+    auto* resourceMgr = ResourceManager::getInstance();
+
+    releaseGeometry(world, batch);
+    batch.dirty = false;
+
+    auto* material = resourceMgr->getMaterial(ResourceHandle<MaterialWrapper>(batch.key.material));
+    filament::MaterialInstance* materialInstance = nullptr;
+    if (material) {
+        materialInstance = batch.key.overrideInstance
+            ? resourceMgr->getMaterialInstancePool().getInstance(batch.key.overrideInstance)
+            : material->getInstance();
+    }
+    if (batch.members.empty() || !materialInstance) {
+        destroyBatchBounds(registry, batch.cullRecord);
+        if (batch.inScene) {
+            scene->remove(batch.renderable);
+            batch.inScene = false;
+        }
+        return;
+    }
+
+    // Concatenate every member's geometry, baked into world space
+    m_vertices.clear();
+    m_indices.clear();
+    for (auto entity : batch.members) {
+        const auto& renderer = registry.get<MeshRendererComponent>(entity);
+        const Mesh* mesh = resourceMgr->getMesh(renderer.mesh);
+        if (!mesh) continue;
+
+        const Mat4& matrix = registry.get<WorldTransformComponent>(entity).matrix;
+        const Mat3 normalMatrix = transpose(inverse(matrix.upperLeft()));
+        const auto base = static_cast<uint32_t>(m_vertices.size());
+
+        for (const auto& v : mesh->vertices) {
+            m_vertices.push_back({(matrix * Vec4(v.position, 1.0f)).xyz,
+                                  normalize(normalMatrix * v.normal), v.uv});
+        }
+        for (auto index : mesh->indices) {
+            m_indices.push_back(base + index);
+        }
+    }
+
+    batch.mesh = Mesh::create(*engine, m_vertices, m_indices, false);
+
+    if (batch.renderable.isNull()) {
+        batch.renderable = utils::EntityManager::get().create();
+    }
+    filament::RenderableManager::Builder(1)
+        .boundingBox(batch.mesh.boundingBox)
+        .material(0, materialInstance)
+        .geometry(0, filament::RenderableManager::PrimitiveType::TRIANGLES,
+                  batch.mesh.vertexBuffer, batch.mesh.indexBuffer,
+                  0, batch.mesh.indexCount)
+        .culling(true)
+        .castShadows((batch.key.shadowFlags & 1u) != 0)
+        .receiveShadows((batch.key.shadowFlags & 2u) != 0)
+        .build(*engine, batch.renderable);
+    batch.cullRecord = updateBatchBounds(registry, batch.cullRecord, batch.renderable,
+                                         {batch.mesh.boundingBox.center, batch.mesh.boundingBox.halfExtent},
+                                         batch.key.visibilityCell);
+
+    if (!batch.inScene) {
+        scene->addEntity(batch.renderable);
+        batch.inScene = true;
+    }
+}
+
+void StaticBatchSystem::releaseGeometry(World& world, Batch& batch) {
+    auto* engine = world.getRenderContext().getEngine();
+    auto& rcm = engine->getRenderableManager();
+    if (!batch.renderable.isNull() && rcm.hasComponent(batch.renderable)) {
+        rcm.destroy(batch.renderable);
+    }
+    if (batch.mesh.vertexBuffer) engine->destroy(batch.mesh.vertexBuffer);
+    if (batch.mesh.indexBuffer) engine->destroy(batch.mesh.indexBuffer);
+    batch.mesh = Mesh{};
+}
+
+size_t StaticBatchSystem::getBatchCount() const {
+    size_t count = 0;
+    for (const auto& batch : m_batches) {
+        if (!batch.members.empty()) ++count;
+    }
+    return count;
+}
+
+size_t StaticBatchSystem::getMemberCount() const {
+    size_t count = 0;
+    for (const auto& batch : m_batches) count += batch.members.size();
+    return count;
+}
+
+} // namespace fe
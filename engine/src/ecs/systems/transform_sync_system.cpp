@@ -5,65 +5,121 @@
 
 #include <filament/TransformManager.h>
 
-#include <math/mat4.h>
-#include <math/vec3.h>
-#include <math/quat.h>
-
 namespace fe {
 
-// Builds a model matrix from position, rotation, and scale
-static Mat4 composeTransform(const Vec3& position, const Quat& rotation, const Vec3& scale) {
-    // Scale matrix
-    Mat4 s = Mat4::scaling(scale);
+namespace {
+
+// Component-wise blend of two world matrices. Not a true rotation interpolation, but within
+// one simulation step rotations are small enough for the difference to be invisible.
+Mat4 blend(const Mat4& from, const Mat4& to, float alpha) {
+    Mat4 result;
+    for (int column = 0; column < 4; ++column) {
+        result[column] = from[column] + (to[column] - from[column]) * alpha;
+    }
+    return result;
+}
+
+// The hierarchy lives on the engine side: Filament only sees world matrices on root instances
+void pushTransform(const entt::registry& registry, filament::TransformManager& tcm,
+                   entt::entity entity, const Mat4& matrix) {
+    if (!registry.valid(entity)) return;
+
+    // Batched static geometry is baked in world space; there is nothing to update in Filament
+    if (auto* mobility = registry.try_get<StaticComponent>(entity);
+        mobility && mobility->batch != StaticComponent::NO_BATCH) return;
 
-    // Rotation matrix from quaternion
-    Mat4 r = Mat4(filament::math::mat3f(rotation));
+    auto* fec = registry.try_get<FilamentEntityComponent>(entity);
+    if (!fec) return;
 
-    // Translation matrix
-    Mat4 t = Mat4::translation(position);
+    auto instance = tcm.getInstance(fec->filamentEntity);
+    if (!instance.isValid()) return;
+
+    tcm.setTransform(instance, matrix);
+}
+
+} // namespace
+
+void TransformSyncSystem::fixedUpdate(World& world, float step) {
+    // Motions of the previous step end on their final matrix, unless the entity moves again
+    for (const auto& motion : m_motions) {
+        m_motionSlot[static_cast<size_t>(entt::to_entity(motion.entity))] = NO_MOTION;
+        m_pending.push_back(motion.entity);
+    }
+    m_motions.clear();
 
-    return t * r * s;
+    // Without fixed stepping there is one step per frame and nothing to interpolate
+    propagate(world, world.isFixedStepping());
 }
 
 void TransformSyncSystem::update(World& world, float dt) {
     auto& registry = world.getRegistry();
-    auto& bridge = world.getEntityBridge();
     auto& tcm = world.getRenderContext().getTransformManager();
 
+    // Transforms edited since the last step
+    propagate(world, false);
+    if (m_pending.empty() && m_motions.empty()) return;
+
     // Open a transaction for efficient batch updates
     tcm.openLocalTransformTransaction();
 
-    auto view = registry.view<TransformComponent, FilamentEntityComponent>();
-    for (auto entity : view) {
-        auto& transform = view.get<TransformComponent>(entity);
-        if (!transform.dirty) continue;
-
-        auto& fec = view.get<FilamentEntityComponent>(entity);
-        auto instance = tcm.getInstance(fec.filamentEntity);
-        if (!instance.isValid()) continue;
-
-        // Compose the local transform matrix
-        Mat4 localTransform = composeTransform(
-            transform.position, transform.rotation, transform.scale);
-
-        tcm.setTransform(instance, localTransform);
-
-        // Handle parent-child relationships
-        if (transform.parent != entt::null && registry.valid(transform.parent)) {
-            auto parentFilament = bridge.getFilamentEntity(registry, transform.parent);
-            if (!parentFilament.isNull()) {
-                auto parentInstance = tcm.getInstance(parentFilament);
-                if (parentInstance.isValid()) {
-                    tcm.setParent(instance, parentInstance);
-                }
-            }
-        }
+    for (auto entity : m_pending) {
+        if (!registry.valid(entity) || findMotion(entity) != NO_MOTION) continue;
+        pushTransform(registry, tcm, entity, registry.get<WorldTransformComponent>(entity).matrix);
+    }
+    m_pending.clear();
 
-        transform.dirty = false;
+    const float alpha = world.getInterpolationAlpha();
+    for (const auto& motion : m_motions) {
+        pushTransform(registry, tcm, motion.entity, blend(motion.from, motion.to, alpha));
     }
 
     // Commit the transaction: world transforms are now valid
     tcm.commitLocalTransformTransaction();
 }
 
+void TransformSyncSystem::propagate(World& world, bool recordMotion) {
+    auto& registry = world.getRegistry();
+    auto& tracker = world.getChangeTracker();
+
+    // Only transforms changed since our last run are visited
+    uint64_t since = m_changeCursor;
+    m_changeCursor = tracker.advance();
+
+    m_dirty.clear();
+    tracker.forEachChanged<TransformComponent>(since, [this](entt::entity entity) {
+        m_dirty.push_back(entity);
+    });
+
+    // Recompute cached world matrices for the dirty subtrees
+    m_changed.clear();
+    m_previous.clear();
+    world.getTransformHierarchy().update(registry, m_dirty, m_changed, recordMotion ? &m_previous : nullptr);
+
+    for (size_t i = 0; i < m_changed.size(); ++i) {
+        const auto entity = m_changed[i];
+        tracker.markChanged<WorldTransformComponent>(entity);
+        const Mat4& matrix = registry.get<WorldTransformComponent>(entity).matrix;
+
+        if (recordMotion) {
+            const auto index = static_cast<size_t>(entt::to_entity(entity));
+            if (index >= m_motionSlot.size()) m_motionSlot.resize(index + 1, NO_MOTION);
+            m_motionSlot[index] = static_cast<uint32_t>(m_motions.size());
+            m_motions.push_back({entity, m_previous[i], matrix});
+        } else if (uint32_t slot = findMotion(entity); slot != NO_MOTION) {
+            // Moved outside the step (a teleport): snap instead of blending
+            m_motions[slot].from = matrix;
+            m_motions[slot].to = matrix;
+        } else {
+            m_pending.push_back(entity);
+        }
+    }
+}
+
+uint32_t TransformSyncSystem::findMotion(entt::entity entity) const {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_motionSlot.size()) return NO_MOTION;
+    const uint32_t slot = m_motionSlot[index];
+    return slot != NO_MOTION && m_motions[slot].entity == entity ? slot : NO_MOTION;
+}
+
 } // namespace fe
@@ -0,0 +1,236 @@
+#include <filament_engine/ecs/transform_hierarchy.h>
+#include <filament_engine/core/log.h>
+
+#include <math/mat3.h>
+#include <math/mat4.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace fe {
+
+Mat4 TransformHierarchy::composeLocal(const TransformComponent& transform) {
+    Mat4 s = Mat4::scaling(transform.scale);
+    Mat4 r = Mat4(filament::math::mat3f(transform.rotation));
+    Mat4 t = Mat4::translation(transform.position);
+    return t * r * s;
+}
+
+bool TransformHierarchy::setParent(entt::registry& registry, entt::entity child, entt::entity parent) {
+    auto& node = registry.get<HierarchyComponent>(child);
+    if (node.parent == parent) return true;
+
+    // Reject cycles: the new parent must not be the child or one of its descendants
+    for (auto ancestor = parent; ancestor != entt::null;
+         ancestor = registry.get<HierarchyComponent>(ancestor).parent) {
+        if (ancestor == child) {
+            FE_LOG_WARN("setParent rejected: would create a cycle in the transform hierarchy");
+            return false;
+        }
+    }
+
+    unlinkFromParent(registry, child, node);
+
+    uint32_t depth = 0;
+    if (parent != entt::null) {
+        auto& parentNode = registry.get<HierarchyComponent>(parent);
+        node.parent = parent;
+        node.nextSibling = parentNode.firstChild;
+        if (parentNode.firstChild != entt::null) {
+            registry.get<HierarchyComponent>(parentNode.firstChild).prevSibling = child;
+        }
+        parentNode.firstChild = child;
+        depth = parentNode.depth + 1;
+    }
+    setSubtreeDepth(registry, child, depth);
+
+    // The world matrix of the whole subtree changes with the new parent
+    m_pendingDirty.push_back(child);
+    m_orderDirty = true;
+    return true;
+}
+
+void TransformHierarchy::connect(entt::registry& registry) {
+    registry.on_destroy<HierarchyComponent>().connect<&TransformHierarchy::onDestroy>(*this);
+}
+
+void TransformHierarchy::onDestroy(entt::registry& registry, entt::entity entity) {
+    auto* node = registry.try_get<HierarchyComponent>(entity);
+    if (!node) return;
+
+    unlinkFromParent(registry, entity, *node);
+
+    // Orphaned children become roots and keep their local transform as world transform
+    auto child = node->firstChild;
+    while (child != entt::null) {
+        auto& childNode = registry.get<HierarchyComponent>(child);
+        auto next = childNode.nextSibling;
+        childNode.parent = entt::null;
+        childNode.prevSibling = entt::null;
+        childNode.nextSibling = entt::null;
+        setSubtreeDepth(registry, child, 0);
+        m_pendingDirty.push_back(child);
+        child = next;
+    }
+    node->firstChild = entt::null;
+
+    // Destroying swaps the last element of each storage into the hole
+    m_orderDirty = true;
+}
+
+void TransformHierarchy::update(entt::registry& registry, const std::vector<entt::entity>& dirty,
+                                std::vector<entt::entity>& changed, std::vector<Mat4>* previous) {
+    // Pass counter lets children see "parent recomputed this pass" without a separate flag
+    if (++m_pass == 0) m_pass = 1;
+
+    m_roots.clear();
+    for (auto entity : dirty) collectDirty(registry, entity);
+    for (auto entity : m_pendingDirty) collectDirty(registry, entity);
+    m_pendingDirty.clear();
+    if (m_roots.empty()) return;
+
+    // Walking subtrees is O(changed); past a quarter of the hierarchy a linear pass is cheaper
+    if (m_roots.size() * 4 >= registry.storage<HierarchyComponent>().size()) {
+        updateLinear(registry, changed, previous);
+    } else {
+        updateSubtrees(registry, changed, previous);
+    }
+}
+
+void TransformHierarchy::collectDirty(entt::registry& registry, entt::entity entity) {
+    if (!registry.valid(entity) || !registry.all_of<TransformComponent, HierarchyComponent>(entity)) return;
+
+    auto* world = registry.try_get<WorldTransformComponent>(entity);
+    if (!world || world->dirtyPass == m_pass) return;
+
+    world->dirtyPass = m_pass;
+    m_roots.push_back(entity);
+}
+
+void TransformHierarchy::updateSubtrees(entt::registry& registry, std::vector<entt::entity>& changed,
+                                        std::vector<Mat4>* previous) {
+    // Shallowest first, so a dirty ancestor covers its dirty descendants
+    std::sort(m_roots.begin(), m_roots.end(), [&registry](entt::entity lhs, entt::entity rhs) {
+        return registry.get<HierarchyComponent>(lhs).depth < registry.get<HierarchyComponent>(rhs).depth;
+    });
+
+    m_order.clear();
+    for (auto root : m_roots) {
+        if (registry.get<WorldTransformComponent>(root).updatedPass == m_pass) continue;
+
+        // Pre-order DFS: every entity lands in m_order after its parent
+        m_stack.clear();
+        m_stack.push_back(root);
+        while (!m_stack.empty()) {
+            auto entity = m_stack.back();
+            m_stack.pop_back();
+
+            registry.get<WorldTransformComponent>(entity).updatedPass = m_pass;
+            m_order.push_back(entity);
+
+            const auto& node = registry.get<HierarchyComponent>(entity);
+            for (auto child = node.firstChild; child != entt::null;
+                 child = registry.get<HierarchyComponent>(child).nextSibling) {
+                m_stack.push_back(child);
+            }
+        }
+    }
+    recomputeOrdered(registry, changed, previous);
+}
+
+void TransformHierarchy::updateLinear(entt::registry& registry, std::vector<entt::entity>& changed,
+                                      std::vector<Mat4>* previous) {
+    if (m_orderDirty) {
+        sortByDepth(registry);
+    }
+
+    m_order.clear();
+    auto view = registry.view<HierarchyComponent>();
+    for (auto [entity, node] : view.each()) {
+        auto* world = registry.try_get<WorldTransformComponent>(entity);
+        if (!world || !registry.all_of<TransformComponent>(entity)) continue;
+
+        bool parentMoved = node.parent != entt::null &&
+            registry.get<WorldTransformComponent>(node.parent).updatedPass == m_pass;
+        if (world->dirtyPass != m_pass && !parentMoved) continue;
+
+        world->updatedPass = m_pass;
+        m_order.push_back(entity);
+    }
+    recomputeOrdered(registry, changed, previous);
+}
+
+void TransformHierarchy::recomputeOrdered(entt::registry& registry, std::vector<entt::entity>& changed,
+                                          std::vector<Mat4>* previous) {
+    const size_t count = m_order.size();
+
+    // Local matrices do not depend on the parent: compose them all in one vectorized batch
+    m_locals.resize(count);
+    m_soa.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto& transform = registry.get<TransformComponent>(m_order[i]);
+        m_soa.set(i, transform.position, transform.rotation, transform.scale);
+    }
+    composeTransforms(m_soa, m_locals.data());
+
+    // Parents precede their children in m_order, so their world matrix is already final
+    for (size_t i = 0; i < count; ++i) {
+        auto entity = m_order[i];
+        const auto& node = registry.get<HierarchyComponent>(entity);
+        auto& world = registry.get<WorldTransformComponent>(entity);
+        if (previous) previous->push_back(world.matrix);
+        if (node.parent != entt::null) {
+            world.matrix = registry.get<WorldTransformComponent>(node.parent).matrix * m_locals[i];
+        } else {
+            world.matrix = m_locals[i];
+        }
+        changed.push_back(entity);
+    }
+}
+
+void TransformHierarchy::unlinkFromParent(entt::registry& registry, entt::entity entity, HierarchyComponent& node) {
+    if (node.parent == entt::null) return;
+
+    if (node.prevSibling != entt::null) {
+        registry.get<HierarchyComponent>(node.prevSibling).nextSibling = node.nextSibling;
+    } else {
+        registry.get<HierarchyComponent>(node.parent).firstChild = node.nextSibling;
+    }
+    if (node.nextSibling != entt::null) {
+        registry.get<HierarchyComponent>(node.nextSibling).prevSibling = node.prevSibling;
+    }
+
+    node.parent = entt::null;
+    node.prevSibling = entt::null;
+    node.nextSibling = entt::null;
+}
+
+void TransformHierarchy::setSubtreeDepth(entt::registry& registry, entt::entity entity, uint32_t depth) {
+    // Iterative DFS: deep hierarchies must not blow the stack
+    std::vector<std::pair<entt::entity, uint32_t>> stack{{entity, depth}};
+    while (!stack.empty()) {
+        auto [current, currentDepth] = stack.back();
+        stack.pop_back();
+
+        auto& node = registry.get<HierarchyComponent>(current);
+        node.depth = currentDepth;
+        for (auto child = node.firstChild; child != entt::null;
+             child = registry.get<HierarchyComponent>(child).nextSibling) {
+            stack.emplace_back(child, currentDepth + 1);
+        }
+    }
+}
+
+void TransformHierarchy::sortByDepth(entt::registry& registry) {
+    registry.sort<HierarchyComponent>([](const HierarchyComponent& lhs, const HierarchyComponent& rhs) {
+        return lhs.depth < rhs.depth;
+    });
+
+    // Keep the transform storages in the same order for sequential access
+    registry.sort<TransformComponent, HierarchyComponent>();
+    registry.sort<WorldTransformComponent, HierarchyComponent>();
+
+    m_orderDirty = false;
+}
+
+} // namespace fe
@@ -1,5 +1,6 @@
 #include <filament_engine/ecs/world.h>
 #include <filament_engine/ecs/scene.h>
+#include <filament_engine/ecs/material_override.h>
 #include <filament_engine/rendering/render_context.h>
 #include <filament_engine/core/log.h>
 
@@ -7,10 +8,35 @@
 #include <filament/RenderableManager.h>
 #include <filament/LightManager.h>
 
+#include <utils/JobSystem.h>
+
 namespace fe {
 
 World::World(RenderContext& renderContext, Input& input, InputMap& inputMap)
     : m_renderContext(renderContext), m_input(input), m_inputMap(inputMap) {
+    // Components the built-in sync systems consume incrementally
+    m_changeTracker.track<TransformComponent>(m_registry);
+    m_changeTracker.track<WorldTransformComponent>(m_registry);
+    m_changeTracker.track<MeshRendererComponent>(m_registry);
+    m_changeTracker.track<BoundsComponent>(m_registry);
+    m_changeTracker.track<StaticComponent>(m_registry);
+    m_changeTracker.track<MaterialOverrideComponent>(m_registry);
+    m_changeTracker.track<CameraComponent>(m_registry);
+    m_changeTracker.track<LightComponent>(m_registry);
+    m_changeTracker.track<LODGroupComponent>(m_registry);
+    m_changeTracker.track<VisibilityCellComponent>(m_registry);
+    m_changeTracker.track<PortalComponent>(m_registry);
+
+    m_hierarchy.connect(m_registry);
+    m_nameIndex.connect(m_registry);
+    m_spatialIndex.connect(m_registry);
+
+    // Scene member lists stay consistent however an entity leaves its scene
+    m_registry.on_destroy<SceneMembershipComponent>().connect<&Scene::onMembershipDestroyed>();
+
+    // Pooled material instances are reference counted by their override components
+    m_registry.on_destroy<MaterialOverrideComponent>().connect<&releaseMaterialOverride>();
+
     FE_LOG_INFO("World created");
 }
 
@@ -59,9 +85,11 @@ World::~World() {
 Entity World::createEntity(const std::string& name) {
     auto entity = m_registry.create();
 
-    // Every entity gets a tag and transform by default
-    m_registry.emplace<TagComponent>(entity, name);
+    // Every entity gets a tag, transform and hierarchy node by default
+    m_registry.emplace<TagComponent>(entity, Name(name));
     m_registry.emplace<TransformComponent>(entity);
+    m_registry.emplace<HierarchyComponent>(entity);
+    m_registry.emplace<WorldTransformComponent>(entity);
 
     // Create the Filament entity and link it
     m_entityBridge.link(m_registry, entity);
@@ -74,6 +102,84 @@ Entity World::createEntity(const std::string& name) {
     return Entity(entity, this);
 }
 
+void World::createEntities(std::span<entt::entity> out, Name name) {
+    const size_t count = out.size();
+    if (count == 0) return;
+
+    m_registry.create(out.begin(), out.end());
+
+    // Grow every default storage once instead of per entity
+    m_registry.storage<TagComponent>().reserve(m_registry.storage<TagComponent>().size() + count);
+    m_registry.storage<TransformComponent>().reserve(m_registry.storage<TransformComponent>().size() + count);
+    m_registry.storage<HierarchyComponent>().reserve(m_registry.storage<HierarchyComponent>().size() + count);
+    m_registry.storage<WorldTransformComponent>().reserve(m_registry.storage<WorldTransformComponent>().size() + count);
+    m_registry.storage<FilamentEntityComponent>().reserve(m_registry.storage<FilamentEntityComponent>().size() + count);
+
+    m_registry.insert<TagComponent>(out.begin(), out.end(), TagComponent{name});
+    m_registry.insert<TransformComponent>(out.begin(), out.end());
+    m_registry.insert<HierarchyComponent>(out.begin(), out.end());
+    m_registry.insert<WorldTransformComponent>(out.begin(), out.end());
+
+    // Filament entities in one batch, then their TransformManager components
+    m_createdFilamentEntities.resize(count);
+    m_entityBridge.linkRange(m_registry, out, m_createdFilamentEntities);
+
+    auto& tcm = m_renderContext.getTransformManager();
+    for (auto filamentEntity : m_createdFilamentEntities) {
+        tcm.create(filamentEntity);
+    }
+}
+
+std::span<const entt::entity> World::createEntities(size_t count, Name name) {
+    m_createdEntities.resize(count);
+    createEntities(std::span<entt::entity>(m_createdEntities), name);
+    return m_createdEntities;
+}
+
+std::span<const entt::entity> World::instantiate(const Prefab& prefab, size_t count,
+                                                std::span<const TransformComponent> rootTransforms) {
+    if (!rootTransforms.empty() && rootTransforms.size() != count) {
+        FE_LOG_WARN("instantiate: %zu root transforms for %zu copies, ignoring them",
+                    rootTransforms.size(), count);
+        rootTransforms = {};
+    }
+
+    const size_t nodeCount = prefab.getNodeCount();
+    m_instantiated.resize(nodeCount * count);
+    if (count == 0) return {};
+
+    auto nodeEntities = [this, count](size_t node) {
+        return std::span<entt::entity>(m_instantiated.data() + node * count, count);
+    };
+
+    // One bulk create and one range insert per component type, per node
+    for (uint32_t node = 0; node < nodeCount; ++node) {
+        auto entities = nodeEntities(node);
+        createEntities(entities, prefab.getName(node));
+        prefab.applyComponents(node, m_registry, entities);
+    }
+
+    // Creation already logged these transforms as changed, so plain assignment is enough
+    if (!rootTransforms.empty()) {
+        auto roots = nodeEntities(Prefab::ROOT);
+        auto& transforms = m_registry.storage<TransformComponent>();
+        for (size_t i = 0; i < count; ++i) {
+            transforms.get(roots[i]) = rootTransforms[i];
+        }
+    }
+
+    // Link copy i of every child to copy i of its parent
+    for (uint32_t node = 1; node < nodeCount; ++node) {
+        auto children = nodeEntities(node);
+        auto parents = nodeEntities(prefab.getParent(node));
+        for (size_t i = 0; i < count; ++i) {
+            m_hierarchy.setParent(m_registry, children[i], parents[i]);
+        }
+    }
+
+    return nodeEntities(Prefab::ROOT);
+}
+
 void World::destroyEntity(entt::entity entity) {
     if (!m_registry.valid(entity)) return;
 
@@ -113,10 +219,141 @@ void World::destroyEntity(Entity entity) {
     destroyEntity(entity.getHandle());
 }
 
+void World::destroyEntities(std::span<const entt::entity> entities) {
+    // Valid handles are copied out first: `entities` may be a list the teardown edits
+    m_destroyedEntities.clear();
+    m_destroyedLinked.clear();
+    m_destroyedFilamentEntities.clear();
+    for (auto entity : entities) {
+        if (!m_registry.valid(entity)) continue;
+        m_destroyedEntities.push_back(entity);
+
+        if (auto* fec = m_registry.try_get<FilamentEntityComponent>(entity)) {
+            m_destroyedLinked.push_back(entity);
+            m_destroyedFilamentEntities.push_back(fec->filamentEntity);
+        }
+    }
+    if (m_destroyedEntities.empty()) return;
+
+    if (!m_destroyedFilamentEntities.empty()) {
+        // One scene removal, then one pass per component manager
+        m_renderContext.getScene()->removeEntities(m_destroyedFilamentEntities.data(),
+                                                   m_destroyedFilamentEntities.size());
+
+        auto& rcm = m_renderContext.getRenderableManager();
+        for (auto filamentEntity : m_destroyedFilamentEntities) {
+            if (rcm.hasComponent(filamentEntity)) rcm.destroy(filamentEntity);
+        }
+
+        auto& lcm = m_renderContext.getLightManager();
+        for (auto filamentEntity : m_destroyedFilamentEntities) {
+            if (lcm.hasComponent(filamentEntity)) lcm.destroy(filamentEntity);
+        }
+
+        auto& tcm = m_renderContext.getTransformManager();
+        for (auto filamentEntity : m_destroyedFilamentEntities) {
+            if (tcm.hasComponent(filamentEntity)) tcm.destroy(filamentEntity);
+        }
+    }
+
+    // Bulk unlink: one EntityManager call for all Filament entities
+    m_entityBridge.unlinkRange(m_registry, m_destroyedLinked, m_destroyedFilamentEntities);
+
+    m_registry.destroy(m_destroyedEntities.begin(), m_destroyedEntities.end());
+}
+
+entt::entity World::findByName(std::string_view name) const {
+    // Name::find does not intern, so probing unknown names never grows the table
+    Name key = Name::find(name);
+    return key.empty() ? entt::entity{entt::null} : m_nameIndex.find(key);
+}
+
+std::vector<entt::entity> World::findAllByName(std::string_view name) const {
+    std::vector<entt::entity> result;
+    Name key = Name::find(name);
+    if (!key.empty()) {
+        m_nameIndex.findAll(key, result);
+    }
+    return result;
+}
+
+bool World::setParent(entt::entity child, entt::entity parent) {
+    return m_hierarchy.setParent(m_registry, child, parent);
+}
+
+entt::entity World::getParent(entt::entity entity) const {
+    return m_registry.get<HierarchyComponent>(entity).parent;
+}
+
+const Mat4& World::getWorldMatrix(entt::entity entity) const {
+    return m_registry.get<WorldTransformComponent>(entity).matrix;
+}
+
+void World::fixedUpdateSystems(float step) {
+    // Pipelined, this is a worker: playback and pinned systems wait for finishPipelinedSteps()
+    if (!m_pipelined) {
+        flushCommands();
+    }
+
+    if (!m_parallelSystems) {
+        for (auto& system : m_systems) {
+            if (!system->runsPerStep() || (m_pipelined && system->access.isMainThreadStep())) continue;
+            system->fixedUpdate(*this, step);
+        }
+    } else {
+        if (m_fixedScheduler.isDirty()) {
+            m_fixedScheduler.build(m_systems, true, m_pipelined);
+        }
+        m_fixedScheduler.run(*this, step, getJobSystem());
+    }
+
+    if (m_pipelined) {
+        ++m_deferredSteps;
+        m_deferredStep = step;
+        return;
+    }
+    flushCommands();
+}
+
+void World::setPipelined(bool enabled) {
+    m_pipelined = enabled;
+    m_fixedScheduler.invalidate();
+}
+
+void World::finishPipelinedSteps() {
+    flushCommands();
+
+    for (; m_deferredSteps > 0; --m_deferredSteps) {
+        for (auto& system : m_systems) {
+            if (system->runsPerStep() && system->access.isMainThreadStep()) {
+                system->fixedUpdate(*this, m_deferredStep);
+            }
+        }
+    }
+
+    flushCommands();
+}
+
 void World::updateSystems(float dt) {
-    for (auto& system : m_systems) {
-        system->update(*this, dt);
+    // Structural changes recorded since the last frame (e.g. from jobs started in onUpdate)
+    flushCommands();
+
+    if (!m_parallelSystems) {
+        for (auto& system : m_systems) {
+            if (system->runsPerFrame()) system->update(*this, dt);
+        }
+    } else {
+        if (m_scheduler.isDirty()) {
+            m_scheduler.build(m_systems);
+        }
+        m_scheduler.run(*this, dt, getJobSystem());
     }
+
+    // Changes recorded by the systems themselves, applied once every stage has finished
+    flushCommands();
+
+    // Spatial queries see the state at the end of the frame
+    updateSpatialIndex();
 }
 
 void World::shutdownSystems() {
@@ -124,6 +361,13 @@ void World::shutdownSystems() {
         system->shutdown(*this);
     }
     m_systems.clear();
+    m_scheduler.invalidate();
+    m_fixedScheduler.invalidate();
+}
+
+utils::JobSystem* World::getJobSystem() const {
+    auto* engine = m_renderContext.getEngine();
+    return engine ? &engine->getJobSystem() : nullptr;
 }
 
 // Scene management
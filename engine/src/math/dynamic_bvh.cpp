@@ -0,0 +1,301 @@
+#include <filament_engine/math/dynamic_bvh.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace fe {
+
+namespace {
+
+float surfaceArea(const Vec3& lo, const Vec3& hi) {
+    const Vec3 d = hi - lo;
+    return d.x * d.y + d.y * d.z + d.z * d.x; // half the area: only relative costs matter
+}
+
+} // namespace
+
+float intersectRayAabb(const Vec3& origin, const Vec3& direction, const Aabb& box, float maxDistance) {
+    const Vec3 lo = box.center - box.halfExtent;
+    const Vec3 hi = box.center + box.halfExtent;
+    float tmin = 0.0f;
+    float tmax = maxDistance;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (std::abs(direction[axis]) < 1e-12f) {
+            // Parallel to the slab: inside it or no hit at all
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis]) return -1.0f;
+            continue;
+        }
+        const float inv = 1.0f / direction[axis];
+        float t1 = (lo[axis] - origin[axis]) * inv;
+        float t2 = (hi[axis] - origin[axis]) * inv;
+        if (t1 > t2) std::swap(t1, t2);
+        tmin = std::max(tmin, t1);
+        tmax = std::min(tmax, t2);
+        if (tmin > tmax) return -1.0f;
+    }
+    return tmin;
+}
+
+bool intersectSphereAabb(const Vec3& center, float radius, const Aabb& box) {
+    const Vec3 offset = center - box.center;
+    const Vec3 clamped = min(max(offset, Vec3{0, 0, 0} - box.halfExtent), box.halfExtent);
+    const Vec3 d = offset - clamped;
+    return dot(d, d) <= radius * radius;
+}
+
+bool intersectAabbs(const Aabb& a, const Aabb& b) {
+    const Vec3 d = a.center - b.center;
+    const Vec3 extent = a.halfExtent + b.halfExtent;
+    return std::abs(d.x) <= extent.x && std::abs(d.y) <= extent.y && std::abs(d.z) <= extent.z;
+}
+
+uint32_t DynamicBvh::insert(const Aabb& box, uint32_t userData) {
+    const uint32_t leaf = allocateNode();
+    const Vec3 margin{m_margin, m_margin, m_margin};
+    Node& node = m_nodes[leaf];
+    node.lo = box.center - box.halfExtent - margin;
+    node.hi = box.center + box.halfExtent + margin;
+    node.userData = userData;
+    node.height = 0;
+
+    insertLeaf(leaf);
+    ++m_leafCount;
+    return leaf;
+}
+
+void DynamicBvh::remove(uint32_t proxy) {
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --m_leafCount;
+}
+
+bool DynamicBvh::move(uint32_t proxy, const Aabb& box) {
+    const Vec3 lo = box.center - box.halfExtent;
+    const Vec3 hi = box.center + box.halfExtent;
+
+    Node& node = m_nodes[proxy];
+    if (node.lo.x <= lo.x && node.lo.y <= lo.y && node.lo.z <= lo.z &&
+        node.hi.x >= hi.x && node.hi.y >= hi.y && node.hi.z >= hi.z) {
+        return false;
+    }
+
+    removeLeaf(proxy);
+    const Vec3 margin{m_margin, m_margin, m_margin};
+    m_nodes[proxy].lo = lo - margin;
+    m_nodes[proxy].hi = hi + margin;
+    insertLeaf(proxy);
+    return true;
+}
+
+Aabb DynamicBvh::getFatBox(uint32_t proxy) const {
+    const Node& node = m_nodes[proxy];
+    return {(node.lo + node.hi) * 0.5f, (node.hi - node.lo) * 0.5f};
+}
+
+void DynamicBvh::clear() {
+    m_nodes.clear();
+    m_root = NULL_NODE;
+    m_freeList = NULL_NODE;
+    m_leafCount = 0;
+}
+
+uint32_t DynamicBvh::allocateNode() {
+    if (m_freeList == NULL_NODE) {
+        m_nodes.emplace_back();
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    const uint32_t index = m_freeList;
+    m_freeList = m_nodes[index].parent;
+    m_nodes[index] = Node{};
+    return index;
+}
+
+void DynamicBvh::freeNode(uint32_t index) {
+    m_nodes[index].parent = m_freeList;
+    m_nodes[index].height = -1;
+    m_freeList = index;
+}
+
+void DynamicBvh::insertLeaf(uint32_t leaf) {
+    if (m_root == NULL_NODE) {
+        m_root = leaf;
+        m_nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // Descend towards the sibling whose union with the leaf adds the least surface area.
+    // Every ancestor grows by the leaf too; that inherited cost is paid at each level.
+    const Vec3 leafLo = m_nodes[leaf].lo;
+    const Vec3 leafHi = m_nodes[leaf].hi;
+    uint32_t index = m_root;
+    while (!m_nodes[index].isLeaf()) {
+        const Node& node = m_nodes[index];
+        const float area = surfaceArea(node.lo, node.hi);
+        const float combined = surfaceArea(min(node.lo, leafLo), max(node.hi, leafHi));
+        const float cost = 2.0f * combined;
+        const float inheritance = 2.0f * (combined - area);
+
+        auto descendCost = [&](uint32_t childIndex) {
+            const Node& child = m_nodes[childIndex];
+            const float merged = surfaceArea(min(child.lo, leafLo), max(child.hi, leafHi));
+            return (child.isLeaf() ? merged : merged - surfaceArea(child.lo, child.hi)) + inheritance;
+        };
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    // New parent takes the sibling's place
+    const uint32_t sibling = index;
+    const uint32_t newParent = allocateNode();
+    const uint32_t oldParent = m_nodes[sibling].parent;
+    Node& parent = m_nodes[newParent];
+    parent.parent = oldParent;
+    parent.lo = min(m_nodes[sibling].lo, leafLo);
+    parent.hi = max(m_nodes[sibling].hi, leafHi);
+    parent.height = m_nodes[sibling].height + 1;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+
+    if (oldParent != NULL_NODE) {
+        Node& old = m_nodes[oldParent];
+        (old.child1 == sibling ? old.child1 : old.child2) = newParent;
+    } else {
+        m_root = newParent;
+    }
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    refitFrom(newParent);
+}
+
+void DynamicBvh::removeLeaf(uint32_t leaf) {
+    if (leaf == m_root) {
+        m_root = NULL_NODE;
+        return;
+    }
+
+    // The sibling takes the parent's place and the parent node is freed
+    const uint32_t parent = m_nodes[leaf].parent;
+    const uint32_t grandParent = m_nodes[parent].parent;
+    const uint32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    m_nodes[sibling].parent = grandParent;
+    freeNode(parent);
+    if (grandParent == NULL_NODE) {
+        m_root = sibling;
+        return;
+    }
+
+    Node& grand = m_nodes[grandParent];
+    (grand.child1 == parent ? grand.child1 : grand.child2) = sibling;
+    refitFrom(grandParent);
+}
+
+void DynamicBvh::refitFrom(uint32_t index) {
+    // Rebalance and refit every ancestor on the way up
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        Node& node = m_nodes[index];
+        const Node& child1 = m_nodes[node.child1];
+        const Node& child2 = m_nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.lo = min(child1.lo, child2.lo);
+        node.hi = max(child1.hi, child2.hi);
+
+        index = node.parent;
+    }
+}
+
+uint32_t DynamicBvh::balance(uint32_t indexA) {
+    Node& a = m_nodes[indexA];
+    if (a.isLeaf() || a.height < 2) return indexA;
+
+    const uint32_t indexB = a.child1;
+    const uint32_t indexC = a.child2;
+    Node& b = m_nodes[indexB];
+    Node& c = m_nodes[indexC];
+    const int32_t skew = c.height - b.height;
+
+    // Rotates `up` (a child of A) into A's place; A keeps its other child plus the shallower
+    // grandchild, `up` keeps the deeper one
+    auto rotate = [&](uint32_t indexUp, Node& up, uint32_t& aSlot, const Node& other) {
+        const uint32_t indexF = up.child1;
+        const uint32_t indexG = up.child2;
+        Node& f = m_nodes[indexF];
+        Node& g = m_nodes[indexG];
+
+        up.child1 = indexA;
+        up.parent = a.parent;
+        a.parent = indexUp;
+        if (up.parent != NULL_NODE) {
+            Node& parent = m_nodes[up.parent];
+            (parent.child1 == indexA ? parent.child1 : parent.child2) = indexUp;
+        } else {
+            m_root = indexUp;
+        }
+
+        const bool keepF = f.height > g.height;
+        const uint32_t indexKeep = keepF ? indexF : indexG;
+        const uint32_t indexGive = keepF ? indexG : indexF;
+        Node& keep = m_nodes[indexKeep];
+        Node& give = m_nodes[indexGive];
+
+        up.child2 = indexKeep;
+        aSlot = indexGive;
+        give.parent = indexA;
+
+        a.lo = min(other.lo, give.lo);
+        a.hi = max(other.hi, give.hi);
+        a.height = 1 + std::max(other.height, give.height);
+        up.lo = min(a.lo, keep.lo);
+        up.hi = max(a.hi, keep.hi);
+        up.height = 1 + std::max(a.height, keep.height);
+        return indexUp;
+    };
+
+    if (skew > 1) return rotate(indexC, c, a.child2, b);
+    if (skew < -1) return rotate(indexB, b, a.child1, c);
+    return indexA;
+}
+
+bool DynamicBvh::validate() const {
+    if (m_root == NULL_NODE) return m_leafCount == 0;
+    if (m_nodes[m_root].parent != NULL_NODE) return false;
+
+    size_t leaves = 0;
+    std::vector<uint32_t> stack{m_root};
+    while (!stack.empty()) {
+        const uint32_t index = stack.back();
+        stack.pop_back();
+        const Node& node = m_nodes[index];
+
+        if (node.isLeaf()) {
+            if (node.height != 0 || node.child2 != NULL_NODE) return false;
+            ++leaves;
+            continue;
+        }
+
+        const Node& child1 = m_nodes[node.child1];
+        const Node& child2 = m_nodes[node.child2];
+        if (child1.parent != index || child2.parent != index) return false;
+        if (node.height != 1 + std::max(child1.height, child2.height)) return false;
+
+        const Vec3 lo = min(child1.lo, child2.lo);
+        const Vec3 hi = max(child1.hi, child2.hi);
+        if (lo.x != node.lo.x || lo.y != node.lo.y || lo.z != node.lo.z ||
+            hi.x != node.hi.x || hi.y != node.hi.y || hi.z != node.hi.z) {
+            return false;
+        }
+
+        stack.push_back(node.child1);
+        stack.push_back(node.child2);
+    }
+    return leaves == m_leafCount;
+}
+
+} // namespace fe
@@ -0,0 +1,147 @@
+#include <filament_engine/math/frustum.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define FE_CULL_SSE2 1
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define FE_CULL_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace fe {
+
+Aabb transformAabb(const Mat4& m, const Aabb& local) {
+    Aabb result;
+    for (int row = 0; row < 3; ++row) {
+        result.center[row] = m[0][row] * local.center.x + m[1][row] * local.center.y +
+                             m[2][row] * local.center.z + m[3][row];
+        result.halfExtent[row] = std::abs(m[0][row]) * local.halfExtent.x +
+                                 std::abs(m[1][row]) * local.halfExtent.y +
+                                 std::abs(m[2][row]) * local.halfExtent.z;
+    }
+    return result;
+}
+
+Aabb mergeAabb(const Aabb& a, const Aabb& b) {
+    Vec3 lo = min(a.center - a.halfExtent, b.center - b.halfExtent);
+    Vec3 hi = max(a.center + a.halfExtent, b.center + b.halfExtent);
+    return {(lo + hi) * 0.5f, (hi - lo) * 0.5f};
+}
+
+Frustum Frustum::fromMatrix(const Mat4& m) {
+    return fromMatrix(m, -1.0f, 1.0f, -1.0f, 1.0f);
+}
+
+Frustum Frustum::fromMatrix(const Mat4& m, float left, float right, float bottom, float top) {
+    // Row i of a column-major matrix
+    auto row = [&m](int i) { return Vec4{m[0][i], m[1][i], m[2][i], m[3][i]}; };
+    const Vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    // x >= left * w  <=>  dot(r0 - left * r3, p) >= 0, and so on
+    Frustum frustum;
+    frustum.planes[0] = r0 - r3 * left;   // left
+    frustum.planes[1] = r3 * right - r0;  // right
+    frustum.planes[2] = r1 - r3 * bottom; // bottom
+    frustum.planes[3] = r3 * top - r1;    // top
+    frustum.planes[4] = r3 + r2; // near
+    frustum.planes[5] = r3 - r2; // far
+
+    for (auto& plane : frustum.planes) {
+        float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        // Degenerate plane (e.g. infinite far plane): accept everything
+        plane = length > 1e-6f ? plane / length : Vec4{0, 0, 0, 1};
+    }
+    return frustum;
+}
+
+bool Frustum::intersects(const Aabb& box, float margin) const {
+    for (const auto& plane : planes) {
+        float distance = plane.x * box.center.x + plane.y * box.center.y + plane.z * box.center.z + plane.w;
+        float radius = std::abs(plane.x) * box.halfExtent.x + std::abs(plane.y) * box.halfExtent.y +
+                       std::abs(plane.z) * box.halfExtent.z;
+        if (distance + radius + margin < 0.0f) return false;
+    }
+    return true;
+}
+
+void AabbSoA::clear() {
+    for (auto* channel : {&cx, &cy, &cz, &ex, &ey, &ez}) {
+        channel->clear();
+    }
+}
+
+void AabbSoA::push(const Aabb& box) {
+    cx.push_back(box.center.x); cy.push_back(box.center.y); cz.push_back(box.center.z);
+    ex.push_back(box.halfExtent.x); ey.push_back(box.halfExtent.y); ez.push_back(box.halfExtent.z);
+}
+
+size_t cullAabbs(const Frustum& frustum, const AabbSoA& boxes, float margin, uint8_t* visible) {
+    const size_t count = boxes.size();
+    size_t i = 0;
+    size_t visibleCount = 0;
+
+#if defined(FE_CULL_SSE2)
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 vmargin = _mm_set1_ps(margin);
+    for (; i + 4 <= count; i += 4) {
+        const __m128 cx = _mm_loadu_ps(&boxes.cx[i]), cy = _mm_loadu_ps(&boxes.cy[i]), cz = _mm_loadu_ps(&boxes.cz[i]);
+        const __m128 ex = _mm_loadu_ps(&boxes.ex[i]), ey = _mm_loadu_ps(&boxes.ey[i]), ez = _mm_loadu_ps(&boxes.ez[i]);
+
+        __m128 outside = _mm_setzero_ps();
+        for (const auto& plane : frustum.planes) {
+            const __m128 nx = _mm_set1_ps(plane.x), ny = _mm_set1_ps(plane.y), nz = _mm_set1_ps(plane.z);
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)),
+                                         _mm_add_ps(_mm_mul_ps(nz, cz), _mm_set1_ps(plane.w)));
+            __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_and_ps(nx, absMask), ex),
+                                                  _mm_mul_ps(_mm_and_ps(ny, absMask), ey)),
+                                       _mm_mul_ps(_mm_and_ps(nz, absMask), ez));
+            outside = _mm_or_ps(outside,
+                _mm_cmplt_ps(_mm_add_ps(_mm_add_ps(distance, radius), vmargin), _mm_setzero_ps()));
+        }
+
+        const int mask = _mm_movemask_ps(outside);
+        for (int lane = 0; lane < 4; ++lane) {
+            visible[i + lane] = (mask & (1 << lane)) ? 0 : 1;
+            visibleCount += visible[i + lane];
+        }
+    }
+#elif defined(FE_CULL_NEON)
+    const float32x4_t vmargin = vdupq_n_f32(margin);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t cx = vld1q_f32(&boxes.cx[i]), cy = vld1q_f32(&boxes.cy[i]), cz = vld1q_f32(&boxes.cz[i]);
+        const float32x4_t ex = vld1q_f32(&boxes.ex[i]), ey = vld1q_f32(&boxes.ey[i]), ez = vld1q_f32(&boxes.ez[i]);
+
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (const auto& plane : frustum.planes) {
+            float32x4_t distance = vaddq_f32(
+                vaddq_f32(vmulq_n_f32(cx, plane.x), vmulq_n_f32(cy, plane.y)),
+                vaddq_f32(vmulq_n_f32(cz, plane.z), vdupq_n_f32(plane.w)));
+            float32x4_t radius = vaddq_f32(
+                vaddq_f32(vmulq_n_f32(ex, std::abs(plane.x)), vmulq_n_f32(ey, std::abs(plane.y))),
+                vmulq_n_f32(ez, std::abs(plane.z)));
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(vaddq_f32(distance, radius), vmargin), zero));
+        }
+
+        uint32_t lanes[4];
+        vst1q_u32(lanes, outside);
+        for (int lane = 0; lane < 4; ++lane) {
+            visible[i + lane] = lanes[lane] ? 0 : 1;
+            visibleCount += visible[i + lane];
+        }
+    }
+#endif
+
+    // Scalar tail (and the whole range on other targets)
+    for (; i < count; ++i) {
+        Aabb box{{boxes.cx[i], boxes.cy[i], boxes.cz[i]}, {boxes.ex[i], boxes.ey[i], boxes.ez[i]}};
+        visible[i] = frustum.intersects(box, margin) ? 1 : 0;
+        visibleCount += visible[i];
+    }
+    return visibleCount;
+}
+
+} // namespace fe
@@ -0,0 +1,348 @@
+#include <filament_engine/math/occlusion_buffer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define FE_OCCLUSION_SSE2 1
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define FE_OCCLUSION_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace fe {
+
+namespace {
+
+// Vertices with w below this are treated as sitting on the camera plane
+constexpr float MIN_W = 1e-6f;
+
+Vec4 transformPoint(const Mat4& m, float x, float y, float z) {
+    return {m[0][0] * x + m[1][0] * y + m[2][0] * z + m[3][0],
+            m[0][1] * x + m[1][1] * y + m[2][1] * z + m[3][1],
+            m[0][2] * x + m[1][2] * y + m[2][2] * z + m[3][2],
+            m[0][3] * x + m[1][3] * y + m[2][3] * z + m[3][3]};
+}
+
+// Signed distance to the near plane in clip space (z >= -w)
+float nearDistance(const Vec4& p) { return p.z + p.w; }
+
+Vec4 lerp(const Vec4& a, const Vec4& b, float t) {
+    return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t};
+}
+
+// Writes max(depth, z) over 4 pixels where all three edge functions are >= 0
+#if FE_OCCLUSION_SSE2
+struct Lanes {
+    __m128 e0, e1, e2, z;
+    __m128 step0, step1, step2, stepZ;
+
+    Lanes(const float e[3], const float a[3], float z0, float zA) {
+        const __m128 ramp = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+        e0 = _mm_add_ps(_mm_set1_ps(e[0]), _mm_mul_ps(_mm_set1_ps(a[0]), ramp));
+        e1 = _mm_add_ps(_mm_set1_ps(e[1]), _mm_mul_ps(_mm_set1_ps(a[1]), ramp));
+        e2 = _mm_add_ps(_mm_set1_ps(e[2]), _mm_mul_ps(_mm_set1_ps(a[2]), ramp));
+        z = _mm_add_ps(_mm_set1_ps(z0), _mm_mul_ps(_mm_set1_ps(zA), ramp));
+        step0 = _mm_set1_ps(4.0f * a[0]);
+        step1 = _mm_set1_ps(4.0f * a[1]);
+        step2 = _mm_set1_ps(4.0f * a[2]);
+        stepZ = _mm_set1_ps(4.0f * zA);
+    }
+
+    void writeAndStep(float* depth) {
+        const __m128 inside = _mm_cmpge_ps(_mm_min_ps(_mm_min_ps(e0, e1), e2), _mm_setzero_ps());
+        if (_mm_movemask_ps(inside)) {
+            const __m128 stored = _mm_loadu_ps(depth);
+            const __m128 nearer = _mm_max_ps(stored, z);
+            _mm_storeu_ps(depth, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, stored)));
+        }
+        e0 = _mm_add_ps(e0, step0);
+        e1 = _mm_add_ps(e1, step1);
+        e2 = _mm_add_ps(e2, step2);
+        z = _mm_add_ps(z, stepZ);
+    }
+};
+#elif FE_OCCLUSION_NEON
+struct Lanes {
+    float32x4_t e0, e1, e2, z;
+    float32x4_t step0, step1, step2, stepZ;
+
+    Lanes(const float e[3], const float a[3], float z0, float zA) {
+        const float rampValues[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+        const float32x4_t ramp = vld1q_f32(rampValues);
+        e0 = vmlaq_n_f32(vdupq_n_f32(e[0]), ramp, a[0]);
+        e1 = vmlaq_n_f32(vdupq_n_f32(e[1]), ramp, a[1]);
+        e2 = vmlaq_n_f32(vdupq_n_f32(e[2]), ramp, a[2]);
+        z = vmlaq_n_f32(vdupq_n_f32(z0), ramp, zA);
+        step0 = vdupq_n_f32(4.0f * a[0]);
+        step1 = vdupq_n_f32(4.0f * a[1]);
+        step2 = vdupq_n_f32(4.0f * a[2]);
+        stepZ = vdupq_n_f32(4.0f * zA);
+    }
+
+    void writeAndStep(float* depth) {
+        const uint32x4_t inside = vcgeq_f32(vminq_f32(vminq_f32(e0, e1), e2), vdupq_n_f32(0.0f));
+        if (vmaxvq_u32(inside)) {
+            const float32x4_t stored = vld1q_f32(depth);
+            vst1q_f32(depth, vbslq_f32(inside, vmaxq_f32(stored, z), stored));
+        }
+        e0 = vaddq_f32(e0, step0);
+        e1 = vaddq_f32(e1, step1);
+        e2 = vaddq_f32(e2, step2);
+        z = vaddq_f32(z, stepZ);
+    }
+};
+#else
+struct Lanes {
+    float e0[4], e1[4], e2[4], z[4];
+    float a[3];
+    float zA;
+
+    Lanes(const float e[3], const float edgeA[3], float z0, float zStep) : zA(zStep) {
+        for (int i = 0; i < 3; ++i) a[i] = edgeA[i];
+        for (int lane = 0; lane < 4; ++lane) {
+            e0[lane] = e[0] + a[0] * lane;
+            e1[lane] = e[1] + a[1] * lane;
+            e2[lane] = e[2] + a[2] * lane;
+            z[lane] = z0 + zA * lane;
+        }
+    }
+
+    void writeAndStep(float* depth) {
+        for (int lane = 0; lane < 4; ++lane) {
+            if (e0[lane] >= 0.0f && e1[lane] >= 0.0f && e2[lane] >= 0.0f) {
+                depth[lane] = std::max(depth[lane], z[lane]);
+            }
+            e0[lane] += 4.0f * a[0];
+            e1[lane] += 4.0f * a[1];
+            e2[lane] += 4.0f * a[2];
+            z[lane] += 4.0f * zA;
+        }
+    }
+};
+#endif
+
+} // namespace
+
+void OcclusionBuffer::resize(uint32_t width, uint32_t height) {
+    m_tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    m_tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    m_width = m_tilesX * TILE_SIZE;
+    m_height = m_tilesY * TILE_SIZE;
+    m_depth.assign(static_cast<size_t>(m_width) * m_height, 0.0f);
+    m_tiles.assign(static_cast<size_t>(m_tilesX) * m_tilesY, 0.0f);
+}
+
+void OcclusionBuffer::begin(const Mat4& viewProjection) {
+    m_viewProjection = viewProjection;
+    m_triangles.clear();
+}
+
+void OcclusionBuffer::addOccluder(const Mat4& model, const float* positions, size_t stride, size_t vertexCount,
+                                  const uint32_t* indices, size_t indexCount) {
+    const Mat4 modelViewProjection = m_viewProjection * model;
+    const auto* bytes = reinterpret_cast<const uint8_t*>(positions);
+
+    m_clip.resize(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const auto* p = reinterpret_cast<const float*>(bytes + i * stride);
+        m_clip[i] = transformPoint(modelViewProjection, p[0], p[1], p[2]);
+    }
+
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount) continue;
+        addClipped(m_clip[indices[i]], m_clip[indices[i + 1]], m_clip[indices[i + 2]]);
+    }
+}
+
+void OcclusionBuffer::addClipped(const Vec4& a, const Vec4& b, const Vec4& c) {
+    const Vec4 in[3] = {a, b, c};
+    const float d[3] = {nearDistance(a), nearDistance(b), nearDistance(c)};
+    if (d[0] >= 0.0f && d[1] >= 0.0f && d[2] >= 0.0f) {
+        addScreen(a, b, c);
+        return;
+    }
+
+    // Clip against the near plane: the polygon keeps at most 4 vertices
+    Vec4 out[4];
+    int count = 0;
+    for (int i = 0; i < 3; ++i) {
+        const int j = (i + 1) % 3;
+        if (d[i] >= 0.0f) out[count++] = in[i];
+        if ((d[i] >= 0.0f) != (d[j] >= 0.0f)) {
+            out[count++] = lerp(in[i], in[j], d[i] / (d[i] - d[j]));
+        }
+    }
+    if (count >= 3) addScreen(out[0], out[1], out[2]);
+    if (count == 4) addScreen(out[0], out[2], out[3]);
+}
+
+void OcclusionBuffer::addScreen(const Vec4& a, const Vec4& b, const Vec4& c) {
+    if (a.w < MIN_W || b.w < MIN_W || c.w < MIN_W) return;
+
+    Triangle triangle;
+    const Vec4* vertices[3] = {&a, &b, &c};
+    for (int i = 0; i < 3; ++i) {
+        const float invW = 1.0f / vertices[i]->w;
+        triangle.x[i] = (vertices[i]->x * invW * 0.5f + 0.5f) * static_cast<float>(m_width);
+        triangle.y[i] = (vertices[i]->y * invW * 0.5f + 0.5f) * static_cast<float>(m_height);
+        triangle.z[i] = invW;
+    }
+
+    // Entirely off one side of the screen
+    const float minX = std::min({triangle.x[0], triangle.x[1], triangle.x[2]});
+    const float maxX = std::max({triangle.x[0], triangle.x[1], triangle.x[2]});
+    triangle.minY = std::min({triangle.y[0], triangle.y[1], triangle.y[2]});
+    triangle.maxY = std::max({triangle.y[0], triangle.y[1], triangle.y[2]});
+    if (maxX < 0.0f || minX >= static_cast<float>(m_width) ||
+        triangle.maxY < 0.0f || triangle.minY >= static_cast<float>(m_height)) {
+        return;
+    }
+
+    // Counter-clockwise order, so "inside" is every edge function >= 0
+    const float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+                       (triangle.y[1] - triangle.y[0]) * (triangle.x[2] - triangle.x[0]);
+    if (std::abs(area) < 1e-6f) return;
+    if (area < 0.0f) {
+        std::swap(triangle.x[1], triangle.x[2]);
+        std::swap(triangle.y[1], triangle.y[2]);
+        std::swap(triangle.z[1], triangle.z[2]);
+    }
+    m_triangles.push_back(triangle);
+}
+
+void OcclusionBuffer::rasterizeBand(uint32_t band) {
+    const uint32_t rowBegin = band * BAND_HEIGHT;
+    const uint32_t rowEnd = std::min(m_height, rowBegin + BAND_HEIGHT);
+    if (rowBegin >= rowEnd) return;
+
+    std::memset(&m_depth[static_cast<size_t>(rowBegin) * m_width], 0,
+                sizeof(float) * static_cast<size_t>(rowEnd - rowBegin) * m_width);
+
+    for (const auto& triangle : m_triangles) {
+        if (triangle.maxY < static_cast<float>(rowBegin) || triangle.minY >= static_cast<float>(rowEnd)) continue;
+        rasterizeTriangle(triangle, rowBegin, rowEnd);
+    }
+
+    // Farthest (smallest 1/w) depth of each tile in the band
+    for (uint32_t tileY = rowBegin / TILE_SIZE; tileY < rowEnd / TILE_SIZE; ++tileY) {
+        for (uint32_t tileX = 0; tileX < m_tilesX; ++tileX) {
+            float farthest = m_depth[static_cast<size_t>(tileY * TILE_SIZE) * m_width + tileX * TILE_SIZE];
+            for (uint32_t y = tileY * TILE_SIZE; y < (tileY + 1) * TILE_SIZE; ++y) {
+                const float* row = &m_depth[static_cast<size_t>(y) * m_width + tileX * TILE_SIZE];
+                for (uint32_t x = 0; x < TILE_SIZE; ++x) farthest = std::min(farthest, row[x]);
+            }
+            m_tiles[tileY * m_tilesX + tileX] = farthest;
+        }
+    }
+}
+
+void OcclusionBuffer::rasterize() {
+    for (uint32_t band = 0; band < getBandCount(); ++band) rasterizeBand(band);
+}
+
+void OcclusionBuffer::rasterizeTriangle(const Triangle& t, uint32_t rowBegin, uint32_t rowEnd) {
+    // Pixel range touched by the bounding box; x snaps to groups of 4 (rows are whole tiles wide)
+    const auto x0 = static_cast<uint32_t>(std::max(0.0f, std::floor(std::min({t.x[0], t.x[1], t.x[2]})))) & ~3u;
+    const auto x1 = static_cast<uint32_t>(std::min(static_cast<float>(m_width - 1),
+                                                   std::floor(std::max({t.x[0], t.x[1], t.x[2]}))));
+    const auto y0 = std::max(rowBegin, static_cast<uint32_t>(std::max(0.0f, std::floor(t.minY))));
+    const auto y1 = std::min(rowEnd - 1, static_cast<uint32_t>(std::min(static_cast<float>(m_height - 1),
+                                                                         std::floor(t.maxY))));
+    if (x0 > x1 || y0 > y1) return;
+
+    // Edge i runs from vertex i to vertex i + 1: e(x, y) = a * x + b * y + c
+    float a[3], b[3], c[3];
+    for (int i = 0; i < 3; ++i) {
+        const int j = (i + 1) % 3;
+        a[i] = t.y[i] - t.y[j];
+        b[i] = t.x[j] - t.x[i];
+        c[i] = -(a[i] * t.x[i] + b[i] * t.y[i]);
+    }
+
+    // 1/w is affine in screen space: weight each vertex by its opposite edge
+    const float invArea = 1.0f / (a[0] * t.x[2] + b[0] * t.y[2] + c[0]);
+    const float zA = (a[1] * t.z[0] + a[2] * t.z[1] + a[0] * t.z[2]) * invArea;
+    const float zB = (b[1] * t.z[0] + b[2] * t.z[1] + b[0] * t.z[2]) * invArea;
+    const float zC = (c[1] * t.z[0] + c[2] * t.z[1] + c[0] * t.z[2]) * invArea;
+
+    const float startX = static_cast<float>(x0) + 0.5f;
+    for (uint32_t y = y0; y <= y1; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        const float e[3] = {a[0] * startX + b[0] * py + c[0],
+                            a[1] * startX + b[1] * py + c[1],
+                            a[2] * startX + b[2] * py + c[2]};
+        Lanes lanes(e, a, zA * startX + zB * py + zC, zA);
+
+        float* row = &m_depth[static_cast<size_t>(y) * m_width];
+        for (uint32_t x = x0; x <= x1; x += 4) lanes.writeAndStep(row + x);
+    }
+}
+
+bool OcclusionBuffer::isOccluded(const Aabb& box) const {
+    if (m_triangles.empty()) return false;
+
+    // Project the corners: the nearest point of the box is one of them (w is affine)
+    const Vec4 center = transformPoint(m_viewProjection, box.center.x, box.center.y, box.center.z);
+    Vec4 axes[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        const Vec4& column = m_viewProjection[axis];
+        const float extent = box.halfExtent[axis];
+        axes[axis] = {column.x * extent, column.y * extent, column.z * extent, column.w * extent};
+    }
+
+    float minX = static_cast<float>(m_width), maxX = -1.0f;
+    float minY = static_cast<float>(m_height), maxY = -1.0f;
+    float nearest = 0.0f;
+    for (int corner = 0; corner < 8; ++corner) {
+        Vec4 p = center;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float sign = (corner >> axis) & 1 ? 1.0f : -1.0f;
+            p = {p.x + sign * axes[axis].x, p.y + sign * axes[axis].y,
+                 p.z + sign * axes[axis].z, p.w + sign * axes[axis].w};
+        }
+        if (nearDistance(p) < 0.0f || p.w < MIN_W) return false;
+
+        const float invW = 1.0f / p.w;
+        const float x = (p.x * invW * 0.5f + 0.5f) * static_cast<float>(m_width);
+        const float y = (p.y * invW * 0.5f + 0.5f) * static_cast<float>(m_height);
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        nearest = std::max(nearest, invW);
+    }
+    if (maxX < 0.0f || minX >= static_cast<float>(m_width) ||
+        maxY < 0.0f || minY >= static_cast<float>(m_height)) {
+        return false;
+    }
+
+    const auto x0 = static_cast<uint32_t>(std::max(0.0f, std::floor(minX)));
+    const auto x1 = static_cast<uint32_t>(std::min(static_cast<float>(m_width - 1), std::floor(maxX)));
+    const auto y0 = static_cast<uint32_t>(std::max(0.0f, std::floor(minY)));
+    const auto y1 = static_cast<uint32_t>(std::min(static_cast<float>(m_height - 1), std::floor(maxY)));
+
+    // Tiles whose farthest occluder is nearer than the box are hidden as a whole;
+    // the others fall back to the pixels the box covers
+    for (uint32_t tileY = y0 / TILE_SIZE; tileY <= y1 / TILE_SIZE; ++tileY) {
+        for (uint32_t tileX = x0 / TILE_SIZE; tileX <= x1 / TILE_SIZE; ++tileX) {
+            if (m_tiles[tileY * m_tilesX + tileX] > nearest) continue;
+
+            const uint32_t px0 = std::max(x0, tileX * TILE_SIZE);
+            const uint32_t px1 = std::min(x1, tileX * TILE_SIZE + TILE_SIZE - 1);
+            const uint32_t py0 = std::max(y0, tileY * TILE_SIZE);
+            const uint32_t py1 = std::min(y1, tileY * TILE_SIZE + TILE_SIZE - 1);
+            for (uint32_t y = py0; y <= py1; ++y) {
+                const float* row = &m_depth[static_cast<size_t>(y) * m_width];
+                for (uint32_t x = px0; x <= px1; ++x) {
+                    if (row[x] <= nearest) return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace fe
@@ -0,0 +1,310 @@
+#include <filament_engine/math/simd_transform.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define FE_SIMD_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define FE_SIMD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+// AVX2 kernels are compiled per-function so the rest of the engine keeps the baseline ISA
+#if defined(FE_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define FE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define FE_TARGET_AVX2
+#endif
+
+namespace fe {
+
+static_assert(sizeof(Mat4) == 16 * sizeof(float), "Mat4 must be 16 packed floats (column-major)");
+
+void TransformSoA::resize(size_t count) {
+    for (auto* channel : {&px, &py, &pz, &qx, &qy, &qz, &qw, &sx, &sy, &sz}) {
+        channel->resize(count);
+    }
+}
+
+namespace {
+
+// ---------------------------------------------------------------------------------------
+// Scalar reference (also handles the tail of every SIMD loop)
+// ---------------------------------------------------------------------------------------
+
+void composeScalar(const TransformSoA& in, float* out, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        const float x = in.qx[i], y = in.qy[i], z = in.qz[i], w = in.qw[i];
+        const float x2 = x + x, y2 = y + y, z2 = z + z;
+        const float xx = x * x2, yy = y * y2, zz = z * z2;
+        const float xy = x * y2, xz = x * z2, yz = y * z2;
+        const float wx = w * x2, wy = w * y2, wz = w * z2;
+        const float sx = in.sx[i], sy = in.sy[i], sz = in.sz[i];
+
+        float* m = out + i * 16;
+        m[0]  = (1.0f - (yy + zz)) * sx; m[1]  = (xy + wz) * sx;          m[2]  = (xz - wy) * sx;          m[3]  = 0.0f;
+        m[4]  = (xy - wz) * sy;          m[5]  = (1.0f - (xx + zz)) * sy; m[6]  = (yz + wx) * sy;          m[7]  = 0.0f;
+        m[8]  = (xz + wy) * sz;          m[9]  = (yz - wx) * sz;          m[10] = (1.0f - (xx + yy)) * sz; m[11] = 0.0f;
+        m[12] = in.px[i];                m[13] = in.py[i];                m[14] = in.pz[i];                m[15] = 1.0f;
+    }
+}
+
+// ---------------------------------------------------------------------------------------
+// x86: SSE2 (4 lanes) and AVX2 (8 lanes)
+// Each lane computes one entity; the 16 per-lane results are transposed 4x4 back to
+// one column-major matrix per entity.
+// ---------------------------------------------------------------------------------------
+
+#if defined(FE_SIMD_X86)
+
+inline void storeColumnsSSE(float* out, size_t column, __m128 r0, __m128 r1, __m128 r2, __m128 r3) {
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(out + 0 * 16 + column * 4, r0);
+    _mm_storeu_ps(out + 1 * 16 + column * 4, r1);
+    _mm_storeu_ps(out + 2 * 16 + column * 4, r2);
+    _mm_storeu_ps(out + 3 * 16 + column * 4, r3);
+}
+
+size_t composeSSE2(const TransformSoA& in, float* out, size_t count) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(&in.qx[i]), y = _mm_loadu_ps(&in.qy[i]);
+        const __m128 z = _mm_loadu_ps(&in.qz[i]), w = _mm_loadu_ps(&in.qw[i]);
+        const __m128 x2 = _mm_add_ps(x, x), y2 = _mm_add_ps(y, y), z2 = _mm_add_ps(z, z);
+        const __m128 xx = _mm_mul_ps(x, x2), yy = _mm_mul_ps(y, y2), zz = _mm_mul_ps(z, z2);
+        const __m128 xy = _mm_mul_ps(x, y2), xz = _mm_mul_ps(x, z2), yz = _mm_mul_ps(y, z2);
+        const __m128 wx = _mm_mul_ps(w, x2), wy = _mm_mul_ps(w, y2), wz = _mm_mul_ps(w, z2);
+        const __m128 sx = _mm_loadu_ps(&in.sx[i]), sy = _mm_loadu_ps(&in.sy[i]), sz = _mm_loadu_ps(&in.sz[i]);
+
+        float* m = out + i * 16;
+        storeColumnsSSE(m, 0,
+            _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx),
+            _mm_mul_ps(_mm_add_ps(xy, wz), sx),
+            _mm_mul_ps(_mm_sub_ps(xz, wy), sx),
+            zero);
+        storeColumnsSSE(m, 1,
+            _mm_mul_ps(_mm_sub_ps(xy, wz), sy),
+            _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy),
+            _mm_mul_ps(_mm_add_ps(yz, wx), sy),
+            zero);
+        storeColumnsSSE(m, 2,
+            _mm_mul_ps(_mm_add_ps(xz, wy), sz),
+            _mm_mul_ps(_mm_sub_ps(yz, wx), sz),
+            _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz),
+            zero);
+        storeColumnsSSE(m, 3,
+            _mm_loadu_ps(&in.px[i]), _mm_loadu_ps(&in.py[i]), _mm_loadu_ps(&in.pz[i]), one);
+    }
+    return i;
+}
+
+FE_TARGET_AVX2
+inline void storeColumnsAVX(float* out, size_t column, __m256 r0, __m256 r1, __m256 r2, __m256 r3) {
+    // Lanes 0-3 and 4-7 are two independent groups of four entities
+    __m128 lo0 = _mm256_castps256_ps128(r0), lo1 = _mm256_castps256_ps128(r1);
+    __m128 lo2 = _mm256_castps256_ps128(r2), lo3 = _mm256_castps256_ps128(r3);
+    __m128 hi0 = _mm256_extractf128_ps(r0, 1), hi1 = _mm256_extractf128_ps(r1, 1);
+    __m128 hi2 = _mm256_extractf128_ps(r2, 1), hi3 = _mm256_extractf128_ps(r3, 1);
+    _MM_TRANSPOSE4_PS(lo0, lo1, lo2, lo3);
+    _MM_TRANSPOSE4_PS(hi0, hi1, hi2, hi3);
+    _mm_storeu_ps(out + 0 * 16 + column * 4, lo0);
+    _mm_storeu_ps(out + 1 * 16 + column * 4, lo1);
+    _mm_storeu_ps(out + 2 * 16 + column * 4, lo2);
+    _mm_storeu_ps(out + 3 * 16 + column * 4, lo3);
+    _mm_storeu_ps(out + 4 * 16 + column * 4, hi0);
+    _mm_storeu_ps(out + 5 * 16 + column * 4, hi1);
+    _mm_storeu_ps(out + 6 * 16 + column * 4, hi2);
+    _mm_storeu_ps(out + 7 * 16 + column * 4, hi3);
+}
+
+FE_TARGET_AVX2
+size_t composeAVX2(const TransformSoA& in, float* out, size_t count) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 x = _mm256_loadu_ps(&in.qx[i]), y = _mm256_loadu_ps(&in.qy[i]);
+        const __m256 z = _mm256_loadu_ps(&in.qz[i]), w = _mm256_loadu_ps(&in.qw[i]);
+        const __m256 x2 = _mm256_add_ps(x, x), y2 = _mm256_add_ps(y, y), z2 = _mm256_add_ps(z, z);
+        const __m256 xx = _mm256_mul_ps(x, x2), yy = _mm256_mul_ps(y, y2), zz = _mm256_mul_ps(z, z2);
+        const __m256 xy = _mm256_mul_ps(x, y2), xz = _mm256_mul_ps(x, z2), yz = _mm256_mul_ps(y, z2);
+        const __m256 wx = _mm256_mul_ps(w, x2), wy = _mm256_mul_ps(w, y2), wz = _mm256_mul_ps(w, z2);
+        const __m256 sx = _mm256_loadu_ps(&in.sx[i]), sy = _mm256_loadu_ps(&in.sy[i]);
+        const __m256 sz = _mm256_loadu_ps(&in.sz[i]);
+
+        float* m = out + i * 16;
+        storeColumnsAVX(m, 0,
+            _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(yy, zz)), sx),
+            _mm256_mul_ps(_mm256_add_ps(xy, wz), sx),
+            _mm256_mul_ps(_mm256_sub_ps(xz, wy), sx),
+            zero);
+        storeColumnsAVX(m, 1,
+            _mm256_mul_ps(_mm256_sub_ps(xy, wz), sy),
+            _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, zz)), sy),
+            _mm256_mul_ps(_mm256_add_ps(yz, wx), sy),
+            zero);
+        storeColumnsAVX(m, 2,
+            _mm256_mul_ps(_mm256_add_ps(xz, wy), sz),
+            _mm256_mul_ps(_mm256_sub_ps(yz, wx), sz),
+            _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, yy)), sz),
+            zero);
+        storeColumnsAVX(m, 3,
+            _mm256_loadu_ps(&in.px[i]), _mm256_loadu_ps(&in.py[i]), _mm256_loadu_ps(&in.pz[i]), one);
+    }
+    return i;
+}
+
+bool cpuHasSSE2() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return true; // part of the x86-64 baseline
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+bool cpuHasAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    // The OS must also save the YMM registers on context switches
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // FE_SIMD_X86
+
+// ---------------------------------------------------------------------------------------
+// ARM: NEON (4 lanes, always available on AArch64)
+// ---------------------------------------------------------------------------------------
+
+#if defined(FE_SIMD_NEON)
+
+inline void storeColumnsNEON(float* out, size_t column,
+                             float32x4_t r0, float32x4_t r1, float32x4_t r2, float32x4_t r3) {
+    const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+    const float32x4x2_t t23 = vtrnq_f32(r2, r3);
+    vst1q_f32(out + 0 * 16 + column * 4, vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0])));
+    vst1q_f32(out + 1 * 16 + column * 4, vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1])));
+    vst1q_f32(out + 2 * 16 + column * 4, vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])));
+    vst1q_f32(out + 3 * 16 + column * 4, vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])));
+}
+
+size_t composeNEON(const TransformSoA& in, float* out, size_t count) {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t x = vld1q_f32(&in.qx[i]), y = vld1q_f32(&in.qy[i]);
+        const float32x4_t z = vld1q_f32(&in.qz[i]), w = vld1q_f32(&in.qw[i]);
+        const float32x4_t x2 = vaddq_f32(x, x), y2 = vaddq_f32(y, y), z2 = vaddq_f32(z, z);
+        const float32x4_t xx = vmulq_f32(x, x2), yy = vmulq_f32(y, y2), zz = vmulq_f32(z, z2);
+        const float32x4_t xy = vmulq_f32(x, y2), xz = vmulq_f32(x, z2), yz = vmulq_f32(y, z2);
+        const float32x4_t wx = vmulq_f32(w, x2), wy = vmulq_f32(w, y2), wz = vmulq_f32(w, z2);
+        const float32x4_t sx = vld1q_f32(&in.sx[i]), sy = vld1q_f32(&in.sy[i]), sz = vld1q_f32(&in.sz[i]);
+
+        float* m = out + i * 16;
+        storeColumnsNEON(m, 0,
+            vmulq_f32(vsubq_f32(one, vaddq_f32(yy, zz)), sx),
+            vmulq_f32(vaddq_f32(xy, wz), sx),
+            vmulq_f32(vsubq_f32(xz, wy), sx),
+            zero);
+        storeColumnsNEON(m, 1,
+            vmulq_f32(vsubq_f32(xy, wz), sy),
+            vmulq_f32(vsubq_f32(one, vaddq_f32(xx, zz)), sy),
+            vmulq_f32(vaddq_f32(yz, wx), sy),
+            zero);
+        storeColumnsNEON(m, 2,
+            vmulq_f32(vaddq_f32(xz, wy), sz),
+            vmulq_f32(vsubq_f32(yz, wx), sz),
+            vmulq_f32(vsubq_f32(one, vaddq_f32(xx, yy)), sz),
+            zero);
+        storeColumnsNEON(m, 3, vld1q_f32(&in.px[i]), vld1q_f32(&in.py[i]), vld1q_f32(&in.pz[i]), one);
+    }
+    return i;
+}
+
+#endif // FE_SIMD_NEON
+
+SimdLevel detectSimdLevel() {
+#if defined(FE_SIMD_X86)
+    if (cpuHasAVX2()) return SimdLevel::AVX2;
+    if (cpuHasSSE2()) return SimdLevel::SSE2;
+#elif defined(FE_SIMD_NEON)
+    return SimdLevel::NEON;
+#endif
+    return SimdLevel::Scalar;
+}
+
+} // namespace
+
+SimdLevel getSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+bool isSimdLevelSupported(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return true;
+#if defined(FE_SIMD_X86)
+        case SimdLevel::SSE2:   return getSimdLevel() == SimdLevel::SSE2 || getSimdLevel() == SimdLevel::AVX2;
+        case SimdLevel::AVX2:   return getSimdLevel() == SimdLevel::AVX2;
+#elif defined(FE_SIMD_NEON)
+        case SimdLevel::NEON:   return true;
+#endif
+        default:                return false;
+    }
+}
+
+const char* getSimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "Scalar";
+        case SimdLevel::SSE2:   return "SSE2";
+        case SimdLevel::AVX2:   return "AVX2";
+        case SimdLevel::NEON:   return "NEON";
+    }
+    return "Unknown";
+}
+
+void composeTransforms(const TransformSoA& input, Mat4* out) {
+    composeTransforms(input, out, getSimdLevel());
+}
+
+void composeTransforms(const TransformSoA& input, Mat4* out, SimdLevel level) {
+    const size_t count = input.size();
+    float* dst = reinterpret_cast<float*>(out);
+
+    size_t done = 0;
+    switch (level) {
+#if defined(FE_SIMD_X86)
+        case SimdLevel::AVX2: done = composeAVX2(input, dst, count); break;
+        case SimdLevel::SSE2: done = composeSSE2(input, dst, count); break;
+#elif defined(FE_SIMD_NEON)
+        case SimdLevel::NEON: done = composeNEON(input, dst, count); break;
+#endif
+        default: break;
+    }
+    composeScalar(input, dst, done, count);
+}
+
+} // namespace fe
@@ -54,6 +54,7 @@ static const char* backendToString(GraphicsBackend backend) {
         case GraphicsBackend::Vulkan:  return "Vulkan";
         case GraphicsBackend::Metal:   return "Metal";
         case GraphicsBackend::OpenGL:  return "OpenGL";
+        case GraphicsBackend::Noop:    return "Noop";
         case GraphicsBackend::Default: return "Default";
     }
     return "Unknown";
@@ -64,13 +65,24 @@ static filament::Engine::Backend toFilamentBackend(GraphicsBackend backend) {
         case GraphicsBackend::Vulkan:  return filament::Engine::Backend::VULKAN;
         case GraphicsBackend::Metal:   return filament::Engine::Backend::METAL;
         case GraphicsBackend::OpenGL:  return filament::Engine::Backend::OPENGL;
+        case GraphicsBackend::Noop:    return filament::Engine::Backend::NOOP;
         case GraphicsBackend::Default: return filament::Engine::Backend::DEFAULT;
     }
     return filament::Engine::Backend::DEFAULT;
 }
 
 RenderContext::RenderContext(Window& window, GraphicsBackend backend)
-    : m_window(window) {
+    : m_window(&window) {
+    init(static_cast<uint32_t>(window.getWidth()), static_cast<uint32_t>(window.getHeight()), backend);
+}
+
+RenderContext::RenderContext(uint32_t width, uint32_t height, GraphicsBackend backend) {
+    init(width, height, backend);
+}
+
+void RenderContext::init(uint32_t width, uint32_t height, GraphicsBackend backend) {
+    m_width = width;
+    m_height = height;
 
     // Resolve Default to the platform-appropriate backend
     if (backend == GraphicsBackend::Default) {
@@ -91,7 +103,7 @@ RenderContext::RenderContext(Window& window, GraphicsBackend backend)
     }
 
     // Create swap chain
-    createSwapChain(window);
+    createSwapChain();
 
     // Create renderer
     m_renderer = m_engine->createRenderer();
@@ -102,9 +114,7 @@ RenderContext::RenderContext(Window& window, GraphicsBackend backend)
     // Create view
     m_view = m_engine->createView();
     m_view->setScene(m_scene);
-    m_view->setViewport({0, 0,
-        static_cast<uint32_t>(window.getWidth()),
-        static_cast<uint32_t>(window.getHeight())});
+    m_view->setViewport({0, 0, width, height});
 
     // Create a default camera
     m_cameraEntity = utils::EntityManager::get().create();
@@ -112,7 +122,7 @@ RenderContext::RenderContext(Window& window, GraphicsBackend backend)
     m_view->setCamera(m_activeCamera);
 
     // Default camera setup: perspective projection looking at origin
-    const float aspect = static_cast<float>(window.getWidth()) / static_cast<float>(window.getHeight());
+    const float aspect = static_cast<float>(width) / static_cast<float>(height);
     m_activeCamera->setProjection(60.0f, aspect, 0.1f, 1000.0f);
     m_activeCamera->lookAt({0, 2, 5}, {0, 0, 0}, {0, 1, 0});
 
@@ -152,7 +162,16 @@ RenderContext::~RenderContext() {
     FE_LOG_INFO("RenderContext destroyed");
 }
 
-void RenderContext::createSwapChain(Window& window) {
+void RenderContext::createSwapChain() {
+    if (!m_window) {
+        m_swapChain = m_engine->createSwapChain(m_width, m_height);
+        if (!m_swapChain) {
+            FE_LOG_FATAL("Failed to create headless SwapChain");
+        }
+        return;
+    }
+
+    Window& window = *m_window;
     void* nativeWindow = nullptr;
 
 #if defined(__APPLE__)
@@ -197,6 +216,8 @@ void RenderContext::endFrame() {
 
 void RenderContext::resize(int width, int height) {
     if (width <= 0 || height <= 0) return;
+    m_width = static_cast<uint32_t>(width);
+    m_height = static_cast<uint32_t>(height);
 
     m_view->setViewport({0, 0,
         static_cast<uint32_t>(width),
@@ -211,7 +232,7 @@ void RenderContext::resize(int width, int height) {
     if (m_swapChain) {
         m_engine->destroy(m_swapChain);
     }
-    createSwapChain(m_window);
+    createSwapChain();
 }
 
 filament::TransformManager& RenderContext::getTransformManager() const {
@@ -0,0 +1,106 @@
+#include <filament_engine/resources/material_instance_pool.h>
+#include <filament_engine/resources/material.h>
+#include <filament_engine/core/log.h>
+
+#include <filament/Engine.h>
+#include <filament/MaterialInstance.h>
+
+namespace fe {
+
+MaterialInstancePool::~MaterialInstancePool() {
+    destroyAll();
+}
+
+uint32_t MaterialInstancePool::acquire(ResourceHandle<MaterialWrapper> parentHandle, const MaterialWrapper& parent,
+                                       const MaterialParameters& parameters) {
+    const size_t hash = combine(parentHandle, parameters.hash());
+
+    auto [first, last] = m_lookup.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        auto& entry = m_entries[it->second - 1];
+        if (entry.parent == parentHandle && entry.parameters == parameters) {
+            ++entry.refCount;
+            return it->second;
+        }
+    }
+
+    uint32_t id;
+    if (!m_freeIds.empty()) {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    } else {
+        m_entries.emplace_back();
+        id = static_cast<uint32_t>(m_entries.size());
+    }
+
+    auto& entry = m_entries[id - 1];
+    entry.parent = parentHandle;
+    entry.parameters = parameters;
+    entry.hash = hash;
+    entry.instance = filament::MaterialInstance::duplicate(parent.getInstance());
+    entry.refCount = 1;
+    parameters.applyTo(*entry.instance);
+
+    m_lookup.emplace(hash, id);
+    return id;
+}
+
+void MaterialInstancePool::release(uint32_t id) {
+    if (id == 0 || id > m_entries.size()) return;
+
+    auto& entry = m_entries[id - 1];
+    if (entry.refCount == 0) {
+        FE_LOG_WARN("MaterialInstancePool: release of an unreferenced instance");
+        return;
+    }
+    if (--entry.refCount == 0) {
+        m_unreferenced.push_back(id);
+    }
+}
+
+bool MaterialInstancePool::matches(uint32_t id, ResourceHandle<MaterialWrapper> parentHandle,
+                                   const MaterialParameters& parameters) const {
+    if (id == 0 || id > m_entries.size()) return false;
+    const auto& entry = m_entries[id - 1];
+    return entry.instance && entry.parent == parentHandle && entry.parameters == parameters;
+}
+
+filament::MaterialInstance* MaterialInstancePool::getInstance(uint32_t id) const {
+    return id != 0 && id <= m_entries.size() ? m_entries[id - 1].instance : nullptr;
+}
+
+uint32_t MaterialInstancePool::getRefCount(uint32_t id) const {
+    return id != 0 && id <= m_entries.size() ? m_entries[id - 1].refCount : 0;
+}
+
+void MaterialInstancePool::collectGarbage() {
+    for (auto id : m_unreferenced) {
+        auto& entry = m_entries[id - 1];
+        if (entry.refCount != 0 || !entry.instance) continue; // re-acquired, or already collected
+
+        auto [first, last] = m_lookup.equal_range(entry.hash);
+        for (auto it = first; it != last; ++it) {
+            if (it->second == id) {
+                m_lookup.erase(it);
+                break;
+            }
+        }
+
+        m_engine.destroy(entry.instance);
+        entry = Entry{};
+        m_freeIds.push_back(id);
+    }
+    m_unreferenced.clear();
+}
+
+void MaterialInstancePool::destroyAll() {
+    for (auto& entry : m_entries) {
+        if (entry.instance) m_engine.destroy(entry.instance);
+    }
+    m_entries.clear();
+    m_freeIds.clear();
+    m_lookup.clear();
+    m_unreferenced.clear();
+}
+
+} // namespace fe
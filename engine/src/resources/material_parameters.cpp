@@ -0,0 +1,91 @@
+#include <filament_engine/resources/material_parameters.h>
+
+#include <filament/MaterialInstance.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace fe {
+
+bool MaterialParameters::Parameter::operator==(const Parameter& other) const {
+    return size == other.size && name == other.name &&
+           std::memcmp(value, other.value, sizeof(float) * size) == 0;
+}
+
+MaterialParameters& MaterialParameters::set(std::string_view name, float value) {
+    return set(name, &value, 1);
+}
+
+MaterialParameters& MaterialParameters::set(std::string_view name, const Vec2& value) {
+    const float data[] = {value.x, value.y};
+    return set(name, data, 2);
+}
+
+MaterialParameters& MaterialParameters::set(std::string_view name, const Vec3& value) {
+    const float data[] = {value.x, value.y, value.z};
+    return set(name, data, 3);
+}
+
+MaterialParameters& MaterialParameters::set(std::string_view name, const Vec4& value) {
+    const float data[] = {value.x, value.y, value.z, value.w};
+    return set(name, data, 4);
+}
+
+MaterialParameters& MaterialParameters::set(std::string_view name, const float* value, uint8_t size) {
+    auto it = std::lower_bound(m_parameters.begin(), m_parameters.end(), name,
+        [](const Parameter& parameter, std::string_view key) { return parameter.name < key; });
+    if (it == m_parameters.end() || it->name != name) {
+        it = m_parameters.insert(it, Parameter{std::string(name)});
+    }
+
+    it->size = size;
+    std::fill(std::begin(it->value), std::end(it->value), 0.0f);
+    std::copy(value, value + size, it->value);
+    return *this;
+}
+
+bool MaterialParameters::remove(std::string_view name) {
+    auto it = std::lower_bound(m_parameters.begin(), m_parameters.end(), name,
+        [](const Parameter& parameter, std::string_view key) { return parameter.name < key; });
+    if (it == m_parameters.end() || it->name != name) return false;
+    m_parameters.erase(it);
+    return true;
+}
+
+const MaterialParameters::Parameter* MaterialParameters::find(std::string_view name) const {
+    auto it = std::lower_bound(m_parameters.begin(), m_parameters.end(), name,
+        [](const Parameter& parameter, std::string_view key) { return parameter.name < key; });
+    return it != m_parameters.end() && it->name == name ? &*it : nullptr;
+}
+
+size_t MaterialParameters::hash() const {
+    // FNV-1a over names, sizes and raw value bits
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    for (const auto& parameter : m_parameters) {
+        mix(parameter.name.data(), parameter.name.size() + 1);
+        mix(&parameter.size, 1);
+        mix(parameter.value, sizeof(float) * parameter.size);
+    }
+    return static_cast<size_t>(hash);
+}
+
+void MaterialParameters::applyTo(filament::MaterialInstance& instance) const {
+    for (const auto& p : m_parameters) {
+        const char* name = p.name.c_str();
+        switch (p.size) {
+            case 1: instance.setParameter(name, p.value[0]); break;
+            case 2: instance.setParameter(name, filament::math::float2{p.value[0], p.value[1]}); break;
+            case 3: instance.setParameter(name, filament::math::float3{p.value[0], p.value[1], p.value[2]}); break;
+            case 4: instance.setParameter(name, filament::math::float4{p.value[0], p.value[1], p.value[2], p.value[3]}); break;
+        }
+    }
+}
+
+} // namespace fe
@@ -5,23 +5,82 @@
 #include <filament/IndexBuffer.h>
 #include <filament/RenderableManager.h>
 
-#include <math/vec3.h>
-#include <math/vec2.h>
-
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
 namespace fe {
 
-struct Vertex {
-    filament::math::float3 position;
-    filament::math::float3 normal;
-    filament::math::float2 uv;
-};
+// Copies data into a heap block that Filament frees once the upload is done
+template <typename Descriptor, typename T>
+static Descriptor makeDescriptor(const T* data, size_t size) {
+    auto* copy = new uint8_t[size];
+    std::memcpy(copy, data, size);
+    return Descriptor(copy, size, [](void* buffer, size_t, void*) {
+        delete[] static_cast<uint8_t*>(buffer);
+    });
+}
+
+Mesh Mesh::create(filament::Engine& engine, std::vector<MeshVertex> vertices,
+                  std::vector<uint32_t> indices, bool keepCpuData) {
+    const auto vertexCount = static_cast<uint32_t>(vertices.size());
+    const auto indexCount = static_cast<uint32_t>(indices.size());
+
+    auto* vb = filament::VertexBuffer::Builder()
+        .vertexCount(vertexCount)
+        .bufferCount(1)
+        .attribute(filament::VertexAttribute::POSITION,  0, filament::VertexBuffer::AttributeType::FLOAT3, offsetof(MeshVertex, position), sizeof(MeshVertex))
+        .attribute(filament::VertexAttribute::TANGENTS,  0, filament::VertexBuffer::AttributeType::FLOAT3, offsetof(MeshVertex, normal),   sizeof(MeshVertex))
+        .attribute(filament::VertexAttribute::UV0,       0, filament::VertexBuffer::AttributeType::FLOAT2, offsetof(MeshVertex, uv),       sizeof(MeshVertex))
+        .build(engine);
+
+    vb->setBufferAt(engine, 0, makeDescriptor<filament::VertexBuffer::BufferDescriptor>(
+        vertices.data(), vertices.size() * sizeof(MeshVertex)));
+
+    // Small meshes keep 16-bit indices
+    filament::IndexBuffer* ib = nullptr;
+    if (vertexCount <= UINT16_MAX + 1u) {
+        std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+        ib = filament::IndexBuffer::Builder()
+            .indexCount(indexCount)
+            .bufferType(filament::IndexBuffer::IndexType::USHORT)
+            .build(engine);
+        ib->setBuffer(engine, makeDescriptor<filament::IndexBuffer::BufferDescriptor>(
+            shortIndices.data(), shortIndices.size() * sizeof(uint16_t)));
+    } else {
+        ib = filament::IndexBuffer::Builder()
+            .indexCount(indexCount)
+            .bufferType(filament::IndexBuffer::IndexType::UINT)
+            .build(engine);
+        ib->setBuffer(engine, makeDescriptor<filament::IndexBuffer::BufferDescriptor>(
+            indices.data(), indices.size() * sizeof(uint32_t)));
+    }
+
+    Vec3 bMin{0, 0, 0};
+    Vec3 bMax{0, 0, 0};
+    if (!vertices.empty()) {
+        bMin = bMax = vertices[0].position;
+        for (const auto& v : vertices) {
+            bMin = min(bMin, v.position);
+            bMax = max(bMax, v.position);
+        }
+    }
+
+    Mesh mesh;
+    mesh.vertexBuffer = vb;
+    mesh.indexBuffer = ib;
+    mesh.indexCount = indexCount;
+    mesh.boundingBox = filament::Box().set(bMin, bMax);
+    if (keepCpuData) {
+        mesh.vertices = std::move(vertices);
+        mesh.indices = std::move(indices);
+    }
+    return mesh;
+}
 
-Mesh Mesh::createCube(filament::Engine& engine, float h) {
+Mesh Mesh::createCube(filament::Engine& engine, float h, bool keepCpuData) {
     // 24 vertices (4 per face for correct normals)
-    static const Vertex vertices[] = {
+    std::vector<MeshVertex> vertices = {
         // Front face (+Z)
         {{-h, -h,  h}, { 0,  0,  1}, {0, 0}},
         {{ h, -h,  h}, { 0,  0,  1}, {1, 0}},
@@ -54,7 +113,7 @@ Mesh Mesh::createCube(filament::Engine& engine, float h) {
         {{-h,  h, -h}, {-1,  0,  0}, {0, 1}},
     };
 
-    static const uint16_t indices[] = {
+    std::vector<uint32_t> indices = {
          0,  1,  2,   2,  3,  0, // front
          4,  5,  6,   6,  7,  4, // back
          8,  9, 10,  10, 11,  8, // top
@@ -63,78 +122,22 @@ Mesh Mesh::createCube(filament::Engine& engine, float h) {
         20, 21, 22,  22, 23, 20, // left
     };
 
-    constexpr uint32_t vertexCount = 24;
-    constexpr uint32_t indexCount = 36;
-
-    auto* vb = filament::VertexBuffer::Builder()
-        .vertexCount(vertexCount)
-        .bufferCount(1)
-        .attribute(filament::VertexAttribute::POSITION,  0, filament::VertexBuffer::AttributeType::FLOAT3, offsetof(Vertex, position), sizeof(Vertex))
-        .attribute(filament::VertexAttribute::TANGENTS,  0, filament::VertexBuffer::AttributeType::FLOAT3, offsetof(Vertex, normal),   sizeof(Vertex))
-        .attribute(filament::VertexAttribute::UV0,       0, filament::VertexBuffer::AttributeType::FLOAT2, offsetof(Vertex, uv),       sizeof(Vertex))
-        .build(engine);
-
-    vb->setBufferAt(engine, 0,
-        filament::VertexBuffer::BufferDescriptor(vertices, sizeof(vertices), nullptr));
-
-    auto* ib = filament::IndexBuffer::Builder()
-        .indexCount(indexCount)
-        .bufferType(filament::IndexBuffer::IndexType::USHORT)
-        .build(engine);
-
-    ib->setBuffer(engine,
-        filament::IndexBuffer::BufferDescriptor(indices, sizeof(indices), nullptr));
-
-    Mesh mesh;
-    mesh.vertexBuffer = vb;
-    mesh.indexBuffer = ib;
-    mesh.indexCount = indexCount;
-    mesh.boundingBox = {{-h, -h, -h}, {h, h, h}};
-
-    return mesh;
+    return create(engine, std::move(vertices), std::move(indices), keepCpuData);
 }
 
-Mesh Mesh::createPlane(filament::Engine& engine, float h) {
-    static const Vertex vertices[] = {
+Mesh Mesh::createPlane(filament::Engine& engine, float h, bool keepCpuData) {
+    std::vector<MeshVertex> vertices = {
         {{-h, 0, -h}, {0, 1, 0}, {0, 0}},
         {{ h, 0, -h}, {0, 1, 0}, {1, 0}},
         {{ h, 0,  h}, {0, 1, 0}, {1, 1}},
         {{-h, 0,  h}, {0, 1, 0}, {0, 1}},
     };
 
-    static const uint16_t indices[] = {
+    std::vector<uint32_t> indices = {
         0, 1, 2,  2, 3, 0
     };
 
-    constexpr uint32_t vertexCount = 4;
-    constexpr uint32_t indexCount = 6;
-
-    auto* vb = filament::VertexBuffer::Builder()
-        .vertexCount(vertexCount)
-        .bufferCount(1)
-        .attribute(filament::VertexAttribute::POSITION,  0, filament::VertexBuffer::AttributeType::FLOAT3, offsetof(Vertex, position), sizeof(Vertex))
-        .attribute(filament::VertexAttribute::TANGENTS,  0, filament::VertexBuffer::AttributeType::FLOAT3, offsetof(Vertex, normal),   sizeof(Vertex))
-        .attribute(filament::VertexAttribute::UV0,       0, filament::VertexBuffer::AttributeType::FLOAT2, offsetof(Vertex, uv),       sizeof(Vertex))
-        .build(engine);
-
-    vb->setBufferAt(engine, 0,
-        filament::VertexBuffer::BufferDescriptor(vertices, sizeof(vertices), nullptr));
-
-    auto* ib = filament::IndexBuffer::Builder()
-        .indexCount(indexCount)
-        .bufferType(filament::IndexBuffer::IndexType::USHORT)
-        .build(engine);
-
-    ib->setBuffer(engine,
-        filament::IndexBuffer::BufferDescriptor(indices, sizeof(indices), nullptr));
-
-    Mesh mesh;
-    mesh.vertexBuffer = vb;
-    mesh.indexBuffer = ib;
-    mesh.indexCount = indexCount;
-    mesh.boundingBox = {{-h, 0, -h}, {h, 0, h}};
-
-    return mesh;
+    return create(engine, std::move(vertices), std::move(indices), keepCpuData);
 }
 
 } // namespace fe
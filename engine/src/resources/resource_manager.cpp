@@ -12,7 +12,7 @@ namespace fe {
 ResourceManager* ResourceManager::s_instance = nullptr;
 
 ResourceManager::ResourceManager(filament::Engine& engine)
-    : m_engine(engine) {
+    : m_engine(engine), m_instancePool(engine) {
     s_instance = this;
     FE_LOG_INFO("ResourceManager created");
 }
@@ -62,6 +62,9 @@ void ResourceManager::destroyAll() {
     }
     m_meshes.clear();
 
+    // Pooled instances must go before their parent materials
+    m_instancePool.destroyAll();
+
     for (auto& [id, material] : m_materials) {
         if (material.getInstance()) m_engine.destroy(material.getInstance());
         if (material.getMaterial()) m_engine.destroy(material.getMaterial());
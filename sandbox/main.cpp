@@ -69,7 +69,6 @@ public:
         auto& planeTransform = world.getComponent<fe::TransformComponent>(planeEntity);
         planeTransform.position = {0, -0.55f, 0};
         planeTransform.scale = {1.0f, 0.02f, 1.0f};
-        planeTransform.dirty = true;
         auto lightEntity = world.createEntity("Sun");
         auto& light = world.addComponent<fe::LightComponent>(lightEntity);
         light.type = fe::LightComponent::Type::Directional;
@@ -102,7 +101,7 @@ public:
         // Rotate around Y axis
         float halfAngle = m_rotation * 0.5f;
         transform.rotation = fe::Quat{std::cos(halfAngle), 0, std::sin(halfAngle), 0};
-        transform.dirty = true;
+        world.markChanged<fe::TransformComponent>(m_cubeEntity);
     }
 
     void onShutdown() override {
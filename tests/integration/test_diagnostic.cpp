@@ -177,7 +177,6 @@ public:
         auto& planeTransform = world.getComponent<fe::TransformComponent>(planeEntity);
         planeTransform.position = {0, -0.55f, 0};
         planeTransform.scale = {1.0f, 0.02f, 1.0f};
-        planeTransform.dirty = true;
 
         // Light
         auto lightEntity = world.createEntity("Sun");
@@ -100,3 +100,41 @@ TEST(Clock, MultipleTicks_WorkCorrectly) {
         EXPECT_GT(clock.getElapsedTime(), 0.0);
     }
 }
+
+// FixedTimestep
+
+TEST(FixedTimestep, Step_IsInverseRate) {
+    fe::FixedTimestep timestep(50.0f);
+    EXPECT_FLOAT_EQ(timestep.getStep(), 0.02f);
+    EXPECT_FLOAT_EQ(timestep.getRate(), 50.0f);
+}
+
+TEST(FixedTimestep, ShortFrames_AccumulateIntoOneStep) {
+    fe::FixedTimestep timestep(60.0f);
+    EXPECT_EQ(timestep.advance(0.01f), 0u);
+    EXPECT_NEAR(timestep.getAlpha(), 0.6f, 1e-4f);
+    EXPECT_EQ(timestep.advance(0.01f), 1u);
+    EXPECT_NEAR(timestep.getAlpha(), 0.2f, 1e-4f);
+}
+
+TEST(FixedTimestep, LongFrame_RunsSeveralSteps) {
+    fe::FixedTimestep timestep(100.0f);
+    EXPECT_EQ(timestep.advance(0.035f), 3u);
+    EXPECT_NEAR(timestep.getAlpha(), 0.5f, 1e-3f);
+}
+
+TEST(FixedTimestep, FrameMatchingStep_RunsExactlyOneStep) {
+    fe::FixedTimestep timestep(60.0f);
+    for (int i = 0; i < 120; ++i) {
+        EXPECT_EQ(timestep.advance(1.0f / 60.0f), 1u);
+    }
+}
+
+TEST(FixedTimestep, Stall_IsCappedAndDropped) {
+    fe::FixedTimestep timestep(60.0f, 4);
+    EXPECT_EQ(timestep.advance(1.0f), 4u);
+    EXPECT_GE(timestep.getAlpha(), 0.0f);
+    EXPECT_LT(timestep.getAlpha(), 1.0f);
+    // The backlog does not carry over
+    EXPECT_EQ(timestep.advance(0.0f), 0u);
+}
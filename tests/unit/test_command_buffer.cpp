@@ -0,0 +1,124 @@
+// Unit tests for CommandBuffer / CommandQueue (deferred structural ECS changes)
+// NOTE: EnTT headers must be included BEFORE GTest to avoid
+// entt_traits<long long> template instantiation conflict.
+#include <filament_engine/ecs/command_buffer.h>
+#include <filament_engine/ecs/components.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Health {
+    int value = 100;
+};
+
+// Non-trivial payload: exercises payload destruction on clear()
+struct Label {
+    std::string text;
+};
+
+} // namespace
+
+TEST(CommandBuffer, Record_DoesNotTouchRegistry) {
+    entt::registry registry;
+    auto entity = registry.create();
+
+    fe::CommandBuffer buffer;
+    buffer.add<Health>(entity, 5);
+    EXPECT_FALSE(registry.all_of<Health>(entity));
+    EXPECT_EQ(buffer.getCommandCount(), 1u);
+}
+
+TEST(CommandBuffer, Play_AddSetRemoveInOrder) {
+    entt::registry registry;
+    auto entity = registry.create();
+
+    fe::CommandBuffer buffer;
+    buffer.add<Health>(entity, 5);
+    buffer.set(entity, Health{42});
+    buffer.add<Label>(entity, std::string("tmp"));
+    buffer.remove<Label>(entity);
+    buffer.play(registry, {});
+
+    ASSERT_TRUE(registry.all_of<Health>(entity));
+    EXPECT_EQ(registry.get<Health>(entity).value, 42);
+    EXPECT_FALSE(registry.all_of<Label>(entity));
+}
+
+TEST(CommandBuffer, PendingEntities_ResolveToCreated) {
+    entt::registry registry;
+
+    fe::CommandBuffer buffer;
+    auto a = buffer.create("A");
+    auto b = buffer.create("B");
+    buffer.add<Health>(b, 7);
+    buffer.destroy(a);
+    ASSERT_EQ(buffer.getCreates().size(), 2u);
+    EXPECT_EQ(buffer.getCreates()[1], fe::Name("B"));
+
+    // Stand-ins for the entities World::createEntities would make
+    std::vector<entt::entity> created(2);
+    registry.create(created.begin(), created.end());
+    buffer.play(registry, created);
+
+    EXPECT_EQ(registry.get<Health>(created[1]).value, 7);
+
+    std::vector<entt::entity> destroyed;
+    buffer.collectDestroys(created, destroyed);
+    ASSERT_EQ(destroyed.size(), 1u);
+    EXPECT_EQ(destroyed[0], created[0]);
+}
+
+TEST(CommandBuffer, Play_SkipsDestroyedTargets) {
+    entt::registry registry;
+    auto entity = registry.create();
+
+    fe::CommandBuffer buffer;
+    buffer.add<Health>(entity);
+    registry.destroy(entity);
+
+    EXPECT_NO_THROW(buffer.play(registry, {}));
+}
+
+TEST(CommandBuffer, Clear_ResetsAndReusesBlocks) {
+    entt::registry registry;
+    auto entity = registry.create();
+
+    fe::CommandBuffer buffer;
+    for (int frame = 0; frame < 3; ++frame) {
+        for (int i = 0; i < 5000; ++i) {
+            buffer.set(entity, Label{"label " + std::to_string(i)});
+        }
+        buffer.play(registry, {});
+        buffer.clear();
+        EXPECT_TRUE(buffer.empty());
+    }
+    EXPECT_EQ(registry.get<Label>(entity).text, "label 4999");
+}
+
+TEST(CommandQueue, Local_OneBufferPerThread) {
+    fe::CommandQueue queue;
+    auto* mainBuffer = &queue.local();
+    EXPECT_EQ(&queue.local(), mainBuffer);
+
+    fe::CommandBuffer* workerBuffers[2] = {};
+    std::thread t0([&] { workerBuffers[0] = &queue.local(); workerBuffers[0]->create(); });
+    std::thread t1([&] { workerBuffers[1] = &queue.local(); workerBuffers[1]->create(); });
+    t0.join();
+    t1.join();
+
+    EXPECT_NE(workerBuffers[0], mainBuffer);
+    EXPECT_NE(workerBuffers[1], mainBuffer);
+    EXPECT_NE(workerBuffers[0], workerBuffers[1]);
+    EXPECT_FALSE(queue.empty());
+}
+
+TEST(CommandQueue, Local_DistinctQueuesOnSameThread) {
+    fe::CommandQueue first;
+    fe::CommandQueue second;
+    EXPECT_NE(&first.local(), &second.local());
+    EXPECT_NE(&first.local(), &second.local());
+}
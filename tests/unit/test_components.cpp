@@ -14,8 +14,6 @@ TEST(TransformComponent, DefaultValues) {
     EXPECT_FLOAT_EQ(t.scale.x, 1.0f);
     EXPECT_FLOAT_EQ(t.scale.y, 1.0f);
     EXPECT_FLOAT_EQ(t.scale.z, 1.0f);
-    EXPECT_TRUE(t.dirty);
-    EXPECT_TRUE(t.parent == entt::null);
 }
 
 TEST(TransformComponent, IdentityRotation) {
@@ -43,32 +41,34 @@ TEST(TransformComponent, ModifyScale) {
     EXPECT_FLOAT_EQ(t.scale.z, 4.0f);
 }
 
-TEST(TransformComponent, DirtyFlag_InitiallyTrue) {
-    fe::TransformComponent t;
-    EXPECT_TRUE(t.dirty);
-}
-
-TEST(TransformComponent, DirtyFlag_CanBeClearedAndSet) {
-    fe::TransformComponent t;
-    t.dirty = false;
-    EXPECT_FALSE(t.dirty);
-    t.dirty = true;
-    EXPECT_TRUE(t.dirty);
-}
+// HierarchyComponent
 
-TEST(TransformComponent, Parent_DefaultNull) {
-    fe::TransformComponent t;
-    EXPECT_TRUE(t.parent == entt::null);
+TEST(HierarchyComponent, DefaultValues) {
+    fe::HierarchyComponent h;
+    EXPECT_TRUE(h.parent == entt::null);
+    EXPECT_TRUE(h.firstChild == entt::null);
+    EXPECT_TRUE(h.nextSibling == entt::null);
+    EXPECT_TRUE(h.prevSibling == entt::null);
+    EXPECT_EQ(h.depth, 0u);
 }
 
-TEST(TransformComponent, Parent_CanBeAssigned) {
+TEST(HierarchyComponent, Parent_CanBeAssigned) {
     entt::registry reg;
     auto parentEntity = reg.create();
 
-    fe::TransformComponent t;
-    t.parent = parentEntity;
-    EXPECT_TRUE(t.parent != entt::null);
-    EXPECT_TRUE(t.parent == parentEntity);
+    fe::HierarchyComponent h;
+    h.parent = parentEntity;
+    EXPECT_TRUE(h.parent != entt::null);
+    EXPECT_TRUE(h.parent == parentEntity);
+}
+
+// WorldTransformComponent
+
+TEST(WorldTransformComponent, DefaultIdentity) {
+    fe::WorldTransformComponent w;
+    EXPECT_FLOAT_EQ(w.matrix[0][0], 1.0f);
+    EXPECT_FLOAT_EQ(w.matrix[3][3], 1.0f);
+    EXPECT_FLOAT_EQ(w.matrix[3][0], 0.0f);
 }
 
 // TagComponent
@@ -92,7 +92,6 @@ TEST(CameraComponent, DefaultValues) {
     EXPECT_FLOAT_EQ(cam.nearPlane, 0.1f);
     EXPECT_FLOAT_EQ(cam.farPlane, 1000.0f);
     EXPECT_FALSE(cam.isActive);
-    EXPECT_TRUE(cam.dirty);
 }
 
 TEST(CameraComponent, SetActive) {
@@ -0,0 +1,165 @@
+// Unit tests for DynamicBvh (incremental AABB tree) and the ray/sphere/box helpers
+#include <filament_engine/math/dynamic_bvh.h>
+#include <gtest/gtest.h>
+
+#include "test_helpers.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using fe::test::box;
+
+std::vector<uint32_t> queryBox(const fe::DynamicBvh& tree, const fe::Aabb& bounds) {
+    std::vector<uint32_t> result;
+    tree.query(bounds, [&](uint32_t proxy) {
+        result.push_back(tree.getUserData(proxy));
+        return true;
+    });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+// Helpers
+
+TEST(DynamicBvh, RayAabb_HitMissAndInside) {
+    auto b = box({0, 0, -5});
+    EXPECT_FLOAT_EQ(fe::intersectRayAabb({0, 0, 0}, {0, 0, -1}, b, 100.0f), 4.5f);
+    EXPECT_LT(fe::intersectRayAabb({0, 0, 0}, {0, 0, 1}, b, 100.0f), 0.0f);   // pointing away
+    EXPECT_LT(fe::intersectRayAabb({0, 0, 0}, {0, 0, -1}, b, 4.0f), 0.0f);    // too short
+    EXPECT_LT(fe::intersectRayAabb({2, 0, 0}, {0, 0, -1}, b, 100.0f), 0.0f);  // parallel, outside slab
+    EXPECT_FLOAT_EQ(fe::intersectRayAabb({0, 0, -5}, {1, 0, 0}, b, 100.0f), 0.0f);
+}
+
+TEST(DynamicBvh, SphereAndBoxOverlap) {
+    auto b = box({0, 0, 0});
+    EXPECT_TRUE(fe::intersectSphereAabb({1.4f, 0, 0}, 1.0f, b));
+    EXPECT_FALSE(fe::intersectSphereAabb({1.3f, 1.3f, 0}, 1.0f, b)); // nearest corner is ~1.13 away
+    EXPECT_TRUE(fe::intersectAabbs(b, box({0.9f, 0, 0})));
+    EXPECT_FALSE(fe::intersectAabbs(b, box({1.1f, 0, 0})));
+}
+
+// Tree maintenance
+
+TEST(DynamicBvh, Insert_StaysBalanced) {
+    fe::DynamicBvh tree;
+    for (uint32_t i = 0; i < 1024; ++i) {
+        tree.insert(box({static_cast<float>(i) * 2.0f, 0, 0}), i); // sorted input: worst case without rotations
+    }
+    EXPECT_EQ(tree.size(), 1024u);
+    EXPECT_TRUE(tree.validate());
+    EXPECT_LE(tree.getHeight(), 20);
+}
+
+TEST(DynamicBvh, Remove_KeepsTreeValid) {
+    fe::DynamicBvh tree;
+    std::vector<uint32_t> proxies;
+    for (uint32_t i = 0; i < 100; ++i) {
+        proxies.push_back(tree.insert(box({static_cast<float>(i % 10) * 3.0f, static_cast<float>(i / 10) * 3.0f, 0}), i));
+    }
+    for (uint32_t i = 0; i < 100; i += 2) {
+        tree.remove(proxies[i]);
+    }
+    EXPECT_EQ(tree.size(), 50u);
+    EXPECT_TRUE(tree.validate());
+    EXPECT_TRUE(queryBox(tree, box({0, 0, 0}, 0.1f)).empty()); // proxy 0 is gone
+    EXPECT_EQ(queryBox(tree, box({3, 0, 0}, 0.1f)), std::vector<uint32_t>{1});
+
+    // Freed nodes are reused
+    tree.insert(box({100, 0, 0}), 500);
+    EXPECT_EQ(queryBox(tree, box({100, 0, 0}, 0.1f)), std::vector<uint32_t>{500});
+    EXPECT_TRUE(tree.validate());
+}
+
+TEST(DynamicBvh, Move_WithinMarginLeavesTreeAlone) {
+    fe::DynamicBvh tree;
+    tree.setMargin(0.5f);
+    auto proxy = tree.insert(box({0, 0, 0}), 7);
+
+    EXPECT_FALSE(tree.move(proxy, box({0.2f, 0, 0})));
+    EXPECT_TRUE(tree.move(proxy, box({10, 0, 0})));
+    EXPECT_TRUE(tree.validate());
+    EXPECT_TRUE(queryBox(tree, box({0, 0, 0}, 0.1f)).empty());
+    EXPECT_EQ(queryBox(tree, box({10, 0, 0}, 0.1f)), std::vector<uint32_t>{7});
+}
+
+// Queries against brute force
+
+TEST(DynamicBvh, RandomScene_QueriesMatchBruteForce) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.1f, 2.0f);
+
+    fe::DynamicBvh tree;
+    tree.setMargin(0.0f); // fat boxes equal the exact ones, so results compare directly
+    std::vector<fe::Aabb> boxes;
+    std::vector<uint32_t> proxies;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        boxes.push_back(box({position(rng), position(rng), position(rng)}, size(rng)));
+        proxies.push_back(tree.insert(boxes.back(), i));
+    }
+
+    // Churn: move a quarter of the boxes
+    for (uint32_t i = 0; i < 2000; i += 4) {
+        boxes[i].center = {position(rng), position(rng), position(rng)};
+        tree.move(proxies[i], boxes[i]);
+    }
+    ASSERT_TRUE(tree.validate());
+
+    for (int q = 0; q < 50; ++q) {
+        // Box query
+        auto region = box({position(rng), position(rng), position(rng)}, 15.0f);
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < boxes.size(); ++i) {
+            if (fe::intersectAabbs(region, boxes[i])) expected.push_back(i);
+        }
+        EXPECT_EQ(queryBox(tree, region), expected);
+
+        // Sphere query (the tree visits a superset; the caller tests exact shapes)
+        fe::Vec3 center{position(rng), position(rng), position(rng)};
+        std::vector<uint32_t> sphereHits;
+        tree.querySphere(center, 20.0f, [&](uint32_t proxy) {
+            uint32_t i = tree.getUserData(proxy);
+            if (fe::intersectSphereAabb(center, 20.0f, boxes[i])) sphereHits.push_back(i);
+            return true;
+        });
+        std::sort(sphereHits.begin(), sphereHits.end());
+        std::vector<uint32_t> sphereExpected;
+        for (uint32_t i = 0; i < boxes.size(); ++i) {
+            if (fe::intersectSphereAabb(center, 20.0f, boxes[i])) sphereExpected.push_back(i);
+        }
+        EXPECT_EQ(sphereHits, sphereExpected);
+
+        // Closest-hit ray
+        fe::Vec3 origin{position(rng), position(rng), position(rng)};
+        fe::Vec3 direction = normalize(fe::Vec3{position(rng), position(rng), position(rng)});
+        float bestExpected = 1000.0f;
+        for (const auto& b : boxes) {
+            float t = fe::intersectRayAabb(origin, direction, b, bestExpected);
+            if (t >= 0.0f) bestExpected = t;
+        }
+        float best = 1000.0f;
+        tree.raycast(origin, direction, 1000.0f, [&](uint32_t proxy, float maxT) {
+            float t = fe::intersectRayAabb(origin, direction, boxes[tree.getUserData(proxy)], maxT);
+            if (t < 0.0f) return maxT;
+            best = t;
+            return t;
+        });
+        EXPECT_FLOAT_EQ(best, bestExpected);
+    }
+}
+
+TEST(DynamicBvh, Query_StopsWhenCallbackReturnsFalse) {
+    fe::DynamicBvh tree;
+    for (uint32_t i = 0; i < 10; ++i) {
+        tree.insert(box({0, 0, 0}), i);
+    }
+    int visited = 0;
+    tree.query(box({0, 0, 0}), [&](uint32_t) { return ++visited < 3; });
+    EXPECT_EQ(visited, 3);
+}
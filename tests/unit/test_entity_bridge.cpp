@@ -172,3 +172,54 @@ TEST(EntityBridge, MultipleEntities_UnlinkOne_OthersUnaffected) {
     EXPECT_TRUE(bridge.hasFilamentEntity(registry, entity2));
     EXPECT_EQ(bridge.getEnttEntity(filament2), entity2);
 }
+
+// Reverse lookup table
+
+TEST(EntityBridge, LinkCount_TracksLinkAndUnlink) {
+    entt::registry registry;
+    fe::EntityBridge bridge;
+    auto entity1 = registry.create();
+    auto entity2 = registry.create();
+
+    bridge.link(registry, entity1);
+    bridge.link(registry, entity2);
+    EXPECT_EQ(bridge.getLinkCount(), 2u);
+
+    bridge.unlink(registry, entity1);
+    EXPECT_EQ(bridge.getLinkCount(), 1u);
+}
+
+TEST(EntityBridge, GetEnttEntity_StaleGeneration_ReturnsNull) {
+    fe::EntityBridge bridge;
+    entt::registry registry;
+    auto enttEntity = registry.create();
+    auto filamentEntity = bridge.link(registry, enttEntity);
+
+    // Same index, different generation: must not resolve to the linked entity
+    auto stale = utils::Entity::import(static_cast<intptr_t>(filamentEntity.getId() + (1u << 17)));
+    ASSERT_EQ(utils::EntityManager::getIndex(stale), utils::EntityManager::getIndex(filamentEntity));
+    EXPECT_TRUE(bridge.getEnttEntity(stale) == entt::null);
+    EXPECT_EQ(bridge.getEnttEntity(filamentEntity), enttEntity);
+}
+
+TEST(EntityBridge, LinkRange_LinksEveryEntityAcrossPages) {
+    entt::registry registry;
+    fe::EntityBridge bridge;
+
+    // Enough entities to span several pages of the reverse table
+    std::vector<entt::entity> entities(10000);
+    registry.create(entities.begin(), entities.end());
+    std::vector<utils::Entity> filamentEntities(entities.size());
+    bridge.linkRange(registry, entities, filamentEntities);
+
+    EXPECT_EQ(bridge.getLinkCount(), entities.size());
+    for (size_t i = 0; i < entities.size(); ++i) {
+        ASSERT_EQ(bridge.getEnttEntity(filamentEntities[i]), entities[i]);
+        ASSERT_EQ(bridge.getFilamentEntity(registry, entities[i]).getId(), filamentEntities[i].getId());
+    }
+
+    bridge.unlinkRange(registry, entities, filamentEntities);
+    EXPECT_EQ(bridge.getLinkCount(), 0u);
+    EXPECT_TRUE(bridge.getEnttEntity(filamentEntities[0]) == entt::null);
+    EXPECT_FALSE(bridge.hasFilamentEntity(registry, entities[0]));
+}
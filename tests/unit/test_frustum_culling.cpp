@@ -0,0 +1,144 @@
+// Unit tests for frustum extraction, world AABB transforms and the batched SIMD box cull
+#include <filament_engine/math/frustum.h>
+#include <gtest/gtest.h>
+
+#include "test_helpers.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+using fe::test::box;
+
+fe::Frustum makeFrustum(float nearPlane = 0.1f, float farPlane = 100.0f) {
+    return fe::Frustum::fromMatrix(fe::test::forwardViewProjection(nearPlane, farPlane));
+}
+
+} // namespace
+
+// Frustum
+
+TEST(Frustum, FromMatrix_PlanesAreNormalized) {
+    auto frustum = makeFrustum();
+    for (const auto& plane : frustum.planes) {
+        EXPECT_NEAR(length(plane.xyz), 1.0f, 1e-5f);
+    }
+}
+
+TEST(Frustum, Intersects_BoxInFront) {
+    EXPECT_TRUE(makeFrustum().intersects(box({0, 0, -10})));
+}
+
+TEST(Frustum, Intersects_BoxBehindCamera) {
+    EXPECT_FALSE(makeFrustum().intersects(box({0, 0, 10})));
+}
+
+TEST(Frustum, Intersects_BoxBeyondFarPlane) {
+    EXPECT_FALSE(makeFrustum(0.1f, 50.0f).intersects(box({0, 0, -60})));
+}
+
+TEST(Frustum, Intersects_BoxOutsideSidePlane) {
+    // 90 degree FOV: at z = -10 the frustum spans x in [-10, 10]
+    EXPECT_FALSE(makeFrustum().intersects(box({15, 0, -10})));
+    EXPECT_TRUE(makeFrustum().intersects(box({9.8f, 0, -10})));
+}
+
+TEST(Frustum, Intersects_StraddlingBoxIsVisible) {
+    EXPECT_TRUE(makeFrustum().intersects(box({10.4f, 0, -10})));
+}
+
+TEST(Frustum, Intersects_MarginKeepsNearbyBoxes) {
+    auto frustum = makeFrustum();
+    auto nearby = box({0, 0, 1.0f}); // just behind the near plane
+    EXPECT_FALSE(frustum.intersects(nearby));
+    EXPECT_TRUE(frustum.intersects(nearby, 2.0f));
+}
+
+// AABB transform
+
+TEST(Aabb, TransformAabb_Translation) {
+    auto world = fe::transformAabb(fe::Mat4::translation(fe::Vec3{1, 2, 3}), box({0, 0, 0}, 1.0f));
+    EXPECT_FLOAT_EQ(world.center.x, 1.0f);
+    EXPECT_FLOAT_EQ(world.center.y, 2.0f);
+    EXPECT_FLOAT_EQ(world.center.z, 3.0f);
+    EXPECT_FLOAT_EQ(world.halfExtent.x, 1.0f);
+}
+
+TEST(Aabb, TransformAabb_RotationGrowsExtent) {
+    // 45 degrees about Y: a unit cube's XZ extent becomes sqrt(2)
+    auto rotation = fe::Mat4::rotation(0.78539816f, fe::Vec3{0, 1, 0});
+    auto world = fe::transformAabb(rotation, box({0, 0, 0}, 1.0f));
+    EXPECT_NEAR(world.halfExtent.x, std::sqrt(2.0f), 1e-5f);
+    EXPECT_NEAR(world.halfExtent.y, 1.0f, 1e-5f);
+    EXPECT_NEAR(world.halfExtent.z, std::sqrt(2.0f), 1e-5f);
+}
+
+TEST(Aabb, TransformAabb_Scale) {
+    auto world = fe::transformAabb(fe::Mat4::scaling(fe::Vec3{2, 3, -4}), box({1, 1, 1}, 1.0f));
+    EXPECT_FLOAT_EQ(world.center.x, 2.0f);
+    EXPECT_FLOAT_EQ(world.center.z, -4.0f);
+    EXPECT_FLOAT_EQ(world.halfExtent.y, 3.0f);
+    EXPECT_FLOAT_EQ(world.halfExtent.z, 4.0f);
+}
+
+TEST(Aabb, MergeAabb_ContainsBoth) {
+    auto merged = fe::mergeAabb(box({-2, 0, 0}), box({4, 1, 0}));
+    EXPECT_FLOAT_EQ(merged.center.x, 1.0f);
+    EXPECT_FLOAT_EQ(merged.halfExtent.x, 3.5f);
+    EXPECT_FLOAT_EQ(merged.center.y, 0.5f);
+    EXPECT_FLOAT_EQ(merged.halfExtent.y, 1.0f);
+}
+
+// Batched cull
+
+TEST(CullAabbs, MatchesScalarTest) {
+    auto frustum = fe::Frustum::fromMatrix(
+        fe::Mat4::perspective(60.0f, 1.5f, 0.5f, 80.0f) *
+        fe::Mat4::rotation(0.3f, fe::Vec3{0, 1, 0}));
+
+    // Grid sweeping through all planes; odd count so the scalar tail runs too
+    fe::AabbSoA boxes;
+    std::vector<fe::Aabb> reference;
+    for (int x = -12; x <= 12; ++x) {
+        for (int z = -10; z <= 2; ++z) {
+            auto b = fe::Aabb{{x * 4.0f, (x % 3) * 2.0f, z * 9.0f}, {0.5f, 1.0f + (z & 1), 0.25f}};
+            boxes.push(b);
+            reference.push_back(b);
+        }
+    }
+    ASSERT_NE(boxes.size() % 4, 0u);
+
+    for (float margin : {0.0f, 3.0f}) {
+        std::vector<uint8_t> visible(boxes.size());
+        size_t count = fe::cullAabbs(frustum, boxes, margin, visible.data());
+
+        size_t expected = 0;
+        for (size_t i = 0; i < reference.size(); ++i) {
+            bool inside = frustum.intersects(reference[i], margin);
+            EXPECT_EQ(visible[i] != 0, inside) << "box " << i << " margin " << margin;
+            expected += inside;
+        }
+        EXPECT_EQ(count, expected);
+        EXPECT_GT(count, 0u);
+        EXPECT_LT(count, boxes.size());
+    }
+}
+
+TEST(CullAabbs, CountsVisibleAndCulled) {
+    fe::AabbSoA boxes;
+    boxes.push(box({0, 0, -10}));   // visible
+    boxes.push(box({0, 0, 10}));    // behind
+    boxes.push(box({50, 0, -10}));  // right
+    boxes.push(box({0, -3, -20}));  // visible
+    boxes.push(box({0, 0, -200}));  // beyond far
+
+    std::vector<uint8_t> visible(boxes.size());
+    EXPECT_EQ(fe::cullAabbs(makeFrustum(), boxes, 0.0f, visible.data()), 2u);
+    EXPECT_EQ(visible, (std::vector<uint8_t>{1, 0, 0, 1, 0}));
+}
+
+TEST(CullAabbs, EmptyInput) {
+    fe::AabbSoA boxes;
+    EXPECT_EQ(fe::cullAabbs(makeFrustum(), boxes, 0.0f, nullptr), 0u);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// Fixtures shared by the math and culling unit tests
+#include <filament_engine/math/frustum.h>
+
+namespace fe::test {
+
+// Camera at the origin looking down -Z (view = identity), 90 degree vertical FOV
+inline Mat4 forwardViewProjection(float nearPlane = 0.1f, float farPlane = 100.0f) {
+    return Mat4::perspective(90.0f, 1.0f, nearPlane, farPlane);
+}
+
+// Cube of the given half extent around `center`
+inline Aabb box(Vec3 center, float halfExtent = 0.5f) {
+    return {center, {halfExtent, halfExtent, halfExtent}};
+}
+
+} // namespace fe::test
@@ -0,0 +1,191 @@
+// Unit tests for InstanceGrouping (instancing threshold, batch split and batch reuse)
+// NOTE: EnTT headers must be included BEFORE GTest to avoid
+// entt_traits<long long> template instantiation conflict.
+#include <filament_engine/ecs/instance_grouping.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+entt::entity id(uint32_t value) { return static_cast<entt::entity>(value); }
+
+fe::InstanceKey makeKey(uint32_t mesh, uint32_t material = 1) {
+    return {mesh, material, 0, 3};
+}
+
+// Adds renderers the way InstanceBatcher::add does; returns how many ended up instanced
+uint32_t addRenderers(fe::InstanceGrouping& grouping, uint32_t key, uint32_t first, uint32_t count) {
+    uint32_t instanced = 0;
+    for (uint32_t i = first; i < first + count; ++i) {
+        if (!grouping.wantsInstancing(key)) {
+            grouping.addIndividual(key, id(i));
+            continue;
+        }
+        if (!grouping.isInstanced(key)) {
+            for (auto entity : grouping.promote(key)) {
+                grouping.insert(key, entity, fe::Mat4());
+                ++instanced;
+            }
+        }
+        grouping.insert(key, id(i), fe::Mat4());
+        ++instanced;
+    }
+    return instanced;
+}
+
+} // namespace
+
+// Keys
+
+TEST(InstanceGrouping, Keys_SeparateByEveryField) {
+    fe::InstanceGrouping grouping;
+    const uint32_t a = grouping.findOrAddKey({1, 1, 0, 3});
+    EXPECT_EQ(grouping.findOrAddKey({1, 1, 0, 3}), a);
+    EXPECT_NE(grouping.findOrAddKey({2, 1, 0, 3}), a);
+    EXPECT_NE(grouping.findOrAddKey({1, 2, 0, 3}), a);
+    EXPECT_NE(grouping.findOrAddKey({1, 1, 5, 3}), a);
+    EXPECT_NE(grouping.findOrAddKey({1, 1, 0, 1}), a);
+}
+
+// Threshold
+
+TEST(InstanceGrouping, Threshold_PromotesOnTheEighthRenderer) {
+    fe::InstanceGrouping grouping;
+    ASSERT_EQ(grouping.getThreshold(), 8u);
+    const uint32_t key = grouping.findOrAddKey(makeKey(1));
+
+    EXPECT_EQ(addRenderers(grouping, key, 0, 7), 0u);
+    EXPECT_EQ(grouping.getIndividual(key).size(), 7u);
+    EXPECT_FALSE(grouping.isInstanced(key));
+
+    // The eighth renderer brings the seven individual ones along
+    EXPECT_EQ(addRenderers(grouping, key, 7, 1), 8u);
+    EXPECT_TRUE(grouping.isInstanced(key));
+    EXPECT_TRUE(grouping.getIndividual(key).empty());
+    EXPECT_EQ(grouping.getBatchCount(), 1u);
+    EXPECT_EQ(grouping.getInstanceCount(), 8u);
+
+    // From then on every renderer is an instance
+    EXPECT_EQ(addRenderers(grouping, key, 8, 1), 1u);
+}
+
+TEST(InstanceGrouping, Threshold_ZeroDisablesInstancing) {
+    fe::InstanceGrouping grouping;
+    grouping.setThreshold(0);
+    const uint32_t key = grouping.findOrAddKey(makeKey(1));
+    EXPECT_EQ(addRenderers(grouping, key, 0, 20), 0u);
+    EXPECT_EQ(grouping.getBatchCount(), 0u);
+}
+
+TEST(InstanceGrouping, Threshold_CountsPerKey) {
+    fe::InstanceGrouping grouping;
+    grouping.setThreshold(4);
+    const uint32_t a = grouping.findOrAddKey(makeKey(1));
+    const uint32_t b = grouping.findOrAddKey(makeKey(2));
+    addRenderers(grouping, a, 0, 3);
+    addRenderers(grouping, b, 10, 3);
+    EXPECT_FALSE(grouping.isInstanced(a));
+    EXPECT_FALSE(grouping.isInstanced(b));
+}
+
+// Batch split
+
+TEST(InstanceGrouping, Capacity_SplitsIntoFullBatches) {
+    fe::InstanceGrouping grouping;
+    grouping.setThreshold(1);
+    grouping.setBatchCapacity(64);
+    const uint32_t key = grouping.findOrAddKey(makeKey(1));
+
+    addRenderers(grouping, key, 0, 150);
+    const auto& batches = grouping.getKeyBatches(key);
+    ASSERT_EQ(batches.size(), 3u);
+    EXPECT_EQ(grouping.getBatches()[batches[0]].members.size(), 64u);
+    EXPECT_EQ(grouping.getBatches()[batches[1]].members.size(), 64u);
+    EXPECT_EQ(grouping.getBatches()[batches[2]].members.size(), 22u);
+    for (uint32_t index : batches) {
+        const auto& batch = grouping.getBatches()[index];
+        EXPECT_EQ(batch.transforms.size(), batch.members.size());
+        EXPECT_EQ(batch.key, key);
+    }
+}
+
+TEST(InstanceGrouping, Capacity_KeysNeverShareABatch) {
+    fe::InstanceGrouping grouping;
+    grouping.setThreshold(1);
+    const uint32_t a = grouping.findOrAddKey(makeKey(1));
+    const uint32_t b = grouping.findOrAddKey(makeKey(2));
+    addRenderers(grouping, a, 0, 3);
+    addRenderers(grouping, b, 10, 3);
+    ASSERT_EQ(grouping.getKeyBatches(a).size(), 1u);
+    ASSERT_EQ(grouping.getKeyBatches(b).size(), 1u);
+    EXPECT_NE(grouping.getKeyBatches(a)[0], grouping.getKeyBatches(b)[0]);
+}
+
+// Removal
+
+TEST(InstanceGrouping, RemoveInstance_ReportsMovedMember) {
+    fe::InstanceGrouping grouping;
+    grouping.setThreshold(1);
+    const uint32_t key = grouping.findOrAddKey(makeKey(1));
+    addRenderers(grouping, key, 0, 3);
+    const uint32_t batch = grouping.getKeyBatches(key)[0];
+
+    // The last member fills the freed slot
+    EXPECT_EQ(grouping.removeInstance(batch, 0), id(2));
+    EXPECT_EQ(grouping.getBatches()[batch].members[0], id(2));
+    EXPECT_TRUE(grouping.getBatches()[batch].membershipDirty);
+
+    // Removing the last member moves nothing
+    EXPECT_EQ(grouping.removeInstance(batch, 1), entt::entity(entt::null));
+    EXPECT_EQ(grouping.getInstanceCount(), 1u);
+}
+
+TEST(InstanceGrouping, RemoveIndividual_ReportsMovedRenderer) {
+    fe::InstanceGrouping grouping;
+    const uint32_t key = grouping.findOrAddKey(makeKey(1));
+    addRenderers(grouping, key, 0, 3);
+
+    EXPECT_EQ(grouping.removeIndividual(key, 0), id(2));
+    EXPECT_EQ(grouping.removeIndividual(key, 1), entt::entity(entt::null));
+    ASSERT_EQ(grouping.getIndividual(key).size(), 1u);
+    EXPECT_EQ(grouping.getIndividual(key)[0], id(2));
+}
+
+TEST(InstanceGrouping, EmptyBatch_IsReleasedAndReused) {
+    fe::InstanceGrouping grouping;
+    grouping.setThreshold(1);
+    const uint32_t a = grouping.findOrAddKey(makeKey(1));
+    const uint32_t b = grouping.findOrAddKey(makeKey(2));
+    addRenderers(grouping, a, 0, 2);
+    const uint32_t released = grouping.getKeyBatches(a)[0];
+
+    grouping.removeInstance(released, 1);
+    grouping.removeInstance(released, 0);
+    EXPECT_TRUE(grouping.getKeyBatches(a).empty());
+    EXPECT_EQ(grouping.getBatchCount(), 0u);
+
+    // Another key picks up the released batch instead of growing the list
+    addRenderers(grouping, b, 10, 1);
+    ASSERT_EQ(grouping.getKeyBatches(b).size(), 1u);
+    EXPECT_EQ(grouping.getKeyBatches(b)[0], released);
+    EXPECT_EQ(grouping.getBatches().size(), 1u);
+    EXPECT_EQ(grouping.getBatches()[released].key, b);
+}
+
+TEST(InstanceGrouping, Churn_DoesNotGrowBatches) {
+    fe::InstanceGrouping grouping;
+    grouping.setThreshold(1);
+    grouping.setBatchCapacity(16);
+    const uint32_t key = grouping.findOrAddKey(makeKey(1));
+
+    for (int round = 0; round < 10; ++round) {
+        addRenderers(grouping, key, 0, 40);
+        while (!grouping.getKeyBatches(key).empty()) {
+            const uint32_t batch = grouping.getKeyBatches(key).back();
+            grouping.removeInstance(batch, 0);
+        }
+    }
+    EXPECT_EQ(grouping.getBatches().size(), 3u);
+    EXPECT_EQ(grouping.getInstanceCount(), 0u);
+}
@@ -0,0 +1,155 @@
+// Unit tests for LightBudget (importance ranking and shadow-slot assignment)
+// NOTE: EnTT headers must be included BEFORE GTest to avoid
+// entt_traits<long long> template instantiation conflict.
+#include <filament_engine/ecs/light_budget.h>
+#include <gtest/gtest.h>
+
+#include "test_helpers.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+using Type = fe::LightComponent::Type;
+
+fe::LightCandidate pointLight(entt::entity entity, fe::Vec3 position, float intensity = 1000.0f,
+                              float radius = 5.0f, bool castShadows = false) {
+    fe::LightCandidate light;
+    light.entity = entity;
+    light.type = Type::Point;
+    light.position = position;
+    light.intensity = intensity;
+    light.radius = radius;
+    light.castShadows = castShadows;
+    return light;
+}
+
+entt::entity id(uint32_t value) { return static_cast<entt::entity>(value); }
+
+bool contains(const std::vector<entt::entity>& list, entt::entity entity) {
+    return std::find(list.begin(), list.end(), entity) != list.end();
+}
+
+fe::Frustum makeFrustum() {
+    return fe::Frustum::fromMatrix(fe::test::forwardViewProjection());
+}
+
+} // namespace
+
+// Scoring
+
+TEST(LightBudget, Score_CloserLightScoresHigher) {
+    auto nearLight = pointLight(id(1), {0, 0, -10});
+    auto farLight = pointLight(id(2), {0, 0, -40});
+    EXPECT_GT(fe::LightBudget::score(nearLight, {0, 0, 0}, nullptr),
+              fe::LightBudget::score(farLight, {0, 0, 0}, nullptr));
+}
+
+TEST(LightBudget, Score_ViewerInsideRangeSaturates) {
+    auto light = pointLight(id(1), {0, 0, -1}, 500.0f, 5.0f);
+    EXPECT_FLOAT_EQ(fe::LightBudget::score(light, {0, 0, 0}, nullptr), 500.0f);
+}
+
+TEST(LightBudget, Score_RangeOutsideFrustumIsZero) {
+    auto frustum = makeFrustum();
+    auto behind = pointLight(id(1), {0, 0, 20}, 1000.0f, 5.0f);
+    auto reaching = pointLight(id(2), {0, 0, 3}, 1000.0f, 5.0f); // behind, but its range reaches the view
+    EXPECT_FLOAT_EQ(fe::LightBudget::score(behind, {0, 0, 0}, &frustum), 0.0f);
+    EXPECT_GT(fe::LightBudget::score(reaching, {0, 0, 0}, &frustum), 0.0f);
+}
+
+// Selection
+
+TEST(LightBudget, Select_KeepsTopN) {
+    fe::LightBudget budget;
+    budget.setMaxLights(2);
+
+    std::vector<fe::LightCandidate> lights = {
+        pointLight(id(1), {0, 0, -30}),
+        pointLight(id(2), {0, 0, -5}),
+        pointLight(id(3), {0, 0, -60}),
+        pointLight(id(4), {0, 0, -10}),
+    };
+    budget.select(lights, {0, 0, 0}, nullptr);
+
+    EXPECT_EQ(budget.getStats().active, 2u);
+    EXPECT_EQ(budget.getStats().overBudget, 2u);
+    EXPECT_TRUE(contains(budget.getActiveLights(), id(2)));
+    EXPECT_TRUE(contains(budget.getActiveLights(), id(4)));
+    EXPECT_TRUE(lights[1].active);
+    EXPECT_FALSE(lights[2].active);
+}
+
+TEST(LightBudget, Select_DirectionalAlwaysKept) {
+    fe::LightBudget budget;
+    budget.setMaxLights(0);
+
+    fe::LightCandidate sun;
+    sun.entity = id(9);
+    sun.type = Type::Directional;
+    sun.intensity = 100000.0f;
+    sun.castShadows = true;
+    std::vector<fe::LightCandidate> lights = {sun, pointLight(id(1), {0, 0, -5})};
+    budget.select(lights, {0, 0, 0}, nullptr);
+
+    EXPECT_TRUE(lights[0].active);
+    EXPECT_TRUE(lights[0].shadowCaster);
+    EXPECT_FALSE(lights[1].active);
+    EXPECT_EQ(budget.getStats().shadowCasters, 0u); // the sun does not use a slot
+}
+
+TEST(LightBudget, Select_OutOfViewLightsDropped) {
+    fe::LightBudget budget;
+    auto frustum = makeFrustum();
+
+    std::vector<fe::LightCandidate> lights = {
+        pointLight(id(1), {0, 0, -10}),
+        pointLight(id(2), {0, 0, 50}),
+    };
+    budget.select(lights, {0, 0, 0}, &frustum);
+
+    EXPECT_TRUE(lights[0].active);
+    EXPECT_FALSE(lights[1].active);
+    EXPECT_EQ(budget.getStats().outOfView, 1u);
+}
+
+TEST(LightBudget, Select_ShadowSlotsGoToBestCasters) {
+    fe::LightBudget budget;
+    budget.setMaxShadowCasters(1);
+
+    std::vector<fe::LightCandidate> lights = {
+        pointLight(id(1), {0, 0, -20}, 1000.0f, 5.0f, true),
+        pointLight(id(2), {0, 0, -8}, 1000.0f, 5.0f, true),
+        pointLight(id(3), {0, 0, -2}, 1000.0f, 5.0f, false), // brightest, but not a caster
+    };
+    budget.select(lights, {0, 0, 0}, nullptr);
+
+    ASSERT_EQ(budget.getShadowCasters().size(), 1u);
+    EXPECT_EQ(budget.getShadowCasters()[0], id(2));
+    EXPECT_TRUE(lights[1].shadowCaster);
+    EXPECT_FALSE(lights[0].shadowCaster);
+    EXPECT_FALSE(lights[2].shadowCaster);
+}
+
+TEST(LightBudget, Select_HysteresisKeepsCurrentLight) {
+    fe::LightBudget budget;
+    budget.setMaxLights(1);
+    budget.setHysteresis(0.2f);
+
+    // Challenger is ~5% brighter: not enough to take the slot from the active light
+    auto current = pointLight(id(1), {0, 0, -10}, 1000.0f);
+    current.wasActive = true;
+    auto challenger = pointLight(id(2), {0, 0, -10}, 1050.0f);
+
+    std::vector<fe::LightCandidate> lights = {current, challenger};
+    budget.select(lights, {0, 0, 0}, nullptr);
+    EXPECT_TRUE(lights[0].active);
+    EXPECT_FALSE(lights[1].active);
+
+    // Without the bonus the brighter one wins
+    lights[0].wasActive = false;
+    budget.select(lights, {0, 0, 0}, nullptr);
+    EXPECT_FALSE(lights[0].active);
+    EXPECT_TRUE(lights[1].active);
+}
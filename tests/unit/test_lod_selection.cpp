@@ -0,0 +1,62 @@
+// Unit tests for LODSystem level selection (screen size and hysteresis)
+// NOTE: EnTT headers must be included BEFORE GTest to avoid
+// entt_traits<long long> template instantiation conflict.
+#include <filament_engine/ecs/systems/lod_system.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+// Levels at 50%, 20% and 5% of the screen height, plus a last fallback level
+fe::LODGroupComponent makeGroup(float hysteresis = 0.1f) {
+    fe::LODGroupComponent group;
+    group.levels = {
+        {fe::ResourceHandle<fe::Mesh>(1), 0.5f},
+        {fe::ResourceHandle<fe::Mesh>(2), 0.2f},
+        {fe::ResourceHandle<fe::Mesh>(3), 0.05f},
+        {fe::ResourceHandle<fe::Mesh>(4), 0.0f},
+    };
+    group.hysteresis = hysteresis;
+    return group;
+}
+
+} // namespace
+
+TEST(LODSelection, ScreenSize_FallsOffWithDistance) {
+    // 90 degree vertical fov: cot(45) = 1
+    EXPECT_FLOAT_EQ(fe::LODSystem::screenSize(1.0f, 10.0f, 1.0f), 0.1f);
+    EXPECT_FLOAT_EQ(fe::LODSystem::screenSize(1.0f, 20.0f, 1.0f), 0.05f);
+    EXPECT_GT(fe::LODSystem::screenSize(1.0f, 0.5f, 1.0f), 1.0f); // camera inside the sphere
+}
+
+TEST(LODSelection, SelectLevel_PicksByThreshold) {
+    auto group = makeGroup(0.0f);
+    EXPECT_EQ(fe::LODSystem::selectLevel(group, 0.8f, 0), 0u);
+    EXPECT_EQ(fe::LODSystem::selectLevel(group, 0.3f, 0), 1u);
+    EXPECT_EQ(fe::LODSystem::selectLevel(group, 0.1f, 0), 2u);
+    EXPECT_EQ(fe::LODSystem::selectLevel(group, 0.01f, 0), 3u);
+    EXPECT_EQ(fe::LODSystem::selectLevel(group, 0.6f, 3), 0u); // jumps several levels at once
+}
+
+TEST(LODSelection, SelectLevel_HysteresisHoldsNearThreshold) {
+    auto group = makeGroup(0.1f);
+
+    // Just below 0.2: not far enough to drop from level 1 to 2
+    EXPECT_EQ(fe::LODSystem::selectLevel(group, 0.19f, 1), 1u);
+    EXPECT_EQ(fe::LODSystem::selectLevel(group, 0.17f, 1), 2u);
+
+    // Just above 0.2: not far enough to come back from level 2 to 1
+    EXPECT_EQ(fe::LODSystem::selectLevel(group, 0.21f, 2), 2u);
+    EXPECT_EQ(fe::LODSystem::selectLevel(group, 0.23f, 2), 1u);
+}
+
+TEST(LODSelection, SelectLevel_ClampsStaleCurrentLevel) {
+    auto group = makeGroup(0.0f);
+    group.levels.resize(2);
+    EXPECT_EQ(fe::LODSystem::selectLevel(group, 0.01f, 7), 1u);
+    EXPECT_EQ(fe::LODSystem::selectLevel(group, 0.9f, 7), 0u);
+}
+
+TEST(LODSelection, SelectLevel_NoLevels) {
+    fe::LODGroupComponent group;
+    EXPECT_EQ(fe::LODSystem::selectLevel(group, 0.5f, 0), 0u);
+}
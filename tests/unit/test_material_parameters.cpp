@@ -0,0 +1,98 @@
+// Unit tests for MaterialParameters (order-independent parameter sets used as pool keys)
+// and MaterialOverrideComponent's pool-reference ownership
+// NOTE: EnTT headers must be included BEFORE GTest to avoid
+// entt_traits<long long> template instantiation conflict.
+#include <filament_engine/ecs/components.h>
+#include <gtest/gtest.h>
+
+#include <utility>
+
+// Parameter sets
+
+TEST(MaterialParameters, Set_OverwritesExistingName) {
+    fe::MaterialParameters params;
+    params.setRoughness(0.2f).setRoughness(0.7f);
+
+    ASSERT_EQ(params.size(), 1u);
+    const auto* roughness = params.find("roughness");
+    ASSERT_NE(roughness, nullptr);
+    EXPECT_EQ(roughness->size, 1);
+    EXPECT_FLOAT_EQ(roughness->value[0], 0.7f);
+}
+
+TEST(MaterialParameters, Equality_IgnoresInsertionOrder) {
+    fe::MaterialParameters a;
+    a.setBaseColor({1, 0, 0, 1}).setMetallic(0.5f);
+    fe::MaterialParameters b;
+    b.setMetallic(0.5f).setBaseColor({1, 0, 0, 1});
+
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.hash(), b.hash());
+}
+
+TEST(MaterialParameters, Equality_DistinguishesValuesAndTypes) {
+    fe::MaterialParameters a;
+    a.setBaseColor({1, 0, 0, 1});
+    fe::MaterialParameters b;
+    b.setBaseColor({0, 1, 0, 1});
+    fe::MaterialParameters c;
+    c.set("baseColor", fe::Vec3{1, 0, 0});
+
+    EXPECT_NE(a, b);
+    EXPECT_NE(a.hash(), b.hash());
+    EXPECT_NE(a, c);
+}
+
+TEST(MaterialParameters, Remove) {
+    fe::MaterialParameters params;
+    params.setMetallic(1.0f).setReflectance(0.5f);
+
+    EXPECT_TRUE(params.remove("metallic"));
+    EXPECT_FALSE(params.remove("metallic"));
+    EXPECT_EQ(params.find("metallic"), nullptr);
+    EXPECT_NE(params.find("reflectance"), nullptr);
+}
+
+TEST(MaterialParameters, EmptySetsAreEqual) {
+    fe::MaterialParameters a;
+    fe::MaterialParameters b;
+    b.setMetallic(0.0f);
+    b.remove("metallic");
+
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.hash(), b.hash());
+}
+
+// Override component
+
+TEST(MaterialOverrideComponent, CopyDoesNotShareThePoolReference) {
+    fe::MaterialOverrideComponent original(fe::MaterialParameters{}.setRoughness(0.3f));
+    original.instance = 7;
+
+    fe::MaterialOverrideComponent copy = original;
+    EXPECT_EQ(copy.parameters, original.parameters);
+    EXPECT_EQ(copy.instance, 0u);
+    EXPECT_EQ(original.instance, 7u);
+}
+
+TEST(MaterialOverrideComponent, MoveTransfersThePoolReference) {
+    fe::MaterialOverrideComponent original(fe::MaterialParameters{}.setRoughness(0.3f));
+    original.instance = 7;
+
+    fe::MaterialOverrideComponent moved = std::move(original);
+    EXPECT_EQ(moved.instance, 7u);
+    EXPECT_EQ(original.instance, 0u);
+}
+
+TEST(MaterialOverrideComponent, StorageSwapKeepsReferences) {
+    // Removing from the middle of a storage moves the last element into the hole
+    entt::registry registry;
+    auto a = registry.create();
+    auto b = registry.create();
+    registry.emplace<fe::MaterialOverrideComponent>(a).instance = 1;
+    registry.emplace<fe::MaterialOverrideComponent>(b).instance = 2;
+
+    registry.remove<fe::MaterialOverrideComponent>(a);
+    EXPECT_EQ(registry.get<fe::MaterialOverrideComponent>(b).instance, 2u);
+}
@@ -0,0 +1,115 @@
+// Unit tests for interned names (fe::Name) and the TagComponent name index
+// NOTE: EnTT headers must be included BEFORE GTest to avoid
+// entt_traits<long long> template instantiation conflict.
+#include <filament_engine/ecs/name_index.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+// Name
+
+TEST(Name, EmptyByDefault) {
+    fe::Name name;
+    EXPECT_TRUE(name.empty());
+    EXPECT_EQ(name.id(), 0u);
+}
+
+TEST(Name, SameStringSameId) {
+    fe::Name a("Player");
+    fe::Name b(std::string("Player"));
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.id(), b.id());
+    EXPECT_FALSE(a == fe::Name("Enemy"));
+}
+
+TEST(Name, Find_MatchesInternedName) {
+    fe::Name interned("NameThatIsInterned");
+    EXPECT_EQ(fe::Name::find("NameThatIsInterned"), interned);
+}
+
+#if !FE_STRIP_NAMES
+TEST(Name, Find_DoesNotIntern) {
+    const size_t before = fe::NameTable::get().size();
+    EXPECT_TRUE(fe::Name::find("NameThatWasNeverInterned").empty());
+    EXPECT_EQ(fe::NameTable::get().size(), before);
+}
+
+TEST(Name, StrRoundTrips) {
+    fe::Name name("Camera");
+    EXPECT_EQ(name.str(), "Camera");
+}
+#endif
+
+// NameIndex
+
+namespace {
+
+entt::entity createNamed(entt::registry& registry, const char* name) {
+    auto entity = registry.create();
+    registry.emplace<fe::TagComponent>(entity, fe::Name(name));
+    return entity;
+}
+
+} // namespace
+
+TEST(NameIndex, Find_ReturnsNamedEntity) {
+    entt::registry registry;
+    fe::NameIndex index;
+    index.connect(registry);
+
+    createNamed(registry, "A");
+    auto b = createNamed(registry, "B");
+
+    EXPECT_EQ(index.find("B"), b);
+    EXPECT_TRUE(index.find("C") == entt::null);
+}
+
+TEST(NameIndex, FindAll_ReturnsEveryMatch) {
+    entt::registry registry;
+    fe::NameIndex index;
+    index.connect(registry);
+
+    auto e1 = createNamed(registry, "Crate");
+    auto e2 = createNamed(registry, "Crate");
+    createNamed(registry, "Barrel");
+
+    std::vector<entt::entity> found;
+    index.findAll("Crate", found);
+    ASSERT_EQ(found.size(), 2u);
+    EXPECT_NE(std::find(found.begin(), found.end(), e1), found.end());
+    EXPECT_NE(std::find(found.begin(), found.end(), e2), found.end());
+}
+
+TEST(NameIndex, Destroy_RemovesFromIndex) {
+    entt::registry registry;
+    fe::NameIndex index;
+    index.connect(registry);
+
+    auto e1 = createNamed(registry, "Crate");
+    auto e2 = createNamed(registry, "Crate");
+    auto e3 = createNamed(registry, "Crate");
+    registry.destroy(e1);
+
+    EXPECT_EQ(index.count("Crate"), 2u);
+    std::vector<entt::entity> found;
+    index.findAll("Crate", found);
+    EXPECT_EQ(std::find(found.begin(), found.end(), e1), found.end());
+    EXPECT_NE(std::find(found.begin(), found.end(), e2), found.end());
+    EXPECT_NE(std::find(found.begin(), found.end(), e3), found.end());
+
+    registry.destroy(e2);
+    registry.destroy(e3);
+    EXPECT_EQ(index.count("Crate"), 0u);
+}
+
+TEST(NameIndex, Patch_Renames) {
+    entt::registry registry;
+    fe::NameIndex index;
+    index.connect(registry);
+
+    auto entity = createNamed(registry, "Old");
+    registry.patch<fe::TagComponent>(entity, [](auto& tag) { tag.name = "New"; });
+
+    EXPECT_TRUE(index.find("Old") == entt::null);
+    EXPECT_EQ(index.find("New"), entity);
+}
@@ -0,0 +1,127 @@
+// Unit tests for the software occlusion buffer: rasterization, hierarchical Z and box tests
+#include <filament_engine/math/occlusion_buffer.h>
+#include <gtest/gtest.h>
+
+#include "test_helpers.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fe::test::box;
+using fe::test::forwardViewProjection;
+
+// Wall of 2 * halfSize facing the camera at depth z
+struct Quad {
+    std::vector<fe::Vec3> positions;
+    std::vector<uint32_t> indices{0, 1, 2, 0, 2, 3};
+
+    Quad(float z, float halfSize, float offsetX = 0.0f) {
+        positions = {{offsetX - halfSize, -halfSize, z}, {offsetX + halfSize, -halfSize, z},
+                     {offsetX + halfSize, halfSize, z}, {offsetX - halfSize, halfSize, z}};
+    }
+};
+
+fe::OcclusionBuffer makeBuffer(const Quad& occluder, bool rasterize = true) {
+    fe::OcclusionBuffer buffer;
+    buffer.resize(128, 96);
+    buffer.begin(forwardViewProjection());
+    buffer.addOccluder(fe::Mat4(), &occluder.positions[0].x, sizeof(fe::Vec3), occluder.positions.size(),
+                       occluder.indices.data(), occluder.indices.size());
+    if (rasterize) buffer.rasterize();
+    return buffer;
+}
+
+} // namespace
+
+TEST(OcclusionBuffer, Resize_RoundsUpToTiles) {
+    fe::OcclusionBuffer buffer;
+    buffer.resize(100, 50);
+    EXPECT_EQ(buffer.getWidth(), 104u);
+    EXPECT_EQ(buffer.getHeight(), 56u);
+}
+
+TEST(OcclusionBuffer, BoxBehindWall_IsOccluded) {
+    auto buffer = makeBuffer(Quad(-5.0f, 4.0f));
+    EXPECT_TRUE(buffer.isOccluded(box({0, 0, -10})));
+    EXPECT_TRUE(buffer.isOccluded(box({1, -1, -20}, 1.0f)));
+}
+
+TEST(OcclusionBuffer, BoxInFrontOfWall_IsVisible) {
+    auto buffer = makeBuffer(Quad(-5.0f, 4.0f));
+    EXPECT_FALSE(buffer.isOccluded(box({0, 0, -3})));
+}
+
+TEST(OcclusionBuffer, BoxBesideWall_IsVisible) {
+    auto buffer = makeBuffer(Quad(-5.0f, 1.0f, -2.0f));
+    EXPECT_FALSE(buffer.isOccluded(box({2, 0, -10})));
+}
+
+TEST(OcclusionBuffer, BoxPartlyBehindWall_IsVisible) {
+    auto buffer = makeBuffer(Quad(-5.0f, 1.0f));
+    // Wider than the wall's shadow at that depth
+    EXPECT_FALSE(buffer.isOccluded(box({0, 0, -10}, 3.0f)));
+}
+
+TEST(OcclusionBuffer, BoxCrossingCameraPlane_IsVisible) {
+    auto buffer = makeBuffer(Quad(-5.0f, 4.0f));
+    EXPECT_FALSE(buffer.isOccluded(box({0, 0, 0}, 1.0f)));
+}
+
+TEST(OcclusionBuffer, WallCrossingNearPlane_IsClipped) {
+    // Floor-like quad from behind the camera into the distance still hides what is below it
+    Quad floor(0.0f, 1.0f);
+    floor.positions = {{-50, -1, 10}, {50, -1, 10}, {50, -1, -50}, {-50, -1, -50}};
+    auto buffer = makeBuffer(floor);
+    EXPECT_GT(buffer.getTriangleCount(), 0u);
+    EXPECT_TRUE(buffer.isOccluded(box({0, -3, -20})));
+    EXPECT_FALSE(buffer.isOccluded(box({0, 1, -20})));
+}
+
+TEST(OcclusionBuffer, EmptyBuffer_OccludesNothing) {
+    fe::OcclusionBuffer buffer;
+    buffer.resize(64, 64);
+    buffer.begin(forwardViewProjection());
+    buffer.rasterize();
+    EXPECT_FALSE(buffer.isOccluded(box({0, 0, -10})));
+}
+
+TEST(OcclusionBuffer, TileDepth_IsFarthestPixel) {
+    auto buffer = makeBuffer(Quad(-5.0f, 2.0f));
+    const uint32_t tilesX = buffer.getWidth() / fe::OcclusionBuffer::TILE_SIZE;
+    const uint32_t tilesY = buffer.getHeight() / fe::OcclusionBuffer::TILE_SIZE;
+
+    bool anyCovered = false;
+    for (uint32_t ty = 0; ty < tilesY; ++ty) {
+        for (uint32_t tx = 0; tx < tilesX; ++tx) {
+            float farthest = buffer.getDepth(tx * 8, ty * 8);
+            for (uint32_t y = ty * 8; y < ty * 8 + 8; ++y) {
+                for (uint32_t x = tx * 8; x < tx * 8 + 8; ++x) {
+                    farthest = std::min(farthest, buffer.getDepth(x, y));
+                }
+            }
+            EXPECT_EQ(buffer.getTileDepth(tx, ty), farthest);
+            anyCovered |= farthest > 0.0f;
+        }
+    }
+    EXPECT_TRUE(anyCovered);
+    // A wall facing the camera stores 1/w = 1/5 across its inside
+    EXPECT_NEAR(buffer.getDepth(buffer.getWidth() / 2, buffer.getHeight() / 2), 0.2f, 1e-4f);
+}
+
+TEST(OcclusionBuffer, Bands_MatchSerialRasterization) {
+    Quad occluder(-5.0f, 3.0f, 0.5f);
+    auto serial = makeBuffer(occluder);
+    auto banded = makeBuffer(occluder, false);
+
+    // Reverse order, as jobs would finish in any order
+    for (uint32_t band = banded.getBandCount(); band-- > 0;) banded.rasterizeBand(band);
+
+    for (uint32_t y = 0; y < serial.getHeight(); ++y) {
+        for (uint32_t x = 0; x < serial.getWidth(); ++x) {
+            ASSERT_EQ(serial.getDepth(x, y), banded.getDepth(x, y));
+        }
+    }
+}
@@ -0,0 +1,153 @@
+// Unit tests for cell-and-portal visibility: flood fill, portal narrowing and the baked PVS
+#include <filament_engine/ecs/portal_graph.h>
+#include <gtest/gtest.h>
+
+#include "test_helpers.h"
+
+namespace {
+
+using fe::test::box;
+
+// The helper camera, from the origin down -Z or turned around
+fe::Mat4 lookingForward() {
+    return fe::test::forwardViewProjection();
+}
+
+fe::Mat4 lookingBack() {
+    return lookingForward() * fe::Mat4::rotation(3.14159265f, fe::Vec3{0, 1, 0});
+}
+
+// Door in the XY plane at depth z, spanning [x0, x1] x [-1, 1]
+void addDoor(fe::PortalGraph& graph, uint32_t a, uint32_t b, float z, float x0, float x1, bool open = true) {
+    const fe::Vec3 corners[4] = {{x0, -1, z}, {x1, -1, z}, {x1, 1, z}, {x0, 1, z}};
+    graph.addPortal(a, b, corners, open);
+}
+
+// Three rooms in a row down -Z plus a sealed room to the side.
+// The second door sits at [doorX0, doorX1] so tests can line it up with the first one or not.
+void buildRooms(fe::PortalGraph& graph, float doorX0 = 2.0f, float doorX1 = 4.0f, bool firstOpen = true) {
+    graph.clear();
+    const fe::Vec3 half{5, 2, 5};
+    graph.addCell({{0, 0, 0}, half});
+    graph.addCell({{0, 0, -10}, half});
+    graph.addCell({{0, 0, -20}, half});
+    graph.addCell({{10, 0, 0}, half});
+    addDoor(graph, 0, 1, -5.0f, -1.0f, 1.0f, firstOpen);
+    addDoor(graph, 1, 2, -15.0f, doorX0, doorX1);
+}
+
+} // namespace
+
+TEST(PortalGraph, FindCell_ReturnsContainingCell) {
+    fe::PortalGraph graph;
+    buildRooms(graph);
+    EXPECT_EQ(graph.findCell({0, 0, 0}), 0u);
+    EXPECT_EQ(graph.findCell({1, 1, -12}), 1u);
+    EXPECT_EQ(graph.findCell({12, 0, 1}), 3u);
+    EXPECT_EQ(graph.findCell({0, 10, 0}), fe::PortalGraph::NO_CELL);
+}
+
+TEST(PortalGraph, FloodFill_SeesThroughAlignedDoors) {
+    fe::PortalGraph graph;
+    buildRooms(graph);
+    graph.computeVisibility(lookingForward(), 0);
+    EXPECT_TRUE(graph.isCellVisible(0));
+    EXPECT_TRUE(graph.isCellVisible(1));
+    EXPECT_TRUE(graph.isCellVisible(2));
+    EXPECT_FALSE(graph.isCellVisible(3));
+    EXPECT_EQ(graph.getVisibleCellCount(), 3u);
+}
+
+TEST(PortalGraph, FloodFill_StopsAtMisalignedDoor) {
+    fe::PortalGraph graph;
+    // Seen from the origin the second door lies outside the first one's screen rectangle
+    buildRooms(graph, 4.0f, 5.0f);
+    graph.computeVisibility(lookingForward(), 0);
+    EXPECT_TRUE(graph.isCellVisible(1));
+    EXPECT_FALSE(graph.isCellVisible(2));
+}
+
+TEST(PortalGraph, FloodFill_IgnoresDoorsBehindTheCamera) {
+    fe::PortalGraph graph;
+    buildRooms(graph);
+    graph.computeVisibility(lookingBack(), 0);
+    EXPECT_TRUE(graph.isCellVisible(0));
+    EXPECT_FALSE(graph.isCellVisible(1));
+    EXPECT_EQ(graph.getVisibleCellCount(), 1u);
+}
+
+TEST(PortalGraph, FloodFill_ClosedDoorBlocks) {
+    fe::PortalGraph graph;
+    buildRooms(graph, 2.0f, 4.0f, false);
+    graph.computeVisibility(lookingForward(), 0);
+    EXPECT_FALSE(graph.isCellVisible(1));
+    EXPECT_FALSE(graph.isCellVisible(2));
+}
+
+TEST(PortalGraph, CellFrustum_IsNarrowedToTheDoor) {
+    fe::PortalGraph graph;
+    buildRooms(graph);
+    graph.computeVisibility(lookingForward(), 0);
+
+    const fe::Frustum& frustum = graph.getCellFrustum(1);
+    EXPECT_TRUE(frustum.intersects(box({0, 0, -10})));
+    // In the view, but not through the door
+    EXPECT_FALSE(frustum.intersects(box({4, 0, -10})));
+    EXPECT_TRUE(graph.getCellFrustum(0).intersects(box({4, 0, -4})));
+}
+
+TEST(PortalGraph, Pvs_MatchesReachability) {
+    fe::PortalGraph graph;
+    buildRooms(graph);
+    EXPECT_FALSE(graph.hasPvs());
+    graph.bakePvs(2);
+    ASSERT_TRUE(graph.hasPvs());
+
+    EXPECT_TRUE(graph.isPotentiallyVisible(0, 1));
+    EXPECT_TRUE(graph.isPotentiallyVisible(0, 2));
+    EXPECT_TRUE(graph.isPotentiallyVisible(2, 0));
+    EXPECT_FALSE(graph.isPotentiallyVisible(0, 3));
+    EXPECT_FALSE(graph.isPotentiallyVisible(3, 1));
+
+}
+
+TEST(PortalGraph, Pvs_KeepsViewAndNarrowing) {
+    fe::PortalGraph graph;
+    buildRooms(graph);
+    graph.bakePvs(2);
+
+    // The PVS only removes cells: the view direction and portal narrowing still apply
+    graph.computeVisibility(lookingForward(), 0);
+    EXPECT_EQ(graph.getVisibleCellCount(), 3u);
+    EXPECT_FALSE(graph.getCellFrustum(1).intersects(box({4, 0, -10})));
+
+    graph.computeVisibility(lookingBack(), 0);
+    EXPECT_TRUE(graph.isCellVisible(0));
+    EXPECT_FALSE(graph.isCellVisible(2));
+    EXPECT_EQ(graph.getVisibleCellCount(), 1u);
+}
+
+TEST(PortalGraph, Pvs_ClosedDoorStillBlocks) {
+    fe::PortalGraph graph;
+    buildRooms(graph);
+    graph.bakePvs(1);
+
+    buildRooms(graph, 2.0f, 4.0f, false);
+    ASSERT_TRUE(graph.hasPvs());
+    graph.computeVisibility(lookingForward(), 0);
+    EXPECT_FALSE(graph.isCellVisible(1));
+    EXPECT_FALSE(graph.isCellVisible(2));
+}
+
+TEST(PortalGraph, Pvs_SurvivesRebuildOfTheSameLayoutOnly) {
+    fe::PortalGraph graph;
+    buildRooms(graph);
+    graph.bakePvs(1);
+
+    // Toggling a door is not a layout change
+    buildRooms(graph, 2.0f, 4.0f, false);
+    EXPECT_TRUE(graph.hasPvs());
+
+    buildRooms(graph, 1.0f, 4.0f);
+    EXPECT_FALSE(graph.hasPvs());
+}
@@ -0,0 +1,85 @@
+// Unit tests for Prefab (entity templates stamped out by World::instantiate)
+// NOTE: EnTT headers must be included BEFORE GTest to avoid
+// entt_traits<long long> template instantiation conflict.
+#include <filament_engine/ecs/prefab.h>
+#include <filament_engine/ecs/components.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+struct Health {
+    int value = 100;
+};
+
+} // namespace
+
+TEST(Prefab, Root_HasNameAndNoComponents) {
+    fe::Prefab prefab("Crate");
+    EXPECT_EQ(prefab.getNodeCount(), 1u);
+    EXPECT_EQ(prefab.getName(fe::Prefab::ROOT), fe::Name("Crate"));
+    EXPECT_EQ(prefab.get<Health>(), nullptr);
+}
+
+TEST(Prefab, Set_ReplacesValueOfSameType) {
+    fe::Prefab prefab;
+    prefab.set(Health{10});
+    prefab.set(Health{20});
+    ASSERT_NE(prefab.get<Health>(), nullptr);
+    EXPECT_EQ(prefab.get<Health>()->value, 20);
+}
+
+TEST(Prefab, AddChild_RecordsParent) {
+    fe::Prefab prefab("Car");
+    auto body = prefab.addChild(fe::Prefab::ROOT, "Body");
+    auto wheel = prefab.addChild(body, "Wheel");
+
+    EXPECT_EQ(prefab.getNodeCount(), 3u);
+    EXPECT_EQ(prefab.getParent(body), fe::Prefab::ROOT);
+    EXPECT_EQ(prefab.getParent(wheel), body);
+    EXPECT_EQ(prefab.getName(wheel), fe::Name("Wheel"));
+}
+
+TEST(Prefab, ApplyComponents_InsertsForAllEntities) {
+    fe::Prefab prefab;
+    prefab.set(Health{42});
+
+    entt::registry registry;
+    std::vector<entt::entity> entities(100);
+    registry.create(entities.begin(), entities.end());
+    prefab.applyComponents(fe::Prefab::ROOT, registry, entities);
+
+    for (auto entity : entities) {
+        ASSERT_TRUE(registry.all_of<Health>(entity));
+        EXPECT_EQ(registry.get<Health>(entity).value, 42);
+    }
+}
+
+TEST(Prefab, ApplyComponents_ReplacesExistingComponents) {
+    fe::Prefab prefab;
+    fe::TransformComponent transform;
+    transform.position = {1, 2, 3};
+    prefab.set(transform);
+
+    entt::registry registry;
+    std::vector<entt::entity> entities(4);
+    registry.create(entities.begin(), entities.end());
+    registry.insert<fe::TransformComponent>(entities.begin(), entities.end());
+
+    prefab.applyComponents(fe::Prefab::ROOT, registry, entities);
+    for (auto entity : entities) {
+        EXPECT_FLOAT_EQ(registry.get<fe::TransformComponent>(entity).position.y, 2.0f);
+    }
+}
+
+TEST(Prefab, ApplyComponents_OnlyTouchesGivenNode) {
+    fe::Prefab prefab;
+    auto child = prefab.addChild(fe::Prefab::ROOT);
+    prefab.set(child, Health{5});
+
+    entt::registry registry;
+    auto root = registry.create();
+    prefab.applyComponents(fe::Prefab::ROOT, registry, std::span<const entt::entity>(&root, 1));
+    EXPECT_FALSE(registry.all_of<Health>(root));
+}
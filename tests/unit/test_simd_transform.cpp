@@ -0,0 +1,73 @@
+// Unit tests for the batched SIMD TRS composition (every kernel vs. the scalar reference)
+// NOTE: EnTT headers must be included BEFORE GTest to avoid
+// entt_traits<long long> template instantiation conflict.
+#include <filament_engine/ecs/transform_hierarchy.h>
+#include <filament_engine/math/simd_transform.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace {
+
+// Odd count so every kernel also runs its scalar tail
+constexpr size_t kCount = 37;
+
+fe::TransformComponent makeTransform(size_t i) {
+    float f = static_cast<float>(i);
+    fe::TransformComponent transform;
+    transform.position = {f, -2.0f * f, 0.5f * f};
+    transform.rotation = normalize(fe::Quat{std::cos(f), std::sin(f), 0.3f, -0.7f});
+    transform.scale = {1.0f + 0.1f * f, 2.0f, 0.5f};
+    return transform;
+}
+
+fe::TransformSoA makeInput(size_t count) {
+    fe::TransformSoA soa;
+    soa.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto t = makeTransform(i);
+        soa.set(i, t.position, t.rotation, t.scale);
+    }
+    return soa;
+}
+
+void expectMatrixNear(const fe::Mat4& actual, const fe::Mat4& expected) {
+    for (int c = 0; c < 4; ++c) {
+        for (int r = 0; r < 4; ++r) {
+            EXPECT_NEAR(actual[c][r], expected[c][r], 1e-4f) << "column " << c << " row " << r;
+        }
+    }
+}
+
+void checkLevel(fe::SimdLevel level) {
+    if (!fe::isSimdLevelSupported(level)) {
+        GTEST_SKIP() << fe::getSimdLevelName(level) << " not supported on this CPU";
+    }
+
+    auto input = makeInput(kCount);
+    std::vector<fe::Mat4> out(kCount);
+    fe::composeTransforms(input, out.data(), level);
+
+    for (size_t i = 0; i < kCount; ++i) {
+        expectMatrixNear(out[i], fe::TransformHierarchy::composeLocal(makeTransform(i)));
+    }
+}
+
+} // namespace
+
+TEST(SimdTransform, ScalarMatchesComposeLocal) { checkLevel(fe::SimdLevel::Scalar); }
+TEST(SimdTransform, SSE2MatchesComposeLocal)   { checkLevel(fe::SimdLevel::SSE2); }
+TEST(SimdTransform, AVX2MatchesComposeLocal)   { checkLevel(fe::SimdLevel::AVX2); }
+TEST(SimdTransform, NEONMatchesComposeLocal)   { checkLevel(fe::SimdLevel::NEON); }
+
+TEST(SimdTransform, DetectedLevelIsSupported) {
+    EXPECT_TRUE(fe::isSimdLevelSupported(fe::getSimdLevel()));
+    EXPECT_TRUE(fe::isSimdLevelSupported(fe::SimdLevel::Scalar));
+}
+
+TEST(SimdTransform, EmptyInput_WritesNothing) {
+    fe::TransformSoA input;
+    fe::Mat4 sentinel(2.0f);
+    fe::composeTransforms(input, &sentinel);
+    EXPECT_FLOAT_EQ(sentinel[0][0], 2.0f);
+}
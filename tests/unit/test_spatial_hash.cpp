@@ -0,0 +1,134 @@
+// Unit tests for SpatialHash (counting-sort point grid and neighbor queries)
+// NOTE: EnTT headers must be included BEFORE GTest to avoid
+// entt_traits<long long> template instantiation conflict.
+#include <filament_engine/ecs/spatial_hash.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct PointSet {
+    std::vector<entt::entity> entities;
+    std::vector<fe::Vec3> positions;
+
+    void add(fe::Vec3 position) {
+        entities.push_back(static_cast<entt::entity>(entities.size()));
+        positions.push_back(position);
+    }
+};
+
+uint32_t id(entt::entity entity) { return static_cast<uint32_t>(entity); }
+
+} // namespace
+
+TEST(SpatialHash, Build_KeepsEveryPoint) {
+    PointSet points;
+    for (int i = 0; i < 100; ++i) points.add({static_cast<float>(i), 0, 0});
+
+    fe::SpatialHash hash;
+    hash.build(points.entities, points.positions);
+    ASSERT_EQ(hash.size(), 100u);
+
+    std::vector<uint32_t> ids;
+    for (uint32_t i = 0; i < hash.size(); ++i) {
+        ids.push_back(id(hash.getEntity(i)));
+        EXPECT_FLOAT_EQ(hash.getPosition(i).x, static_cast<float>(id(hash.getEntity(i))));
+    }
+    std::sort(ids.begin(), ids.end());
+    for (uint32_t i = 0; i < 100; ++i) EXPECT_EQ(ids[i], i);
+}
+
+TEST(SpatialHash, ForEachInRadius_FindsPointsAcrossCells) {
+    PointSet points;
+    points.add({0.9f, 0, 0});
+    points.add({1.1f, 0, 0});   // neighboring cell
+    points.add({-0.5f, 0, 0});  // negative cell coordinates
+    points.add({5.0f, 0, 0});
+
+    fe::SpatialHash hash;
+    hash.setCellSize(1.0f);
+    hash.build(points.entities, points.positions);
+
+    std::vector<uint32_t> found;
+    hash.forEachInRadius({1.0f, 0, 0}, 1.5f, [&](uint32_t index, float) {
+        found.push_back(id(hash.getEntity(index)));
+    });
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, (std::vector<uint32_t>{0, 1, 2}));
+}
+
+TEST(SpatialHash, ForEachInRadius_RadiusLargerThanCell) {
+    PointSet points;
+    points.add({0, 0, 0});
+    points.add({0, 3.5f, 0});
+
+    fe::SpatialHash hash;
+    hash.setCellSize(1.0f);
+    hash.build(points.entities, points.positions);
+
+    int found = 0;
+    hash.forEachInRadius({0, 0, 0}, 4.0f, [&](uint32_t, float) { ++found; });
+    EXPECT_EQ(found, 2);
+}
+
+TEST(SpatialHash, ForEachNeighbor_MatchesBruteForce) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coordinate(-20.0f, 20.0f);
+
+    PointSet points;
+    for (int i = 0; i < 2000; ++i) points.add({coordinate(rng), coordinate(rng) * 0.1f, coordinate(rng)});
+
+    constexpr float radius = 1.5f;
+    fe::SpatialHash hash;
+    hash.setCellSize(radius);
+    hash.build(points.entities, points.positions);
+
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    hash.forEachNeighbor(radius, [&](uint32_t i, uint32_t j, float distanceSq) {
+        EXPECT_LE(distanceSq, radius * radius);
+        pairs.emplace_back(id(hash.getEntity(i)), id(hash.getEntity(j)));
+    });
+    std::sort(pairs.begin(), pairs.end());
+
+    std::vector<std::pair<uint32_t, uint32_t>> expected;
+    for (uint32_t i = 0; i < points.positions.size(); ++i) {
+        for (uint32_t j = 0; j < points.positions.size(); ++j) {
+            if (i == j) continue;
+            const fe::Vec3 d = points.positions[i] - points.positions[j];
+            if (dot(d, d) <= radius * radius) expected.emplace_back(i, j);
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(pairs, expected); // every ordered pair exactly once
+}
+
+TEST(SpatialHash, Rebuild_ReflectsNewPositions) {
+    PointSet points;
+    points.add({0, 0, 0});
+    points.add({10, 0, 0});
+
+    fe::SpatialHash hash;
+    hash.build(points.entities, points.positions);
+    int neighbors = 0;
+    hash.forEachNeighbor(1.0f, [&](uint32_t, uint32_t, float) { ++neighbors; });
+    EXPECT_EQ(neighbors, 0);
+
+    points.positions[1] = {0.5f, 0, 0};
+    hash.build(points.entities, points.positions);
+    hash.forEachNeighbor(1.0f, [&](uint32_t, uint32_t, float) { ++neighbors; });
+    EXPECT_EQ(neighbors, 2);
+}
+
+TEST(SpatialHash, Empty_QueriesAreNoOps) {
+    fe::SpatialHash hash;
+    hash.build({}, {});
+    EXPECT_EQ(hash.size(), 0u);
+    int calls = 0;
+    hash.forEachInRadius({0, 0, 0}, 10.0f, [&](uint32_t, float) { ++calls; });
+    hash.forEachNeighbor(10.0f, [&](uint32_t, uint32_t, float) { ++calls; });
+    EXPECT_EQ(calls, 0);
+}
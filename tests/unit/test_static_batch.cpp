@@ -0,0 +1,107 @@
+// Unit tests for StaticBatchSystem membership (joining, leaving and handing renderers back)
+// NOTE: EnTT headers must be included BEFORE GTest to avoid
+// entt_traits<long long> template instantiation conflict.
+#include <filament_engine/ecs/systems/static_batch_system.h>
+#include <filament_engine/ecs/change_tracker.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+const fe::StaticBatchSystem::Key KEY{1, 0, 3, {0, 0, 0}};
+
+entt::entity addMember(entt::registry& registry, fe::StaticBatchSystem& batches,
+                       const fe::StaticBatchSystem::Key& key = KEY) {
+    auto entity = registry.create();
+    registry.emplace<fe::MeshRendererComponent>(entity);
+    registry.emplace<fe::StaticComponent>(entity);
+    batches.insert(registry, entity, key);
+    return entity;
+}
+
+std::vector<entt::entity> changedRenderers(const fe::ChangeTracker& tracker, uint64_t since) {
+    std::vector<entt::entity> result;
+    tracker.forEachChanged<fe::MeshRendererComponent>(since, [&](entt::entity entity) {
+        result.push_back(entity);
+    });
+    return result;
+}
+
+} // namespace
+
+TEST(StaticBatch, Insert_ClaimsRenderer) {
+    entt::registry registry;
+    fe::StaticBatchSystem batches;
+    batches.connect(registry);
+
+    auto a = addMember(registry, batches);
+    addMember(registry, batches);
+    addMember(registry, batches, {1, 0, 3, {1, 0, 0}});
+
+    EXPECT_EQ(batches.getBatchCount(), 2u);
+    EXPECT_EQ(batches.getMemberCount(), 3u);
+    EXPECT_TRUE(registry.get<fe::MeshRendererComponent>(a).initialized);
+    EXPECT_EQ(registry.get<fe::StaticComponent>(a).batch, 0u);
+    batches.disconnect(registry);
+}
+
+TEST(StaticBatch, RemoveStatic_HandsRendererBack) {
+    entt::registry registry;
+    fe::ChangeTracker tracker;
+    tracker.track<fe::MeshRendererComponent>(registry);
+    fe::StaticBatchSystem batches;
+    batches.connect(registry);
+
+    auto entity = addMember(registry, batches);
+    uint64_t cursor = tracker.advance();
+
+    registry.remove<fe::StaticComponent>(entity);
+
+    EXPECT_EQ(batches.getMemberCount(), 0u);
+    EXPECT_FALSE(registry.get<fe::MeshRendererComponent>(entity).initialized);
+    auto changed = changedRenderers(tracker, cursor);
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0], entity);
+    batches.disconnect(registry);
+}
+
+TEST(StaticBatch, DestroyMember_LeavesNoChange) {
+    entt::registry registry;
+    fe::ChangeTracker tracker;
+    tracker.track<fe::MeshRendererComponent>(registry);
+    fe::StaticBatchSystem batches;
+    batches.connect(registry);
+
+    auto entity = addMember(registry, batches);
+    uint64_t cursor = tracker.advance();
+
+    registry.destroy(entity);
+
+    EXPECT_EQ(batches.getMemberCount(), 0u);
+    EXPECT_TRUE(changedRenderers(tracker, cursor).empty());
+    batches.disconnect(registry);
+}
+
+TEST(StaticBatch, RemoveMember_FixesUpLastSlot) {
+    entt::registry registry;
+    fe::StaticBatchSystem batches;
+    batches.connect(registry);
+
+    auto a = addMember(registry, batches);
+    auto b = addMember(registry, batches);
+    auto c = addMember(registry, batches);
+
+    registry.remove<fe::MeshRendererComponent>(a);
+
+    EXPECT_EQ(batches.getMemberCount(), 2u);
+    EXPECT_EQ(registry.get<fe::StaticComponent>(a).batch, fe::StaticComponent::NO_BATCH);
+    EXPECT_EQ(registry.get<fe::StaticComponent>(c).batchSlot, 0u);
+    EXPECT_EQ(registry.get<fe::StaticComponent>(b).batchSlot, 1u);
+
+    // The moved member can still leave its batch cleanly
+    registry.remove<fe::StaticComponent>(c);
+    EXPECT_EQ(batches.getMemberCount(), 1u);
+    EXPECT_EQ(registry.get<fe::StaticComponent>(b).batchSlot, 0u);
+    batches.disconnect(registry);
+}
@@ -0,0 +1,214 @@
+// Unit tests for SystemAccess conflict detection and SystemScheduler stage building
+// NOTE: EnTT headers must be included BEFORE GTest to avoid
+// entt_traits<long long> template instantiation conflict.
+#include <filament_engine/ecs/system_scheduler.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+struct Position { float x = 0; };
+struct Velocity { float x = 0; };
+struct Health { int value = 100; };
+
+class TestSystem : public fe::System {
+public:
+    explicit TestSystem(int prio) { priority = prio; }
+    void update(fe::World&, float) override {}
+};
+
+std::vector<std::unique_ptr<fe::System>> makeSystems(size_t count) {
+    std::vector<std::unique_ptr<fe::System>> systems;
+    for (size_t i = 0; i < count; ++i) {
+        systems.push_back(std::make_unique<TestSystem>(static_cast<int>(i)));
+    }
+    return systems;
+}
+
+} // namespace
+
+// SystemAccess
+
+TEST(SystemAccess, Undeclared_ConflictsWithEverything) {
+    fe::SystemAccess a;
+    fe::SystemAccess b;
+    b.read<Position>();
+    EXPECT_TRUE(a.conflictsWith(b));
+    EXPECT_TRUE(b.conflictsWith(a));
+    EXPECT_TRUE(a.isMainThread());
+}
+
+TEST(SystemAccess, ReadRead_NoConflict) {
+    fe::SystemAccess a;
+    fe::SystemAccess b;
+    a.read<Position>();
+    b.read<Position>();
+    EXPECT_FALSE(a.conflictsWith(b));
+}
+
+TEST(SystemAccess, WriteRead_Conflict) {
+    fe::SystemAccess a;
+    fe::SystemAccess b;
+    a.write<Position>();
+    b.read<Position>();
+    EXPECT_TRUE(a.conflictsWith(b));
+    EXPECT_TRUE(b.conflictsWith(a));
+}
+
+TEST(SystemAccess, DisjointWrites_NoConflict) {
+    fe::SystemAccess a;
+    fe::SystemAccess b;
+    a.write<Position>();
+    b.write<Velocity>().read<Health>();
+    EXPECT_FALSE(a.conflictsWith(b));
+}
+
+TEST(SystemAccess, MainThread_IsDeclared) {
+    fe::SystemAccess a;
+    a.mainThread();
+    EXPECT_TRUE(a.isDeclared());
+    EXPECT_TRUE(a.isMainThread());
+}
+
+TEST(SystemAccess, Prepare_CreatesStorages) {
+    entt::registry registry;
+    fe::SystemAccess a;
+    a.read<Position>().write<Velocity>();
+    a.prepare(registry);
+
+    size_t pools = 0;
+    for (auto [id, storage] : registry.storage()) {
+        if (id == entt::type_hash<Position>::value() || id == entt::type_hash<Velocity>::value()) {
+            ++pools;
+        }
+    }
+    EXPECT_EQ(pools, 2u);
+}
+
+// SystemScheduler
+
+TEST(SystemScheduler, NonConflicting_ShareStage) {
+    auto systems = makeSystems(3);
+    systems[0]->access.write<Position>();
+    systems[1]->access.write<Velocity>();
+    systems[2]->access.read<Health>();
+
+    fe::SystemScheduler scheduler;
+    scheduler.build(systems);
+
+    ASSERT_EQ(scheduler.getStages().size(), 1u);
+    EXPECT_EQ(scheduler.getStages()[0].size(), 3u);
+    EXPECT_FALSE(scheduler.isDirty());
+}
+
+TEST(SystemScheduler, Conflicting_KeepPriorityOrder) {
+    auto systems = makeSystems(3);
+    systems[0]->access.write<Position>();
+    systems[1]->access.read<Position>().write<Velocity>();
+    systems[2]->access.read<Velocity>();
+
+    fe::SystemScheduler scheduler;
+    scheduler.build(systems);
+
+    const auto& stages = scheduler.getStages();
+    ASSERT_EQ(stages.size(), 3u);
+    EXPECT_EQ(stages[0][0], systems[0].get());
+    EXPECT_EQ(stages[1][0], systems[1].get());
+    EXPECT_EQ(stages[2][0], systems[2].get());
+}
+
+TEST(SystemScheduler, IndependentSystem_JoinsEarliestStage) {
+    auto systems = makeSystems(3);
+    systems[0]->access.write<Position>();
+    systems[1]->access.read<Position>();
+    systems[2]->access.write<Health>();
+
+    fe::SystemScheduler scheduler;
+    scheduler.build(systems);
+
+    const auto& stages = scheduler.getStages();
+    ASSERT_EQ(stages.size(), 2u);
+    EXPECT_EQ(stages[0].size(), 2u);
+    EXPECT_EQ(stages[0][1], systems[2].get());
+}
+
+TEST(SystemScheduler, UndeclaredSystem_RunsAlone) {
+    auto systems = makeSystems(3);
+    systems[0]->access.write<Position>();
+    // systems[1] declares nothing
+    systems[2]->access.write<Velocity>();
+
+    fe::SystemScheduler scheduler;
+    scheduler.build(systems);
+
+    const auto& stages = scheduler.getStages();
+    ASSERT_EQ(stages.size(), 3u);
+    EXPECT_EQ(stages[1].size(), 1u);
+    EXPECT_EQ(stages[1][0], systems[1].get());
+}
+
+TEST(SystemScheduler, MainThreadSystems_KeepPriorityOrder) {
+    auto systems = makeSystems(3);
+    systems[0]->access.write<Position>();
+    systems[1]->access.read<Position>().mainThread(); // pushed to stage 1 by systems[0]
+    systems[2]->access.read<Health>().mainThread();   // independent, would fit in stage 0
+
+    fe::SystemScheduler scheduler;
+    scheduler.build(systems);
+
+    // systems[2] must not overtake the lower-priority main-thread systems[1]
+    const auto& stages = scheduler.getStages();
+    ASSERT_EQ(stages.size(), 2u);
+    ASSERT_EQ(stages[0].size(), 1u);
+    EXPECT_EQ(stages[0][0], systems[0].get());
+    ASSERT_EQ(stages[1].size(), 2u);
+    EXPECT_EQ(stages[1][0], systems[1].get());
+    EXPECT_EQ(stages[1][1], systems[2].get());
+}
+
+TEST(SystemScheduler, Invalidate_MarksDirty) {
+    auto systems = makeSystems(1);
+    fe::SystemScheduler scheduler;
+    EXPECT_TRUE(scheduler.isDirty());
+    scheduler.build(systems);
+    EXPECT_FALSE(scheduler.isDirty());
+    scheduler.invalidate();
+    EXPECT_TRUE(scheduler.isDirty());
+}
+
+TEST(SystemScheduler, UpdateRate_SplitsFrameAndStepSchedules) {
+    auto systems = makeSystems(3);
+    systems[0]->rate = fe::UpdateRate::Fixed;
+    systems[1]->rate = fe::UpdateRate::Both;
+    // systems[2] stays Variable; none declare access, so each scheduled one runs alone
+
+    fe::SystemScheduler frame;
+    frame.build(systems);
+    ASSERT_EQ(frame.getStages().size(), 2u);
+    EXPECT_EQ(frame.getStages()[0][0], systems[1].get());
+    EXPECT_EQ(frame.getStages()[1][0], systems[2].get());
+
+    fe::SystemScheduler step;
+    step.build(systems, true);
+    ASSERT_EQ(step.getStages().size(), 2u);
+    EXPECT_EQ(step.getStages()[0][0], systems[0].get());
+    EXPECT_EQ(step.getStages()[1][0], systems[1].get());
+}
+
+TEST(SystemScheduler, WorkerOnlyStep_LeavesOutPinnedSystems) {
+    auto systems = makeSystems(3);
+    for (auto& system : systems) system->rate = fe::UpdateRate::Both;
+    systems[0]->access.write<Position>().mainThread();
+    systems[1]->access.write<Velocity>().mainThreadUpdate();
+    systems[2]->access.write<Health>();
+
+    fe::SystemScheduler step;
+    step.build(systems, true, true);
+    ASSERT_EQ(step.getStages().size(), 1u);
+    ASSERT_EQ(step.getStages()[0].size(), 2u);
+    EXPECT_EQ(step.getStages()[0][0], systems[1].get());
+    EXPECT_EQ(step.getStages()[0][1], systems[2].get());
+
+    // Per frame, mainThreadUpdate() pins the system like mainThread()
+    EXPECT_TRUE(systems[1]->access.isMainThread());
+    EXPECT_FALSE(systems[1]->access.isMainThreadStep());
+}
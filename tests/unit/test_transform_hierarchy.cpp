@@ -0,0 +1,241 @@
+// Unit tests for TransformHierarchy (engine-side parent/child links and world matrix cache)
+// NOTE: EnTT headers must be included BEFORE GTest to avoid
+// entt_traits<long long> template instantiation conflict.
+#include <filament_engine/ecs/transform_hierarchy.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace {
+
+entt::entity createNode(entt::registry& registry, const fe::Vec3& position = {0, 0, 0}) {
+    auto entity = registry.create();
+    auto& transform = registry.emplace<fe::TransformComponent>(entity);
+    transform.position = position;
+    registry.emplace<fe::HierarchyComponent>(entity);
+    registry.emplace<fe::WorldTransformComponent>(entity);
+    return entity;
+}
+
+fe::Vec3 worldPosition(const entt::registry& registry, entt::entity entity) {
+    const auto& m = registry.get<fe::WorldTransformComponent>(entity).matrix;
+    return {m[3][0], m[3][1], m[3][2]};
+}
+
+bool contains(const std::vector<entt::entity>& list, entt::entity entity) {
+    return std::find(list.begin(), list.end(), entity) != list.end();
+}
+
+} // namespace
+
+// Links
+
+TEST(TransformHierarchy, SetParent_LinksChild) {
+    entt::registry registry;
+    fe::TransformHierarchy hierarchy;
+    auto parent = createNode(registry);
+    auto child = createNode(registry);
+
+    EXPECT_TRUE(hierarchy.setParent(registry, child, parent));
+    EXPECT_EQ(registry.get<fe::HierarchyComponent>(child).parent, parent);
+    EXPECT_EQ(registry.get<fe::HierarchyComponent>(parent).firstChild, child);
+    EXPECT_EQ(registry.get<fe::HierarchyComponent>(child).depth, 1u);
+}
+
+TEST(TransformHierarchy, SetParent_UpdatesSubtreeDepth) {
+    entt::registry registry;
+    fe::TransformHierarchy hierarchy;
+    auto a = createNode(registry);
+    auto b = createNode(registry);
+    auto c = createNode(registry);
+
+    hierarchy.setParent(registry, c, b);
+    hierarchy.setParent(registry, b, a);
+    EXPECT_EQ(registry.get<fe::HierarchyComponent>(b).depth, 1u);
+    EXPECT_EQ(registry.get<fe::HierarchyComponent>(c).depth, 2u);
+
+    hierarchy.setParent(registry, b, entt::null);
+    EXPECT_EQ(registry.get<fe::HierarchyComponent>(b).depth, 0u);
+    EXPECT_EQ(registry.get<fe::HierarchyComponent>(c).depth, 1u);
+    EXPECT_TRUE(registry.get<fe::HierarchyComponent>(a).firstChild == entt::null);
+}
+
+TEST(TransformHierarchy, SetParent_RejectsCycle) {
+    entt::registry registry;
+    fe::TransformHierarchy hierarchy;
+    auto a = createNode(registry);
+    auto b = createNode(registry);
+
+    hierarchy.setParent(registry, b, a);
+    EXPECT_FALSE(hierarchy.setParent(registry, a, b));
+    EXPECT_FALSE(hierarchy.setParent(registry, a, a));
+    EXPECT_TRUE(registry.get<fe::HierarchyComponent>(a).parent == entt::null);
+}
+
+TEST(TransformHierarchy, ForEachChild_VisitsAllSiblings) {
+    entt::registry registry;
+    fe::TransformHierarchy hierarchy;
+    auto parent = createNode(registry);
+    auto c1 = createNode(registry);
+    auto c2 = createNode(registry);
+    auto c3 = createNode(registry);
+    hierarchy.setParent(registry, c1, parent);
+    hierarchy.setParent(registry, c2, parent);
+    hierarchy.setParent(registry, c3, parent);
+
+    // Unlink the middle sibling
+    hierarchy.setParent(registry, c2, entt::null);
+
+    std::vector<entt::entity> children;
+    fe::TransformHierarchy::forEachChild(registry, parent,
+        [&](entt::entity child) { children.push_back(child); });
+    EXPECT_EQ(children.size(), 2u);
+    EXPECT_TRUE(contains(children, c1));
+    EXPECT_TRUE(contains(children, c3));
+}
+
+// World matrices
+
+TEST(TransformHierarchy, Update_ComposesParentAndChild) {
+    entt::registry registry;
+    fe::TransformHierarchy hierarchy;
+    auto parent = createNode(registry, {1, 0, 0});
+    auto child = createNode(registry, {0, 2, 0});
+    hierarchy.setParent(registry, child, parent);
+
+    std::vector<entt::entity> changed;
+    hierarchy.update(registry, {parent, child}, changed);
+
+    auto p = worldPosition(registry, child);
+    EXPECT_FLOAT_EQ(p.x, 1.0f);
+    EXPECT_FLOAT_EQ(p.y, 2.0f);
+}
+
+TEST(TransformHierarchy, Update_ReparentedChildIsDirtyWithoutBeingListed) {
+    entt::registry registry;
+    fe::TransformHierarchy hierarchy;
+    auto parent = createNode(registry, {1, 0, 0});
+    auto child = createNode(registry, {0, 2, 0});
+
+    std::vector<entt::entity> changed;
+    hierarchy.update(registry, {parent, child}, changed);
+
+    hierarchy.setParent(registry, child, parent);
+    changed.clear();
+    hierarchy.update(registry, {}, changed);
+
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0], child);
+    EXPECT_FLOAT_EQ(worldPosition(registry, child).x, 1.0f);
+}
+
+TEST(TransformHierarchy, Update_MovingRootRecomputesSubtreeOnly) {
+    entt::registry registry;
+    fe::TransformHierarchy hierarchy;
+    auto root = createNode(registry);
+    auto child = createNode(registry, {0, 1, 0});
+    auto grandchild = createNode(registry, {0, 1, 0});
+    auto unrelated = createNode(registry);
+    hierarchy.setParent(registry, child, root);
+    hierarchy.setParent(registry, grandchild, child);
+
+    std::vector<entt::entity> changed;
+    hierarchy.update(registry, {root, child, grandchild, unrelated}, changed);
+    EXPECT_EQ(changed.size(), 4u);
+
+    registry.get<fe::TransformComponent>(root).position = {5, 0, 0};
+
+    changed.clear();
+    hierarchy.update(registry, {root}, changed);
+    EXPECT_EQ(changed.size(), 3u);
+    EXPECT_FALSE(contains(changed, unrelated));
+
+    auto p = worldPosition(registry, grandchild);
+    EXPECT_FLOAT_EQ(p.x, 5.0f);
+    EXPECT_FLOAT_EQ(p.y, 2.0f);
+}
+
+TEST(TransformHierarchy, Update_NothingDirty_NoChanges) {
+    entt::registry registry;
+    fe::TransformHierarchy hierarchy;
+    auto entity = createNode(registry);
+
+    std::vector<entt::entity> changed;
+    hierarchy.update(registry, {entity}, changed);
+    changed.clear();
+    hierarchy.update(registry, {}, changed);
+    EXPECT_TRUE(changed.empty());
+}
+
+TEST(TransformHierarchy, Update_ParentCreatedAfterChild) {
+    entt::registry registry;
+    fe::TransformHierarchy hierarchy;
+    auto child = createNode(registry, {0, 1, 0});
+    auto parent = createNode(registry, {3, 0, 0});
+    hierarchy.setParent(registry, child, parent);
+
+    std::vector<entt::entity> changed;
+    hierarchy.update(registry, {child, parent}, changed);
+
+    auto p = worldPosition(registry, child);
+    EXPECT_FLOAT_EQ(p.x, 3.0f);
+    EXPECT_FLOAT_EQ(p.y, 1.0f);
+}
+
+// Destruction
+
+TEST(TransformHierarchy, OnDestroy_OrphansChildren) {
+    entt::registry registry;
+    fe::TransformHierarchy hierarchy;
+    auto parent = createNode(registry, {4, 0, 0});
+    auto child = createNode(registry, {0, 1, 0});
+    hierarchy.setParent(registry, child, parent);
+
+    std::vector<entt::entity> changed;
+    hierarchy.update(registry, {parent, child}, changed);
+
+    hierarchy.onDestroy(registry, parent);
+    registry.destroy(parent);
+
+    EXPECT_TRUE(registry.get<fe::HierarchyComponent>(child).parent == entt::null);
+    EXPECT_EQ(registry.get<fe::HierarchyComponent>(child).depth, 0u);
+
+    changed.clear();
+    hierarchy.update(registry, {}, changed);
+    auto p = worldPosition(registry, child);
+    EXPECT_FLOAT_EQ(p.x, 0.0f);
+    EXPECT_FLOAT_EQ(p.y, 1.0f);
+}
+
+TEST(TransformHierarchy, Connect_UnlinksOnRegistryDestroy) {
+    entt::registry registry;
+    fe::TransformHierarchy hierarchy;
+    hierarchy.connect(registry);
+    auto parent = createNode(registry);
+    auto first = createNode(registry);
+    auto middle = createNode(registry);
+    auto last = createNode(registry);
+    auto grandchild = createNode(registry);
+    hierarchy.setParent(registry, first, parent);
+    hierarchy.setParent(registry, middle, parent);
+    hierarchy.setParent(registry, last, parent);
+    hierarchy.setParent(registry, grandchild, middle);
+
+    // Straight through the registry, as bulk teardown does
+    registry.destroy(middle);
+
+    std::vector<entt::entity> children;
+    fe::TransformHierarchy::forEachChild(registry, parent, [&](entt::entity child) { children.push_back(child); });
+    EXPECT_EQ(children.size(), 2u);
+    EXPECT_TRUE(contains(children, first));
+    EXPECT_TRUE(contains(children, last));
+    EXPECT_TRUE(registry.get<fe::HierarchyComponent>(grandchild).parent == entt::null);
+    EXPECT_EQ(registry.get<fe::HierarchyComponent>(grandchild).depth, 0u);
+
+    // A whole subtree destroyed as a range leaves no dangling links
+    const entt::entity subtree[] = {parent, first, last};
+    registry.destroy(std::begin(subtree), std::end(subtree));
+    EXPECT_TRUE(registry.get<fe::HierarchyComponent>(grandchild).firstChild == entt::null);
+    std::vector<entt::entity> changed;
+    hierarchy.update(registry, {}, changed);
+}